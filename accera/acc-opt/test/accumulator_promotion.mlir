@@ -0,0 +1,107 @@
+// RUN: acc-opt --verify-each=false --acc-promote-accumulators %s | FileCheck %s
+
+module @test_accumulator_promotion {
+    accv.module "test_accumulator_promotion" {
+
+        // A vectorized K-loop accumulating into a local cache: C[i, 0:16] += broadcast(A[i, k]) * B[k, 0:16], as two 8-wide accumulators
+        // CHECK-LABEL: func @test_promote_vector_accumulators
+        // CHECK: %[[C:[a-zA-Z0-9_]+]] = memref.alloca() : memref<16x16xf32>
+        // CHECK: %[[C0_INIT:[a-zA-Z0-9_]+]] = vector.load %[[C]][%arg2, %{{.*}}] : memref<16x16xf32>, vector<8xf32>
+        // CHECK: %[[C1_INIT:[a-zA-Z0-9_]+]] = vector.load %[[C]][%arg2, %{{.*}}] : memref<16x16xf32>, vector<8xf32>
+        // CHECK: %[[RESULT:[a-zA-Z0-9_]+]]:2 = affine.for %{{.*}} = 0 to 32 iter_args(%[[C0:[a-zA-Z0-9_]+]] = %[[C0_INIT]], %[[C1:[a-zA-Z0-9_]+]] = %[[C1_INIT]]) -> (vector<8xf32>, vector<8xf32>) {
+        // CHECK-NOT: memref<16x16xf32>
+        // CHECK: %[[S0:[a-zA-Z0-9_]+]] = vector.fma %{{.*}}, %{{.*}}, %[[C0]] : vector<8xf32>
+        // CHECK-NOT: memref<16x16xf32>
+        // CHECK: %[[S1:[a-zA-Z0-9_]+]] = vector.fma %{{.*}}, %{{.*}}, %[[C1]] : vector<8xf32>
+        // CHECK-NOT: memref<16x16xf32>
+        // CHECK: affine.yield %[[S0]], %[[S1]] : vector<8xf32>, vector<8xf32>
+        // CHECK: vector.store %[[RESULT]]#0, %[[C]][%arg2, %{{.*}}] : memref<16x16xf32>, vector<8xf32>
+        // CHECK: vector.store %[[RESULT]]#1, %[[C]][%arg2, %{{.*}}] : memref<16x16xf32>, vector<8xf32>
+        builtin.func @test_promote_vector_accumulators(%arg0: memref<16x32xf32>, %arg1: memref<32x16xf32>, %arg2: index) {
+            %c0 = arith.constant 0 : index
+            %c8 = arith.constant 8 : index
+            %C = memref.alloca() : memref<16x16xf32>
+            affine.for %k = 0 to 32 {
+                %a = affine.load %arg0[%arg2, %k] : memref<16x32xf32>
+                %a_vec = vector.broadcast %a : f32 to vector<8xf32>
+                %b0 = vector.load %arg1[%k, %c0] : memref<32x16xf32>, vector<8xf32>
+                %b1 = vector.load %arg1[%k, %c8] : memref<32x16xf32>, vector<8xf32>
+                %c_0 = vector.load %C[%arg2, %c0] : memref<16x16xf32>, vector<8xf32>
+                %c_1 = vector.load %C[%arg2, %c8] : memref<16x16xf32>, vector<8xf32>
+                %s0 = vector.fma %a_vec, %b0, %c_0 : vector<8xf32>
+                %s1 = vector.fma %a_vec, %b1, %c_1 : vector<8xf32>
+                vector.store %s0, %C[%arg2, %c0] : memref<16x16xf32>, vector<8xf32>
+                vector.store %s1, %C[%arg2, %c8] : memref<16x16xf32>, vector<8xf32>
+            }
+            return
+        }
+
+        // A's element is invariant in the inner j-loop, so its load is hoisted and the broadcast can follow it out
+        // CHECK-LABEL: func @test_hoist_invariant_load
+        // CHECK: affine.for %[[K:[a-zA-Z0-9_]+]] = 0 to 32 {
+        // CHECK-NEXT: %[[A:[a-zA-Z0-9_]+]] = affine.load %arg0[%arg2, %[[K]]] : memref<16x32xf32>
+        // CHECK-NEXT: affine.for %{{.*}} = 0 to 2 {
+        // CHECK-NEXT: vector.broadcast %[[A]] : f32 to vector<8xf32>
+        builtin.func @test_hoist_invariant_load(%arg0: memref<16x32xf32>, %arg1: memref<32x16xf32>, %arg2: index) {
+            %C = memref.alloca() : memref<16x16xf32>
+            affine.for %k = 0 to 32 {
+                affine.for %j = 0 to 2 {
+                    %a = affine.load %arg0[%arg2, %k] : memref<16x32xf32>
+                    %a_vec = vector.broadcast %a : f32 to vector<8xf32>
+                    %b = affine.vector_load %arg1[%k, %j * 8] : memref<32x16xf32>, vector<8xf32>
+                    %c = affine.vector_load %C[%arg2, %j * 8] : memref<16x16xf32>, vector<8xf32>
+                    %s = vector.fma %a_vec, %b, %c : vector<8xf32>
+                    affine.vector_store %s, %C[%arg2, %j * 8] : memref<16x16xf32>, vector<8xf32>
+                }
+            }
+            return
+        }
+
+        // The accumulator overlaps another access to the same buffer, so it must stay in memory
+        // CHECK-LABEL: func @test_no_promotion_for_overlapping_access
+        // CHECK: %[[C:[a-zA-Z0-9_]+]] = memref.alloca() : memref<16x16xf32>
+        // CHECK: affine.for %{{.*}} = 0 to 32 {
+        // CHECK: vector.load %[[C]][%arg1, %{{.*}}] : memref<16x16xf32>, vector<8xf32>
+        // CHECK: vector.load %[[C]][%arg1, %{{.*}}] : memref<16x16xf32>, vector<8xf32>
+        // CHECK: vector.store %{{.*}}, %[[C]][%arg1, %{{.*}}] : memref<16x16xf32>, vector<8xf32>
+        builtin.func @test_no_promotion_for_overlapping_access(%arg0: memref<32xf32>, %arg1: index) {
+            %c0 = arith.constant 0 : index
+            %c4 = arith.constant 4 : index
+            %C = memref.alloca() : memref<16x16xf32>
+            affine.for %k = 0 to 32 {
+                %a = affine.load %arg0[%k] : memref<32xf32>
+                %a_vec = vector.broadcast %a : f32 to vector<8xf32>
+                %c = vector.load %C[%arg1, %c0] : memref<16x16xf32>, vector<8xf32>
+                %d = vector.load %C[%arg1, %c4] : memref<16x16xf32>, vector<8xf32>
+                %s = arith.addf %c, %a_vec : vector<8xf32>
+                %t = arith.addf %s, %d : vector<8xf32>
+                vector.store %t, %C[%arg1, %c0] : memref<16x16xf32>, vector<8xf32>
+            }
+            return
+        }
+
+        // The j-loop may not run at all, so A's element can't be loaded before it and the accumulator can't be stored after it
+        // CHECK-LABEL: func @test_no_hoist_for_variable_trip_count
+        // CHECK: affine.for %[[K:[a-zA-Z0-9_]+]] = 0 to 32 {
+        // CHECK-NEXT: affine.for %{{.*}} = 0 to %arg3 {
+        // CHECK-NEXT: %{{.*}} = affine.load %arg0[%arg2, %[[K]]] : memref<16x32xf32>
+        // CHECK: vector.load %{{.*}}[%arg2, %{{.*}}] : memref<16x16xf32>, vector<8xf32>
+        // CHECK: vector.store %{{.*}}, %{{.*}}[%arg2, %{{.*}}] : memref<16x16xf32>, vector<8xf32>
+        // CHECK-NEXT: }
+        builtin.func @test_no_hoist_for_variable_trip_count(%arg0: memref<16x32xf32>, %arg1: memref<32x16xf32>, %arg2: index, %arg3: index) {
+            %c0 = arith.constant 0 : index
+            %C = memref.alloca() : memref<16x16xf32>
+            affine.for %k = 0 to 32 {
+                affine.for %j = 0 to %arg3 {
+                    %a = affine.load %arg0[%arg2, %k] : memref<16x32xf32>
+                    %a_vec = vector.broadcast %a : f32 to vector<8xf32>
+                    %b = vector.load %arg1[%k, %c0] : memref<32x16xf32>, vector<8xf32>
+                    %c = vector.load %C[%arg2, %c0] : memref<16x16xf32>, vector<8xf32>
+                    %s = vector.fma %a_vec, %b, %c : vector<8xf32>
+                    vector.store %s, %C[%arg2, %c0] : memref<16x16xf32>, vector<8xf32>
+                }
+            }
+            return
+        }
+    }
+}
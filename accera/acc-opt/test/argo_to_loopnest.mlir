@@ -0,0 +1,88 @@
+// RUN: acc-opt --verify-each=false --pass-pipeline="accv.module(accv.func(convert-argo-to-loopnest{num-threads=8}))" %s | FileCheck %s
+
+module @test_argo_to_loopnest {
+    accv.module "test_argo_to_loopnest" {
+
+        // A fill large enough to parallelize: the innermost loop is vectorized, the outermost one runs on 8 threads
+        // CHECK-LABEL: accv.func nested @test_fill
+        // CHECK-NOT: argo.fill
+        // CHECK: "accln.nest"
+        // CHECK: %[[ZERO:[a-zA-Z0-9_]+]] = arith.constant 0.000000e+00 : f32
+        // CHECK: "accv.store"(%[[ZERO]], %arg0
+        // CHECK: "accln.schedule"
+        // CHECK-DAG: accxp_parallelizationInfo = #accxp<"parallelizationinfo{0,8}">
+        // CHECK-DAG: accxp_vectorizationInfo = #accxp<"vectorizationinfo{32,16,0}">
+        accv.func nested @test_fill(%arg0: memref<256x256xf32>) attributes {exec_target = 0 : i64} {
+            argo.fill(%arg0) {value = 0.000000e+00 : f32} : memref<256x256xf32>
+            accv.return
+        }
+
+        // A transposing copy too small to parallelize
+        // CHECK-LABEL: accv.func nested @test_copy
+        // CHECK-NOT: argo.copy
+        // CHECK: "accln.nest"
+        // CHECK: %[[VALUE:[a-zA-Z0-9_]+]] = "accv.load"(%arg0
+        // CHECK: "accv.store"(%[[VALUE]], %arg1
+        // CHECK-NOT: parallelizationinfo
+        // CHECK: accxp_vectorizationInfo = #accxp<"vectorizationinfo{32,16,0}">
+        // CHECK-NOT: parallelizationinfo
+        // CHECK: accv.return
+        accv.func nested @test_copy(%arg0: memref<32x64xf32>, %arg1: memref<64x32xf32>) attributes {exec_target = 0 : i64} {
+            argo.copy(%arg0, %arg1) {inputPermutation = affine_map<(d0, d1) -> (d1, d0)>} : memref<32x64xf32>, memref<64x32xf32>
+            accv.return
+        }
+
+        // B += A, elementwise
+        // CHECK-LABEL: accv.func nested @test_acc
+        // CHECK-NOT: argo.acc
+        // CHECK: "accln.nest"
+        // CHECK: %[[A:[a-zA-Z0-9_]+]] = "accv.load"(%arg0
+        // CHECK: %[[B:[a-zA-Z0-9_]+]] = "accv.load"(%arg1
+        // CHECK: %[[SUM:[a-zA-Z0-9_]+]] = "accv.bin_op"(%[[B]], %[[A]]) {predicate = 0 : i64} : (f32, f32) -> f32
+        // CHECK: "accv.store"(%[[SUM]], %arg1
+        // CHECK: accxp_vectorizationInfo = #accxp<"vectorizationinfo{32,16,0}">
+        accv.func nested @test_acc(%arg0: memref<64x64xf32>, %arg1: memref<64x64xf32>) attributes {exec_target = 0 : i64} {
+            argo.acc(%arg0, %arg1) : memref<64x64xf32>, memref<64x64xf32>
+            accv.return
+        }
+
+        // C = A @ B: C is zero-filled, then the GEMM nest caches panels of B and runs the panels of C on 8 threads
+        // CHECK-LABEL: accv.func nested @test_matmul
+        // CHECK-NOT: argo.matmul
+        // CHECK: arith.constant 0.000000e+00 : f32
+        // CHECK: "accln.schedule"
+        // CHECK: %[[A:[a-zA-Z0-9_]+]] = "accv.load"(%arg0
+        // CHECK: %[[B:[a-zA-Z0-9_]+]] = "accv.load"(%arg1
+        // CHECK: %[[C:[a-zA-Z0-9_]+]] = "accv.load"(%arg2
+        // CHECK: %[[PRODUCT:[a-zA-Z0-9_]+]] = "accv.bin_op"(%[[A]], %[[B]]) {predicate = 2 : i64} : (f32, f32) -> f32
+        // CHECK: %[[SUM:[a-zA-Z0-9_]+]] = "accv.bin_op"(%[[C]], %[[PRODUCT]]) {predicate = 0 : i64} : (f32, f32) -> f32
+        // CHECK: "accv.store"(%[[SUM]], %arg2
+        // CHECK: "accxp.begin_create_cache"(%arg1
+        // CHECK: "accln.schedule"
+        // CHECK-DAG: accxp_parallelizationInfo = #accxp<"parallelizationinfo{0,8}">
+        // CHECK-DAG: accxp_vectorizationInfo = #accxp<"vectorizationinfo{32,16,0}">
+        accv.func nested @test_matmul(%arg0: memref<512x512xf32>, %arg1: memref<512x512xf32>, %arg2: memref<512x512xf32>) attributes {exec_target = 0 : i64} {
+            argo.matmul(%arg0, %arg1, %arg2) {acc = false} : memref<512x512xf32>, memref<512x512xf32>, memref<512x512xf32>
+            accv.return
+        }
+
+        // C is a single panel wide, so there is nothing to parallelize over
+        // CHECK-LABEL: accv.func nested @test_matmul_single_panel
+        // CHECK-NOT: argo.matmul
+        // CHECK: "accln.schedule"
+        // CHECK-NOT: parallelizationinfo
+        // CHECK: accv.return
+        accv.func nested @test_matmul_single_panel(%arg0: memref<512x512xf32>, %arg1: memref<512x256xf32>, %arg2: memref<512x256xf32>) attributes {exec_target = 0 : i64} {
+            argo.matmul(%arg0, %arg1, %arg2) : memref<512x512xf32>, memref<512x256xf32>, memref<512x256xf32>
+            accv.return
+        }
+
+        // Mixed element types would need conversions the kernel doesn't make
+        // CHECK-LABEL: accv.func nested @test_matmul_mixed_types
+        // CHECK: argo.matmul
+        accv.func nested @test_matmul_mixed_types(%arg0: memref<64x64xi8>, %arg1: memref<64x64xi8>, %arg2: memref<64x64xi32>) attributes {exec_target = 0 : i64} {
+            argo.matmul(%arg0, %arg1, %arg2) : memref<64x64xi8>, memref<64x64xi8>, memref<64x64xi32>
+            accv.return
+        }
+    }
+}
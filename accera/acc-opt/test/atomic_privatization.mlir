@@ -0,0 +1,54 @@
+// RUN: acc-opt --verify-each=false --acc-privatize-atomics %s | FileCheck %s
+
+module @test_atomic_privatization {
+    accv.module "test_atomic_privatization" {
+
+        // A histogram in the DSL's form: each atomic updates a single-element slice of the shared bins, and every parallel
+        // iteration performs 64 updates of the 16 bins. The updates go to a private copy of the bins, merged once at the end
+        // CHECK-LABEL: func @test_privatize_sliced_histogram
+        // CHECK: affine.parallel (%{{.*}}) = (0) to (8) {
+        // CHECK-NEXT: %[[PRIVATE:[a-zA-Z0-9_]+]] = memref.alloca() : memref<16xi32>
+        // CHECK-NEXT: %[[ZERO:[a-zA-Z0-9_]+]] = arith.constant 0 : i32
+        // CHECK-NEXT: affine.for %[[I:[a-zA-Z0-9_]+]] = 0 to 16 {
+        // CHECK-NEXT: affine.store %[[ZERO]], %[[PRIVATE]][%[[I]]] : memref<16xi32>
+        // CHECK: affine.for %{{.*}} = 0 to 64 {
+        // CHECK-NOT: accv.atomic_rmw
+        // CHECK-NOT: accv.slice
+        // CHECK: %[[CURRENT:[a-zA-Z0-9_]+]] = memref.load %[[PRIVATE]][%[[BIN:[a-zA-Z0-9_]+]]] : memref<16xi32>
+        // CHECK-NEXT: %[[UPDATED:[a-zA-Z0-9_]+]] = "accv.bin_op"(%[[CURRENT]], %{{.*}}) {predicate = 0 : i64} : (i32, i32) -> i32
+        // CHECK-NEXT: memref.store %[[UPDATED]], %[[PRIVATE]][%[[BIN]]] : memref<16xi32>
+        // CHECK: affine.for %[[J:[a-zA-Z0-9_]+]] = 0 to 16 {
+        // CHECK-NEXT: %[[PARTIAL:[a-zA-Z0-9_]+]] = affine.load %[[PRIVATE]][%[[J]]] : memref<16xi32>
+        // CHECK-NEXT: "accv.atomic_rmw"(%[[PARTIAL]], %arg1, %[[J]]) {kind = 0 : i64} : (i32, memref<16xi32>, index) -> i32
+        builtin.func @test_privatize_sliced_histogram(%arg0: memref<8x64xindex>, %arg1: memref<16xi32>) {
+            %c1 = arith.constant 1 : i32
+            affine.parallel (%i) = (0) to (8) {
+                affine.for %j = 0 to 64 {
+                    %bin = affine.load %arg0[%i, %j] : memref<8x64xindex>
+                    %element = "accv.slice"(%arg1, %bin) {sliceDimensions = [0]} : (memref<16xi32>, index) -> memref<i32>
+                    %old = "accv.atomic_rmw"(%c1, %element) {kind = 0 : i64} : (i32, memref<i32>) -> i32
+                }
+            }
+            return
+        }
+
+        // Iterations of the inner parallel loop would race on a private copy owned by the outer iteration, and the inner
+        // parallel loop performs fewer updates than there are bins, so the atomics stay
+        // CHECK-LABEL: func @test_no_privatize_nested_parallel
+        // CHECK-NOT: memref.alloca
+        // CHECK: "accv.atomic_rmw"(%{{.*}}, %arg1, %{{.*}}) {kind = 0 : i64} : (i32, memref<16xi32>, index) -> i32
+        // CHECK-NOT: memref.alloca
+        builtin.func @test_no_privatize_nested_parallel(%arg0: memref<8x64xindex>, %arg1: memref<16xi32>) {
+            %c1 = arith.constant 1 : i32
+            affine.parallel (%i) = (0) to (8) {
+                affine.parallel (%j) = (0) to (4) {
+                    affine.for %k = 0 to 4 {
+                        %bin = affine.load %arg0[%i, %k] : memref<8x64xindex>
+                        %old = "accv.atomic_rmw"(%c1, %arg1, %bin) {kind = 0 : i64} : (i32, memref<16xi32>, index) -> i32
+                    }
+                }
+            }
+            return
+        }
+    }
+}
@@ -0,0 +1,100 @@
+// RUN: acc-opt --verify-each=false --pass-pipeline="accv.module(accv.func(convert-accera-gemm-to-loopnest{num-threads=8}))" %s | FileCheck %s
+
+module @test_gemm_to_loopnest {
+    accv.module "test_gemm_to_loopnest" {
+
+        // Small problems fit in L1: no packing, no cache and no threads, only the vectorized micro-kernel
+        // CHECK-LABEL: accv.func nested @test_gemm_small
+        // CHECK-NOT: accera.GEMM
+        // CHECK: %[[Y:[a-zA-Z0-9_]+]] = "accv.alloc"()
+        // CHECK: "accv.store"(%{{.*}}, %[[Y]]
+        // CHECK: %[[A:[a-zA-Z0-9_]+]] = "accv.load"(%arg0
+        // CHECK: %[[B:[a-zA-Z0-9_]+]] = "accv.load"(%arg1
+        // CHECK: "accv.bin_op"(%[[A]], %[[B]]) {predicate = 2 : i64} : (f32, f32) -> f32
+        // CHECK-NOT: accxp.begin_create_cache
+        // CHECK-NOT: parallelizationinfo
+        // CHECK: vectorizationinfo{32,16,0}
+        // CHECK-NOT: parallelizationinfo
+        // CHECK: memref.copy %[[Y]], %arg2
+        accv.func nested @test_gemm_small(%arg0: memref<32x32xf32>, %arg1: memref<32x32xf32>, %arg2: memref<32x32xf32>) attributes {exec_target = 0 : i64} {
+            %y = "accera.GEMM"(%arg0, %arg1, %arg2) {beta = 0.000000e+00 : f32} : (memref<32x32xf32>, memref<32x32xf32>, memref<32x32xf32>) -> memref<32x32xf32>
+            memref.copy %y, %arg2 : memref<32x32xf32> to memref<32x32xf32>
+            accv.return
+        }
+
+        // Matrix-vector-like products are parallelized over rows of C, without caching B
+        // CHECK-LABEL: accv.func nested @test_gemm_skinny_n
+        // CHECK-NOT: accera.GEMM
+        // CHECK: "accv.bin_op"(%{{.*}}, %{{.*}}) {predicate = 2 : i64} : (f32, f32) -> f32
+        // CHECK-NOT: accxp.begin_create_cache
+        // CHECK: parallelizationinfo{0,8}
+        // CHECK: memref.copy
+        accv.func nested @test_gemm_skinny_n(%arg0: memref<512x512xf32>, %arg1: memref<512x8xf32>, %arg2: memref<512x8xf32>) attributes {exec_target = 0 : i64} {
+            %y = "accera.GEMM"(%arg0, %arg1, %arg2) {beta = 0.000000e+00 : f32} : (memref<512x512xf32>, memref<512x8xf32>, memref<512x8xf32>) -> memref<512x8xf32>
+            memref.copy %y, %arg2 : memref<512x8xf32> to memref<512x8xf32>
+            accv.return
+        }
+
+        // Small-batch products are parallelized over panels of columns of C, without caching B
+        // CHECK-LABEL: accv.func nested @test_gemm_skinny_m
+        // CHECK-NOT: accera.GEMM
+        // CHECK: "accv.bin_op"(%{{.*}}, %{{.*}}) {predicate = 2 : i64} : (f32, f32) -> f32
+        // CHECK-NOT: accxp.begin_create_cache
+        // CHECK: parallelizationinfo{0,8}
+        // CHECK: memref.copy
+        accv.func nested @test_gemm_skinny_m(%arg0: memref<4x1024xf32>, %arg1: memref<1024x1024xf32>, %arg2: memref<4x1024xf32>) attributes {exec_target = 0 : i64} {
+            %y = "accera.GEMM"(%arg0, %arg1, %arg2) {beta = 0.000000e+00 : f32} : (memref<4x1024xf32>, memref<1024x1024xf32>, memref<4x1024xf32>) -> memref<4x1024xf32>
+            memref.copy %y, %arg2 : memref<4x1024xf32> to memref<4x1024xf32>
+            accv.return
+        }
+
+        // Large problems pack panels of B into a cache and are parallelized over them
+        // CHECK-LABEL: accv.func nested @test_gemm_large
+        // CHECK-NOT: accera.GEMM
+        // CHECK: "accv.bin_op"(%{{.*}}, %{{.*}}) {predicate = 2 : i64} : (f32, f32) -> f32
+        // CHECK: "accxp.begin_create_cache"(%arg1
+        // CHECK: parallelizationinfo{0,8}
+        // CHECK: memref.copy
+        accv.func nested @test_gemm_large(%arg0: memref<512x512xf32>, %arg1: memref<512x512xf32>, %arg2: memref<512x512xf32>) attributes {exec_target = 0 : i64} {
+            %y = "accera.GEMM"(%arg0, %arg1, %arg2) {beta = 0.000000e+00 : f32} : (memref<512x512xf32>, memref<512x512xf32>, memref<512x512xf32>) -> memref<512x512xf32>
+            memref.copy %y, %arg2 : memref<512x512xf32> to memref<512x512xf32>
+            accv.return
+        }
+
+        // Y = 2 * A^T @ B^T + 0.5 * C, with a bias row C broadcast to the rows of Y:
+        // beta scales the broadcast fill of Y, A^T is packed, and alpha scales the packing of B^T
+        // CHECK-LABEL: accv.func nested @test_gemm_alpha_beta_transposed
+        // CHECK-NOT: accera.GEMM
+        // CHECK: %[[Y:[a-zA-Z0-9_]+]] = "accv.alloc"()
+        // CHECK: %[[ROW:[a-zA-Z0-9_]+]] = arith.constant 0 : index
+        // CHECK: %[[BIAS:[a-zA-Z0-9_]+]] = "accv.load"(%arg2, %[[ROW]], %{{.*}})
+        // CHECK: %[[BETA:[a-zA-Z0-9_]+]] = arith.constant 5.000000e-01 : f32
+        // CHECK: %[[SCALED_BIAS:[a-zA-Z0-9_]+]] = "accv.bin_op"(%[[BETA]], %[[BIAS]]) {predicate = 2 : i64} : (f32, f32) -> f32
+        // CHECK: "accv.store"(%[[SCALED_BIAS]], %[[Y]]
+        // CHECK: %[[PACKED_A:[a-zA-Z0-9_]+]] = "accv.alloc"() : () -> memref<128x64xf32>
+        // CHECK: %[[A:[a-zA-Z0-9_]+]] = "accv.load"(%arg0
+        // CHECK: "accv.store"(%[[A]], %[[PACKED_A]]
+        // CHECK: %[[PACKED_B:[a-zA-Z0-9_]+]] = "accv.alloc"() : () -> memref<64x256xf32>
+        // CHECK: %[[B:[a-zA-Z0-9_]+]] = "accv.load"(%arg1
+        // CHECK: %[[ALPHA:[a-zA-Z0-9_]+]] = arith.constant 2.000000e+00 : f32
+        // CHECK: %[[SCALED_B:[a-zA-Z0-9_]+]] = "accv.bin_op"(%[[ALPHA]], %[[B]]) {predicate = 2 : i64} : (f32, f32) -> f32
+        // CHECK: "accv.store"(%[[SCALED_B]], %[[PACKED_B]]
+        // CHECK: "accv.load"(%[[PACKED_A]]
+        // CHECK: "accv.load"(%[[PACKED_B]]
+        // CHECK: memref.copy %[[Y]], %arg3
+        accv.func nested @test_gemm_alpha_beta_transposed(%arg0: memref<64x128xf32>, %arg1: memref<256x64xf32>, %arg2: memref<1x256xf32>, %arg3: memref<128x256xf32>) attributes {exec_target = 0 : i64} {
+            %y = "accera.GEMM"(%arg0, %arg1, %arg2) {alpha = 2.000000e+00 : f32, beta = 5.000000e-01 : f32, transA = 1 : i64, transB = 1 : i64} : (memref<64x128xf32>, memref<256x64xf32>, memref<1x256xf32>) -> memref<128x256xf32>
+            memref.copy %y, %arg3 : memref<128x256xf32> to memref<128x256xf32>
+            accv.return
+        }
+
+        // C can't be broadcast to the shape of Y, so the GEMM is left for other lowerings to reject
+        // CHECK-LABEL: accv.func nested @test_gemm_mismatched_c
+        // CHECK: "accera.GEMM"
+        accv.func nested @test_gemm_mismatched_c(%arg0: memref<32x32xf32>, %arg1: memref<32x32xf32>, %arg2: memref<2x32xf32>, %arg3: memref<32x32xf32>) attributes {exec_target = 0 : i64} {
+            %y = "accera.GEMM"(%arg0, %arg1, %arg2) : (memref<32x32xf32>, memref<32x32xf32>, memref<2x32xf32>) -> memref<32x32xf32>
+            memref.copy %y, %arg3 : memref<32x32xf32> to memref<32x32xf32>
+            accv.return
+        }
+    }
+}
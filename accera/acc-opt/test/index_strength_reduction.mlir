@@ -0,0 +1,88 @@
+// RUN: acc-opt --verify-each=false --acc-index-strength-reduce %s | FileCheck %s
+
+module @test_index_strength_reduction {
+    accv.module "test_index_strength_reduction" {
+
+        // A 2-wide unrolled microkernel over flattened caches: C[j] += A[i * 64 + k * 4 + j] * B[k * 4 + j]
+        // Before: 2 multiplies and 3 adds per iteration for 2 FMAs
+        // After: 2 offset adds and 2 loop-carried increments per iteration for 2 FMAs
+
+        // CHECK-LABEL: func @test_unrolled_microkernel
+        // CHECK: arith.muli %arg3, %{{.*}} : index
+        // CHECK: scf.for %{{.*}} = %{{.*}} to %{{.*}} step %{{.*}} iter_args(%[[A_IDX:[a-zA-Z0-9_]+]] = %{{.*}}, %[[B_IDX:[a-zA-Z0-9_]+]] = %{{.*}}) -> (index, index) {
+        // CHECK-NOT: arith.muli
+        // CHECK: %[[A_IDX1:[a-zA-Z0-9_]+]] = arith.addi %[[A_IDX]], %{{.*}} : index
+        // CHECK-NOT: arith.muli
+        // CHECK: %[[B_IDX1:[a-zA-Z0-9_]+]] = arith.addi %[[B_IDX]], %{{.*}} : index
+        // CHECK-NOT: arith.muli
+        // CHECK: memref.load %arg0[%[[A_IDX]]] : memref<1024xf32>
+        // CHECK: memref.load %arg0[%[[A_IDX1]]] : memref<1024xf32>
+        // CHECK: memref.load %arg1[%[[B_IDX]]] : memref<64xf32>
+        // CHECK: memref.load %arg1[%[[B_IDX1]]] : memref<64xf32>
+        // CHECK-NOT: arith.muli
+        // CHECK: %[[A_NEXT:[a-zA-Z0-9_]+]] = arith.addi %[[A_IDX]], %{{.*}} : index
+        // CHECK: %[[B_NEXT:[a-zA-Z0-9_]+]] = arith.addi %[[B_IDX]], %{{.*}} : index
+        // CHECK: scf.yield %[[A_NEXT]], %[[B_NEXT]] : index, index
+        builtin.func @test_unrolled_microkernel(%arg0: memref<1024xf32>, %arg1: memref<64xf32>, %arg2: memref<2xf32>, %arg3: index) {
+            %c0 = arith.constant 0 : index
+            %c1 = arith.constant 1 : index
+            %c4 = arith.constant 4 : index
+            %c16 = arith.constant 16 : index
+            %c64 = arith.constant 64 : index
+            scf.for %k = %c0 to %c16 step %c1 {
+                %0 = arith.muli %arg3, %c64 : index
+                %1 = arith.muli %k, %c4 : index
+                %2 = arith.addi %0, %1 : index
+                %3 = arith.addi %2, %c1 : index
+                %4 = arith.addi %1, %c1 : index
+                %a0 = memref.load %arg0[%2] : memref<1024xf32>
+                %a1 = memref.load %arg0[%3] : memref<1024xf32>
+                %b0 = memref.load %arg1[%1] : memref<64xf32>
+                %b1 = memref.load %arg1[%4] : memref<64xf32>
+                %c_0 = memref.load %arg2[%c0] : memref<2xf32>
+                %c_1 = memref.load %arg2[%c1] : memref<2xf32>
+                %p0 = arith.mulf %a0, %b0 : f32
+                %p1 = arith.mulf %a1, %b1 : f32
+                %s0 = arith.addf %c_0, %p0 : f32
+                %s1 = arith.addf %c_1, %p1 : f32
+                memref.store %s0, %arg2[%c0] : memref<2xf32>
+                memref.store %s1, %arg2[%c1] : memref<2xf32>
+            }
+            return
+        }
+
+        // An index that is only the induction variable plus a constant is already as cheap as an increment
+        // CHECK-LABEL: func @test_no_reduction_for_cheap_index
+        // CHECK: scf.for %[[IV:[a-zA-Z0-9_]+]] = %{{.*}} to %{{.*}} step %{{.*}} {
+        // CHECK-NEXT: %[[IDX:[a-zA-Z0-9_]+]] = arith.addi %[[IV]], %{{.*}} : index
+        // CHECK-NEXT: memref.load %arg0[%[[IDX]]] : memref<32xf32>
+        builtin.func @test_no_reduction_for_cheap_index(%arg0: memref<32xf32>, %arg1: memref<16xf32>) {
+            %c0 = arith.constant 0 : index
+            %c1 = arith.constant 1 : index
+            %c16 = arith.constant 16 : index
+            scf.for %i = %c0 to %c16 step %c1 {
+                %0 = arith.addi %i, %c16 : index
+                %1 = memref.load %arg0[%0] : memref<32xf32>
+                memref.store %1, %arg1[%i] : memref<16xf32>
+            }
+            return
+        }
+
+        // Products of the induction variable with itself aren't linear, so they are left alone
+        // CHECK-LABEL: func @test_no_reduction_for_nonlinear_index
+        // CHECK: scf.for %[[IV:[a-zA-Z0-9_]+]] = %{{.*}} to %{{.*}} step %{{.*}} {
+        // CHECK-NEXT: %[[IDX:[a-zA-Z0-9_]+]] = arith.muli %[[IV]], %[[IV]] : index
+        // CHECK-NEXT: memref.load %arg0[%[[IDX]]] : memref<256xf32>
+        builtin.func @test_no_reduction_for_nonlinear_index(%arg0: memref<256xf32>, %arg1: memref<16xf32>) {
+            %c0 = arith.constant 0 : index
+            %c1 = arith.constant 1 : index
+            %c16 = arith.constant 16 : index
+            scf.for %i = %c0 to %c16 step %c1 {
+                %0 = arith.muli %i, %i : index
+                %1 = memref.load %arg0[%0] : memref<256xf32>
+                memref.store %1, %arg1[%i] : memref<16xf32>
+            }
+            return
+        }
+    }
+}
@@ -0,0 +1,63 @@
+// RUN: acc-opt --verify-each=false --optimize-range-value %s | FileCheck %s
+
+module @test_range_value_constraints {
+
+    // N is declared as a multiple of 16, so the boundary tile left by splitting N by 16 is empty
+    // and the guard around it folds away
+    // CHECK-LABEL: func @test_boundary_tile_removed
+    // CHECK-NOT: arith.remsi
+    // CHECK-NOT: scf.if
+    // CHECK: return
+    builtin.func @test_boundary_tile_removed(%arg0: index, %arg1: memref<?xf32>) attributes {accv.arg_constraints = [{min = 16 : i64, max = 4096 : i64, multiple_of = 16 : i64}, {}]} {
+        %c0 = arith.constant 0 : index
+        %c16 = arith.constant 16 : index
+        %cst = arith.constant 0.000000e+00 : f32
+        %0 = arith.remsi %arg0, %c16 : index
+        %1 = arith.cmpi ne, %0, %c0 : index
+        scf.if %1 {
+            %2 = arith.subi %arg0, %0 : index
+            memref.store %cst, %arg1[%2] : memref<?xf32>
+        }
+        return
+    }
+
+    // N is at most 4096, so the bounds check on the loop's induction variable always holds and
+    // only the guarded store remains
+    // CHECK-LABEL: func @test_bounds_check_removed
+    // CHECK: scf.for %[[I:[a-zA-Z0-9_]+]] = %{{.*}} to %arg0 step %{{.*}} {
+    // CHECK-NOT: arith.cmpi
+    // CHECK-NOT: scf.if
+    // CHECK: memref.store %{{.*}}, %arg1[%[[I]]] : memref<4096xf32>
+    // CHECK: return
+    builtin.func @test_bounds_check_removed(%arg0: index, %arg1: memref<4096xf32>) attributes {accv.arg_constraints = [{max = 4096 : i64}, {}]} {
+        %c0 = arith.constant 0 : index
+        %c1 = arith.constant 1 : index
+        %c4096 = arith.constant 4096 : index
+        %cst = arith.constant 1.000000e+00 : f32
+        scf.for %i = %c0 to %arg0 step %c1 {
+            %0 = arith.cmpi slt, %i, %c4096 : index
+            scf.if %0 {
+                memref.store %cst, %arg1[%i] : memref<4096xf32>
+            }
+        }
+        return
+    }
+
+    // Without declared constraints nothing is known about N, so the boundary tile is kept
+    // CHECK-LABEL: func @test_unconstrained_boundary_tile_kept
+    // CHECK: arith.remsi %arg0, %{{.*}} : index
+    // CHECK: scf.if
+    // CHECK: memref.store
+    builtin.func @test_unconstrained_boundary_tile_kept(%arg0: index, %arg1: memref<?xf32>) {
+        %c0 = arith.constant 0 : index
+        %c16 = arith.constant 16 : index
+        %cst = arith.constant 0.000000e+00 : f32
+        %0 = arith.remsi %arg0, %c16 : index
+        %1 = arith.cmpi ne, %0, %c0 : index
+        scf.if %1 {
+            %2 = arith.subi %arg0, %0 : index
+            memref.store %cst, %arg1[%2] : memref<?xf32>
+        }
+        return
+    }
+}
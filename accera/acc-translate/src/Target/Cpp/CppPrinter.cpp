@@ -468,11 +468,17 @@ namespace cpp_printer
     }
 
     LogicalResult CppPrinter::printDecayedArrayDeclaration(MemRefType memRefType,
-                                                           StringRef arrayName)
+                                                           StringRef arrayName,
+                                                           bool isRestrict /* = false */)
     {
         RETURN_IF_FAILED(checkMemRefType(memRefType));
         RETURN_IF_FAILED(printType(memRefType.getElementType()));
-        os << " *" << arrayName;
+        os << " *";
+        if (isRestrict)
+        {
+            os << "__restrict__ ";
+        }
+        os << arrayName;
         return success();
     }
 
@@ -843,7 +849,11 @@ namespace cpp_printer
         auto argTy = arg.getType();
         if (auto memRefType = argTy.dyn_cast<MemRefType>())
         {
-            return printDecayedArrayDeclaration(memRefType, argName);
+            // The arguments of host-side API functions never alias each other, so let the
+            // host compiler know it can freely reorder and vectorize the accesses through them
+            auto funcOp = dyn_cast<FuncOp>(arg.getOwner()->getParentOp());
+            bool isRestrict = funcOp && funcOp->hasAttr(ir::RawPointerAPIAttrName) && !state.hasRuntime(Runtime::CUDA);
+            return printDecayedArrayDeclaration(memRefType, argName, isRestrict);
         }
 
         RETURN_IF_FAILED(printType(argTy));
@@ -940,17 +950,19 @@ namespace cpp_printer
         {
             return success();
         }
-        if (!globalOp.constant())
+        // Host code may also use mutable (and uninitialized) globals for its temporary buffers and caches
+        const bool isMutableHostGlobal = !globalOp.constant() && !state.hasRuntime(Runtime::CUDA);
+        if (!globalOp.constant() && !isMutableHostGlobal)
         {
             os << "<<only constant global supported>>;\n";
             return failure();
         }
-        if (globalOp.isExternal())
+        if (globalOp.isExternal() && !isMutableHostGlobal)
         {
             os << "<<only internal global supported>>;\n";
             return failure();
         }
-        if (globalOp.isUninitialized())
+        if (globalOp.isUninitialized() && !isMutableHostGlobal)
         {
             os << "<<only initialized global supported>>;\n";
             return failure();
@@ -962,7 +974,18 @@ namespace cpp_printer
             return failure();
         }
         auto rank = memrefType.getRank();
-        os << "constexpr "; // since we only support constant buffers
+        if (isMutableHostGlobal)
+        {
+            os << "static ";
+            if (auto alignment = globalOp.alignment())
+            {
+                os << "alignas(" << *alignment << ") ";
+            }
+        }
+        else
+        {
+            os << "constexpr "; // since we only support constant buffers
+        }
         RETURN_IF_FAILED(printType(memrefType.getElementType()));
         os << " ";
         os << globalOp.getName();
@@ -977,9 +1000,11 @@ namespace cpp_printer
                 os << "[" << d << "]";
             }
         }
-        os << " ";
-
-        RETURN_IF_FAILED(printAttribute(globalOp.initial_value()->cast<ElementsAttr>()));
+        if (auto initialValue = globalOp.initial_value(); initialValue && initialValue->isa<ElementsAttr>())
+        {
+            os << " ";
+            RETURN_IF_FAILED(printAttribute(initialValue->cast<ElementsAttr>()));
+        }
         os << ";\n";
         return success();
     }
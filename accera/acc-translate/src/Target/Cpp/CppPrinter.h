@@ -307,8 +307,10 @@ namespace cpp_printer
 
         /// print an array declaration that is decayed into a pointer, e.g.
         /// for an n-d array ``int a[2][3]'', it would become ``int (*a)[3]'';
+        /// If isRestrict is set, the pointer is qualified with __restrict__
         LogicalResult printDecayedArrayDeclaration(MemRefType memrefType,
-                                                   StringRef arrayName);
+                                                   StringRef arrayName,
+                                                   bool isRestrict = false);
 
         /// print BlockArgument
         LogicalResult printBlockArgument(BlockArgument arg);
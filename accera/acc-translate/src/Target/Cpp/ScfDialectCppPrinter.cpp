@@ -6,6 +6,9 @@
 
 #include "ScfDialectCppPrinter.h"
 
+#include <mlir/Dialect/GPU/GPUDialect.h>
+#include <mlir/Dialect/OpenMP/OpenMPDialect.h>
+
 using namespace mlir::scf;
 
 namespace mlir
@@ -150,6 +153,76 @@ namespace cpp_printer
         return success();
     }
 
+    LogicalResult ScfDialectCppPrinter::printParallelOp(ParallelOp parallelOp)
+    {
+        if (parallelOp.getNumReductions() != 0)
+        {
+            return parallelOp.emitOpError() << "<<scf.parallel with reductions is not supported yet>>";
+        }
+
+        auto numLoops = parallelOp.getNumLoops();
+
+        // The parallel loop nest is printed as a perfect nest of for loops. When
+        // targeting the CPU, the nest is annotated with the OpenMP clauses that
+        // were plumbed through from the parallelization info, e.g.:
+        //   #pragma omp parallel for num_threads(8) schedule(static) proc_bind(close) collapse(2)
+        //   for (int64_t i = lb0; i < ub0; i += s0) {
+        //   for (int64_t j = lb1; j < ub1; j += s1) {
+        //     ...
+        //   }
+        //   }
+        if (state.hasRuntime(Runtime::OPENMP))
+        {
+            os << "#pragma omp parallel for";
+            if (auto numThreads = parallelOp->getAttrOfType<IntegerAttr>(omp::getNumThreadsAttrName()))
+            {
+                os << " num_threads(" << numThreads.getInt() << ")";
+            }
+            if (auto schedule = parallelOp->getAttrOfType<StringAttr>(omp::getScheduleAttrName()))
+            {
+                os << " schedule(" << schedule.getValue().lower() << ")";
+            }
+            if (auto procBind = parallelOp->getAttrOfType<StringAttr>(omp::getProcBindAttrName()))
+            {
+                os << " proc_bind(" << procBind.getValue().lower() << ")";
+            }
+            if (numLoops > 1)
+            {
+                os << " collapse(" << numLoops << ")";
+            }
+            os << "\n";
+        }
+
+        for (auto e : llvm::zip(parallelOp.getInductionVars(), parallelOp.getLowerBound(), parallelOp.getUpperBound(), parallelOp.getStep()))
+        {
+            auto idx = std::get<0>(e);
+            StringRef idxName =
+                state.nameState.getOrCreateName(idx, SSANameState::SSANameKind::LoopIdx);
+            StringRef lowerBoundName = state.nameState.getOrCreateName(
+                std::get<1>(e), SSANameState::SSANameKind::Variable);
+            StringRef upperBoundName = state.nameState.getOrCreateName(
+                std::get<2>(e), SSANameState::SSANameKind::Variable);
+            StringRef stepName = state.nameState.getOrCreateName(
+                std::get<3>(e), SSANameState::SSANameKind::Variable);
+
+            os << "for (";
+            RETURN_IF_FAILED(printer->printType(idx.getType()));
+            os << " " << idxName << " = " << lowerBoundName << "; ";
+            os << idxName << " < " << upperBoundName << "; ";
+            os << idxName << " += " << stepName << ") {\n";
+        }
+
+        // The region is terminated by an scf.yield without operands, so skip it
+        RETURN_IF_FAILED(printer->printRegion(parallelOp.getRegion(), /*printParens*/ false,
+                                              /*printBlockTerminator*/ false));
+
+        for (unsigned i = 0; i < numLoops; ++i)
+        {
+            os << "}\n";
+        }
+        return success();
+    }
+
     template <typename RangeT>
     LogicalResult ScfDialectCppPrinter::printYieldOp(YieldOp yieldOp,
                                                      RangeT retValues)
@@ -203,9 +276,39 @@ namespace cpp_printer
             return printIfOp(ifOp);
         }
 
+        if (auto parallelOp = dyn_cast<ParallelOp>(op))
+        {
+            *skipped = true;
+            return printParallelOp(parallelOp);
+        }
+
         *consumed = false;
         return success();
     }
 
+    LogicalResult ScfDialectCppPrinter::runPrePrintingPasses(Operation* op)
+    {
+        // Parallel loops outside of device code are emitted as OpenMP worksharing
+        // loops, so enable the OpenMP runtime when we find any on the host
+        if (state.hasRuntime(Runtime::CUDA))
+        {
+            return success();
+        }
+
+        auto walkResult = op->walk([&](ParallelOp parallelOp) {
+            if (!parallelOp->getParentOfType<gpu::GPUModuleOp>())
+            {
+                return WalkResult::interrupt();
+            }
+            return WalkResult::advance();
+        });
+        if (walkResult.wasInterrupted())
+        {
+            state.setRuntime(Runtime::OPENMP);
+        }
+
+        return success();
+    }
+
 } // namespace cpp_printer
 } // namespace mlir
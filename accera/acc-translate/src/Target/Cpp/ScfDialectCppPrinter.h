@@ -23,12 +23,17 @@ namespace cpp_printer
 
         std::string getName() override { return "Scf"; }
 
+        LogicalResult runPrePrintingPasses(Operation* op) override;
+
         /// print Operation from StandardOps Dialect
         LogicalResult printDialectOperation(Operation* op, bool* skipped, bool* consumed) override;
 
         /// print scf::ForOp
         LogicalResult printForOp(scf::ForOp forOp);
 
+        /// print scf::ParallelOp as a (collapsed) OpenMP worksharing loop nest
+        LogicalResult printParallelOp(scf::ParallelOp parallelOp);
+
         /// print scf::IfOp
         LogicalResult printIfOp(scf::IfOp ifOp);
 
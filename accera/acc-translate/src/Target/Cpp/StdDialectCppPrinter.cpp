@@ -755,6 +755,11 @@ namespace cpp_printer
 
     LogicalResult StdDialectCppPrinter::printHeaderFiles()
     {
+        if (!state.hasRuntime(Runtime::CUDA))
+        {
+            os << "#include <cmath>\n";
+            os << "#include <cstdint>\n";
+        }
         return success();
     }
 
@@ -772,6 +777,12 @@ namespace cpp_printer
 #endif // _MSC_VER
 #endif // __forceinline__
 
+#ifndef __restrict__
+#if defined(_MSC_VER)
+#define __restrict__ __restrict
+#endif // _MSC_VER
+#endif // __restrict__
+
 )STD";
         }
 
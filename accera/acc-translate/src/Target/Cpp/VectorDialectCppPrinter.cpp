@@ -89,6 +89,100 @@ namespace cpp_printer
         return success();
     }
 
+    LogicalResult VectorDialectCppPrinter::printFMAOp(vector::FMAOp op)
+    {
+        // GCC vector extension types support element-wise arithmetic, so leave it
+        // to the host compiler to contract this into an fma instruction
+        RETURN_IF_FAILED(printer->printDeclarationForValue(op.getResult()));
+        os << " = " << state.nameState.getName(op.lhs());
+        os << " * " << state.nameState.getName(op.rhs());
+        os << " + " << state.nameState.getName(op.acc());
+        return success();
+    }
+
+    LogicalResult VectorDialectCppPrinter::printReductionOp(vector::ReductionOp op)
+    {
+        StringRef combiner;
+        switch (op.kind())
+        {
+        case vector::CombiningKind::ADD:
+            combiner = " + ";
+            break;
+        case vector::CombiningKind::MUL:
+            combiner = " * ";
+            break;
+        default:
+            return op.emitOpError() << "<<unsupported vector reduction kind>>";
+        }
+
+        auto vecTy = op.getVectorType();
+        if (vecTy.getRank() != 1)
+        {
+            os << "[[ only rank 1 vector is supported ]]";
+            return failure();
+        }
+
+        auto vecName = state.nameState.getName(op.vector());
+        RETURN_IF_FAILED(printer->printDeclarationForValue(op.getResult()));
+        os << " = ";
+        if (auto acc = op.acc())
+        {
+            os << state.nameState.getName(acc) << combiner;
+        }
+        llvm::interleave(
+            llvm::seq<int64_t>(0, vecTy.getNumElements()),
+            os,
+            [&](int64_t idx) { os << vecName << "[" << idx << "]"; },
+            combiner);
+        return success();
+    }
+
+    LogicalResult VectorDialectCppPrinter::runPrePrintingPasses(Operation* op)
+    {
+        if (state.hasRuntime(Runtime::CUDA))
+        {
+            return success();
+        }
+
+        op->walk([&](Operation* subOp) {
+            for (auto type : subOp->getResultTypes())
+            {
+                if (auto vecTy = type.dyn_cast<VectorType>(); vecTy && vecTy.getRank() == 1 && vecTy.getNumElements() > 1)
+                {
+                    hostVectorTypes.insert(vecTy);
+                }
+            }
+        });
+        return success();
+    }
+
+    LogicalResult VectorDialectCppPrinter::printDeclarations()
+    {
+        // Host vectors are declared with the GCC vector extensions (supported by gcc and clang),
+        // e.g. typedef float vfloatx8_t __attribute__((vector_size(32), aligned(4)));
+        // Lowering the alignment of the typedef keeps vector loads and stores through
+        // arbitrarily offset pointers into the arrays well-defined.
+        for (auto vecTy : hostVectorTypes)
+        {
+            auto elementType = vecTy.getElementType();
+            if (!elementType.isIntOrFloat() || elementType.getIntOrFloatBitWidth() < 8 || elementType.isa<Float16Type, BFloat16Type, Float64Type>())
+            {
+                continue;
+            }
+            auto elementBytes = elementType.getIntOrFloatBitWidth() / 8;
+            os << "typedef ";
+            RETURN_IF_FAILED(printer->printType(elementType));
+            os << " ";
+            RETURN_IF_FAILED(printer->printType(vecTy));
+            os << " __attribute__((vector_size(" << elementBytes * vecTy.getNumElements() << "), aligned(" << elementBytes << ")));\n";
+        }
+        if (!hostVectorTypes.empty())
+        {
+            os << "\n";
+        }
+        return success();
+    }
+
     LogicalResult VectorDialectCppPrinter::printDialectOperation(Operation* op,
                                                                  bool* /*skipped*/,
                                                                  bool* consumed)
@@ -105,6 +199,10 @@ namespace cpp_printer
             return printStoreOp(storeOp);
         if (auto broadcastOp = dyn_cast<mlir::vector::BroadcastOp>(op))
             return printBroadcastOp(broadcastOp);
+        if (auto fmaOp = dyn_cast<mlir::vector::FMAOp>(op))
+            return printFMAOp(fmaOp);
+        if (auto reductionOp = dyn_cast<mlir::vector::ReductionOp>(op))
+            return printReductionOp(reductionOp);
 
 
         *consumed = false;
@@ -11,6 +11,8 @@
 
 #include <mlir/Dialect/Vector/IR/VectorOps.h>
 
+#include <llvm/ADT/SetVector.h>
+
 namespace mlir
 {
 namespace cpp_printer
@@ -23,6 +25,10 @@ namespace cpp_printer
 
         std::string getName() override { return "Vector"; }
 
+        LogicalResult runPrePrintingPasses(Operation* op) override;
+
+        LogicalResult printDeclarations() override;
+
         /// print Operation from GPU Dialect
         LogicalResult printDialectOperation(Operation* op, bool* skipped, bool* consumed) override;
         LogicalResult printExtractElementOp(vector::ExtractElementOp op);
@@ -30,6 +36,12 @@ namespace cpp_printer
         LogicalResult printLoadOp(vector::LoadOp op);
         LogicalResult printStoreOp(vector::StoreOp op);
         LogicalResult printBroadcastOp(vector::BroadcastOp op);
+        LogicalResult printFMAOp(vector::FMAOp op);
+        LogicalResult printReductionOp(vector::ReductionOp op);
+
+    private:
+        // vector types used by host code, which are declared as GCC vector extension types
+        llvm::SetVector<VectorType> hostVectorTypes;
     };
 
 } // namespace cpp_printer
@@ -78,7 +78,11 @@ def DEFAULT_RC_MLIR_LOWERING_PASSES(
     system_target=SystemTarget.HOST.value,
     profile=False,
     runtime=Runtime.DEFAULT.value,
-    gpu_only=False
+    gpu_only=False,
+    workspace_allocator=False,
+    huge_page_threshold=0,
+    num_threads=0,
+    cpp_source=False
 ):
     def bstr(val):
         return "true" if val else "false"
@@ -90,6 +94,10 @@ def DEFAULT_RC_MLIR_LOWERING_PASSES(
         f'target={system_target}',
         f'enable-profiling={bstr(profile)}',
         f'gpu-only={bstr(gpu_only)}',
+        f'workspace-allocator={bstr(workspace_allocator)}',
+        f'huge-page-threshold={huge_page_threshold}',
+        f'num-threads={num_threads}',
+        f'cpp-source={bstr(cpp_source)}',
     ])
 
     return [f'--acc-to-llvm="{acc_to_llvm_str}"']
@@ -137,6 +145,11 @@ class Options(Flag):
     NONE = auto() # (enable auto unroll | no debug info)
     DISABLE_AUTO_UNROLL = auto()
     KEEP_DEBUG_INFO = auto()
+    WORKSPACE_ALLOCATOR = auto()
+    HUGE_PAGES = auto()
+
+# Buffers at least this large are backed by huge pages when Options.HUGE_PAGES is set
+HUGE_PAGE_THRESHOLD = 2 * 1024 * 1024
 
 def _get_common_debug_info_options_args(options: Options):
     if options & Options.KEEP_DEBUG_INFO:
@@ -755,7 +768,11 @@ class AcceraProject:
         runtime=Runtime.DEFAULT.value,
         profile=False,
         quiet=None,
-        gpu_only=False
+        gpu_only=False,
+        workspace_allocator=False,
+        huge_page_threshold=0,
+        num_threads=0,
+        cpp_source=False
     ):
 
         quiet = quiet if quiet is not None else self.quiet
@@ -766,7 +783,11 @@ class AcceraProject:
             system_target=system_target,
             runtime=runtime,
             profile=profile,
-            gpu_only=gpu_only
+            gpu_only=gpu_only,
+            workspace_allocator=workspace_allocator,
+            huge_page_threshold=huge_page_threshold,
+            num_threads=num_threads,
+            cpp_source=cpp_source
         )
 
         if self.print_subprocess_output:
@@ -1010,6 +1031,7 @@ class AcceraProject:
         runtime=Runtime.DEFAULT.value,
         quiet=None,
         gpu_only=False,
+        num_threads=0,
         _options: Options=Options.NONE
     ):
         # By default, save stdout and stderr for each phase to separate files
@@ -1048,7 +1070,11 @@ class AcceraProject:
                 runtime=runtime,
                 profile=profile,
                 quiet=quiet,
-                gpu_only=gpu_only
+                gpu_only=gpu_only,
+                workspace_allocator=bool(_options & Options.WORKSPACE_ALLOCATOR),
+                huge_page_threshold=HUGE_PAGE_THRESHOLD if _options & Options.HUGE_PAGES else 0,
+                num_threads=num_threads,
+                cpp_source=self.output_type == ModuleOutputType.CPP
             )
 
         if self.output_type == ModuleOutputType.OBJECT:
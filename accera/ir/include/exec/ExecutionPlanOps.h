@@ -163,7 +163,8 @@ CacheInfo MakeManualCacheInfo(
 
 mlir::AffineMap ComputeFlatAffineMapFromAffineCoefficients(
     mlir::OpBuilder& builder,
-    const utilities::MemoryAffineCoefficients& affineMapping);
+    const utilities::MemoryAffineCoefficients& affineMapping,
+    const std::vector<int64_t>& shape = {});
 
 ScheduleShardMapping GetScheduleShardMapping(
     loopnest::ScheduleOp schedule,
@@ -108,7 +108,13 @@ const mlir::StringRef NoInlineIntoAttrName = "accv.no_inline_into";
 const mlir::StringRef BaseNameAttrName = "accv.base_name";
 const mlir::StringRef DynamicArgSizeReferencesAttrName = "accv.dyn_arg_size_refs";
 const mlir::StringRef UsagesAttrName = "accv.usages";
+const mlir::StringRef ArgConstraintsAttrName = "accv.arg_constraints";
 const mlir::StringRef TargetDeviceFeaturesAttrName = "accv.target_device_features";
+const mlir::StringRef WorkspaceSizeAttrName = "accv.workspace_size";
+const mlir::StringRef DynamicWorkspaceAttrName = "accv.dynamic_workspace";
+const mlir::StringRef HugePagesAttrName = "accv.huge_pages";
+const mlir::StringRef StreamingAttrName = "accv.streaming";
+const mlir::StringRef AsyncEntryAttrName = "accv.async_entry";
 
 } // namespace accera::ir
 
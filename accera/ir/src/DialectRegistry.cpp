@@ -5,6 +5,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "DialectRegistry.h"
+#include "argo/ArgoOps.h"
 #include "exec/ExecutionPlanOps.h"
 #include "nest/LoopNestOps.h"
 #include "accera/AcceraOps.h"
@@ -41,6 +42,7 @@ mlir::DialectRegistry& GetDialectRegistry()
                         executionPlan::ExecutionPlanDialect,
                         intrinsics::AcceraIntrinsicsDialect,
                         rc::AcceraDialect,
+                        mlir::argo::ArgoDialect,
 
                         // MLIR dialects
                         StandardOpsDialect,
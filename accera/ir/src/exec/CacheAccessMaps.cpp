@@ -18,6 +18,10 @@ namespace executionPlan
 
     static const std::string CoefficientsName = "coefficients";
     static const std::string OffsetName = "offset";
+    static const std::string BlockSizesName = "blockSizes";
+    static const std::string BlockOrderName = "blockOrder";
+    static const std::string PaddingName = "padding";
+    static const std::string SwizzleName = "swizzle";
 
     mlir::DictionaryAttr SerializeMemoryAffineCoefficients(mlir::OpBuilder& builder, const utilities::MemoryAffineCoefficients& coefficients)
     {
@@ -31,6 +35,22 @@ namespace executionPlan
             builder.getStringAttr(OffsetName),
             builder.getI64IntegerAttr(coefficients.offset)));
 
+        if (coefficients.IsBlocked())
+        {
+            mappings.emplace_back(mlir::NamedAttribute(
+                builder.getStringAttr(BlockSizesName),
+                builder.getI64ArrayAttr(coefficients.blockSizes)));
+            mappings.emplace_back(mlir::NamedAttribute(
+                builder.getStringAttr(BlockOrderName),
+                builder.getI64ArrayAttr(coefficients.blockOrder)));
+            mappings.emplace_back(mlir::NamedAttribute(
+                builder.getStringAttr(PaddingName),
+                builder.getI64IntegerAttr(coefficients.padding)));
+            mappings.emplace_back(mlir::NamedAttribute(
+                builder.getStringAttr(SwizzleName),
+                builder.getI64ArrayAttr(coefficients.swizzle)));
+        }
+
         return mlir::DictionaryAttr::get(builder.getContext(),mappings);
     }
 
@@ -46,6 +66,14 @@ namespace executionPlan
         assert(offsetAttr.isa<mlir::IntegerAttr>());
         coefficients.offset = offsetAttr.cast<mlir::IntegerAttr>().getInt();
 
+        if (auto blockSizesAttr = dictAttr.get(BlockSizesName))
+        {
+            coefficients.blockSizes = util::ConvertArrayAttrToIntVector(blockSizesAttr.cast<mlir::ArrayAttr>());
+            coefficients.blockOrder = util::ConvertArrayAttrToIntVector(dictAttr.get(BlockOrderName).cast<mlir::ArrayAttr>());
+            coefficients.padding = dictAttr.get(PaddingName).cast<mlir::IntegerAttr>().getInt();
+            coefficients.swizzle = util::ConvertArrayAttrToIntVector(dictAttr.get(SwizzleName).cast<mlir::ArrayAttr>());
+        }
+
         return coefficients;
     }
 
@@ -71,7 +99,7 @@ namespace executionPlan
                 builder.getStringAttr(InputIndicesToActiveBlockCacheName),
                 mlir::AffineMapAttr::get(inputIndicesToActiveBlockCache)));
         }
-        if (!coefficients.coefficients.empty())
+        if (!coefficients.coefficients.empty() || coefficients.IsBlocked())
         {
             mappings.emplace_back(mlir::NamedAttribute(
                 builder.getStringAttr(MemoryAffineCoefficientsName),
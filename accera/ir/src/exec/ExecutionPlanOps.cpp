@@ -439,8 +439,52 @@ namespace executionPlan
     // Compute the AffineMap that maps from access indices to cache buffer position using the given MemoryAffineCoefficients
     // e.g. with MemoryAffineCoefficients = { coefficients = [ 1, 2, 3 ], offset = 4 }
     //          compute (d0, d1, d2) -> ( d0*1 + d1*2 + d2*3 + 4 )
-    mlir::AffineMap ComputeFlatAffineMapFromAffineCoefficients(OpBuilder& builder, const utilities::MemoryAffineCoefficients& affineMapping)
+    // Blocked layouts are resolved against the given shape,
+    // e.g. with blockSizes = [ 0, 8 ], blockOrder = [ 1, 2, 3 ] and shape [ 16, 32 ]
+    //          compute (d0, d1) -> ( (d1 floordiv 8)*128 + d0*8 + d1 mod 8 )
+    mlir::AffineMap ComputeFlatAffineMapFromAffineCoefficients(OpBuilder& builder, const utilities::MemoryAffineCoefficients& affineMapping, const std::vector<int64_t>& shape)
     {
+        if (affineMapping.IsBlocked())
+        {
+            assert(affineMapping.blockSizes.size() == shape.size() && "Blocked layouts need the shape of the buffer they lay out");
+            auto components = utilities::ResolveBlockedLayout(affineMapping, shape);
+
+            // the position within the block along each dimension, before swizzling
+            std::vector<mlir::AffineExpr> positionsInBlock;
+            for (size_t dim = 0; dim < shape.size(); ++dim)
+            {
+                auto blockSize = affineMapping.blockSizes[dim] > 0 ? std::min(affineMapping.blockSizes[dim], shape[dim]) : shape[dim];
+                auto dimExpr = builder.getAffineDimExpr(dim);
+                positionsInBlock.push_back(blockSize < shape[dim] ? dimExpr % blockSize : dimExpr);
+            }
+
+            mlir::AffineExpr flatAffinePositionExpr = builder.getAffineConstantExpr(affineMapping.offset);
+            for (const auto& component : components)
+            {
+                if (component.extent == 1)
+                {
+                    continue;
+                }
+                auto dimExpr = builder.getAffineDimExpr(component.dimension);
+                mlir::AffineExpr componentExpr;
+                if (!component.withinBlock)
+                {
+                    componentExpr = dimExpr.floorDiv(component.blockSize);
+                }
+                else if (!affineMapping.swizzle.empty() && affineMapping.swizzle[0] == component.dimension)
+                {
+                    auto sourcePosition = positionsInBlock[affineMapping.swizzle[1]];
+                    componentExpr = (positionsInBlock[component.dimension] + sourcePosition * affineMapping.swizzle[2]) % component.blockSize;
+                }
+                else
+                {
+                    componentExpr = positionsInBlock[component.dimension];
+                }
+                flatAffinePositionExpr = flatAffinePositionExpr + componentExpr * component.stride;
+            }
+            return mlir::AffineMap::get(shape.size(), 0, flatAffinePositionExpr, builder.getContext());
+        }
+
         mlir::AffineExpr flatAffinePositionExpr = builder.getAffineConstantExpr(affineMapping.offset);
         for (size_t logicalAccessIndexPos = 0; logicalAccessIndexPos < affineMapping.coefficients.size(); ++logicalAccessIndexPos)
         {
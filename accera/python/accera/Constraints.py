@@ -0,0 +1,198 @@
+####################################################################################################
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See LICENSE in the project root for license information.
+####################################################################################################
+
+import operator as ops
+from collections import Counter
+from typing import Callable, List, Union
+
+from .Parameter import DelayedParameter
+
+# Symbol and precedence of each operator, for formatting parameter expressions
+_OPERATORS = {
+    ops.__lshift__: ("<<", 0),
+    ops.__rshift__: (">>", 0),
+    ops.__add__: ("+", 1),
+    ops.__sub__: ("-", 1),
+    ops.__mul__: ("*", 2),
+    ops.__truediv__: ("/", 2),
+    ops.__floordiv__: ("//", 2),
+    ops.__mod__: ("%", 2),
+    ops.__pow__: ("**", 3),
+}
+
+
+def _evaluate(expr):
+    return expr.get_value() if isinstance(expr, DelayedParameter) else expr
+
+
+def _describe(expr) -> str:
+    "Formats a parameter expression, e.g. 'P0 * P2 + P1'"
+    if not isinstance(expr, DelayedParameter):
+        return str(expr)
+    if not expr._operation:
+        return expr._name or "<parameter>"
+    if expr._operation in _OPERATORS and expr._operand2 is not None:
+        symbol, precedence = _OPERATORS[expr._operation]
+
+        def operand(x, right: bool):
+            text = _describe(x)
+            if isinstance(x, DelayedParameter) and x._operation in _OPERATORS and x._operand2 is not None:
+                inner = _OPERATORS[x._operation][1]
+                if inner < precedence or (right and inner == precedence):
+                    return f"({text})"
+            return text
+
+        return f"{operand(expr._operand1, False)} {symbol} {operand(expr._operand2, True)}"
+    return f"{getattr(expr._operation, '__name__', 'op')}({_describe(expr._operand1)})"
+
+
+class Constraint:
+    """A condition on parameter values that is checked before any code is generated.
+
+    Conditions are written in terms of parameters and parameter expressions (such as `P0 * P1`),
+    which are evaluated with the values of each combination.
+    """
+
+    def __init__(self, condition: Callable[[], bool], reason: str):
+        """Creates a constraint.
+
+        Args:
+            condition: A callable with no arguments that returns whether the current parameter values are valid.
+                Use `DelayedParameter.get_value()` to read the values.
+            reason: Why a combination that fails the condition is invalid. Used in pruning reports.
+        """
+        self.condition = condition
+        self.reason = reason
+        self.num_rejected = 0
+
+    def __call__(self, parameters: dict) -> bool:
+        for param, value in parameters.items():
+            param.set_value(value)
+        return bool(self.condition())
+
+
+def divisible(value: Union[DelayedParameter, int], divisor: Union[DelayedParameter, int], reason: str = None) -> Constraint:
+    "Requires `value` to be a multiple of `divisor`, e.g. a tile size that is a multiple of an unroll factor"
+    return Constraint(
+        lambda: _evaluate(value) % _evaluate(divisor) == 0, reason
+        or f"{_describe(value)} is not a multiple of {_describe(divisor)}"
+    )
+
+
+def at_most(value: Union[DelayedParameter, int], bound: Union[DelayedParameter, int], reason: str = None) -> Constraint:
+    "Requires `value <= bound`, e.g. a split size that doesn't exceed the dimension it splits"
+    return Constraint(
+        lambda: _evaluate(value) <= _evaluate(bound), reason or f"{_describe(value)} exceeds {_describe(bound)}"
+    )
+
+
+def fits_in_cache(
+    num_elements: Union[DelayedParameter, int],
+    target: "accera.Target",
+    level: int = 1,
+    element_type: "accera.ScalarType" = None,
+    fraction: float = 1.0,
+    reason: str = None
+) -> Constraint:
+    """Requires a working set of `num_elements` elements to fit in the target's cache.
+
+    Args:
+        num_elements: The number of elements, usually the product of the tile sizes of the cached arrays.
+        target: The target whose `cache_sizes` to check against.
+        level: The cache level, starting from 1 for L1.
+        element_type: The element type. Defaults to `ScalarType.float32`.
+        fraction: The fraction of the cache that the working set may use, to leave room for other data.
+        reason: Overrides the reason reported for pruned combinations.
+    """
+    from ._lang_python import ScalarType, type_size_bytes
+
+    if level < 1 or level > len(target.cache_sizes):
+        raise ValueError(f"Target {target.name} has no L{level} cache size information")
+
+    element_bytes = type_size_bytes(element_type or ScalarType.float32)
+    capacity = target.cache_sizes[level - 1] * 1024 * fraction    # cache sizes are in KB
+    return Constraint(
+        lambda: _evaluate(num_elements) * element_bytes <= capacity, reason
+        or f"{_describe(num_elements)} elements overflow the L{level} cache"
+    )
+
+
+def vector_width_divides(
+    size: Union[DelayedParameter, int],
+    target: "accera.Target",
+    element_type: "accera.ScalarType" = None,
+    reason: str = None
+) -> Constraint:
+    """Requires `size` (typically the innermost, vectorized tile) to be a multiple of the target's vector width.
+
+    Args:
+        size: The number of elements along the vectorized dimension.
+        target: The target whose `vector_bytes` to check against.
+        element_type: The element type. Defaults to `ScalarType.float32`.
+        reason: Overrides the reason reported for pruned combinations.
+    """
+    from ._lang_python import ScalarType, type_size_bytes
+
+    width = max(target.vector_bytes // type_size_bytes(element_type or ScalarType.float32), 1)
+    return Constraint(
+        lambda: _evaluate(size) % width == 0, reason
+        or f"{_describe(size)} is not a multiple of the vector width ({width})"
+    )
+
+
+class PruningReport:
+    "How many parameter combinations were pruned, and by which constraint"
+
+    def __init__(self, num_combinations: int = 0, reasons: Counter = None):
+        self.num_combinations = num_combinations
+        self.reasons = reasons or Counter()
+
+    @property
+    def num_pruned(self) -> int:
+        return sum(self.reasons.values())
+
+    def __str__(self):
+        lines = [f"Pruned {self.num_pruned} of {self.num_combinations} parameter combinations"]
+        lines += [f"  {count}: {reason}" for reason, count in self.reasons.most_common()]
+        return "\n".join(lines)
+
+
+def make_variant_filter(
+    keys: List[DelayedParameter],
+    filter_func: Union[Callable, Constraint, List[Union[Callable, Constraint]]],
+    report: PruningReport = None
+) -> Callable[[tuple], bool]:
+    """Returns a predicate over tuples of values (in the order of `keys`) that applies `filter_func`.
+
+    `filter_func` may be a callable that receives the tuple of values, a `Constraint`, or a list of either.
+    Constraints are checked in order, and a rejected combination is counted against the first constraint it fails.
+    """
+    if filter_func is None:
+        checks = []
+    elif isinstance(filter_func, (list, tuple)):
+        checks = list(filter_func)
+    else:
+        checks = [filter_func]
+
+    def accepts(variant: tuple) -> bool:
+        if report is not None:
+            report.num_combinations += 1
+        for check in checks:
+            if isinstance(check, Constraint):
+                ok = check(dict(zip(keys, variant)))
+                reason = check.reason
+            else:
+                ok = check(variant)
+                reason = getattr(check, "__name__", "<lambda>")
+                reason = "filter_func" if reason == "<lambda>" else reason
+            if not ok:
+                if isinstance(check, Constraint):
+                    check.num_rejected += 1
+                if report is not None:
+                    report.reasons[reason] += 1
+                return False
+        return True
+
+    return accepts
@@ -20,12 +20,100 @@ from . import _lang_python, lang, algorithms
 from .Targets import Target, Runtime
 from .Parameter import *
 from .Constants import inf
-from .Platforms import Platform, get_library_reference
+from .Platforms import Platform, LibraryDependency, get_library_reference
 
 _R_INT = r"(\d+)"
 _R_DIM3 = f"dim3\({_R_INT},\s*{_R_INT},\s*{_R_INT}\)"
 _R_GPU_LAUNCH = f"<<<{_R_DIM3},\s*{_R_DIM3},\s*{_R_INT}>>>"
 del _R_DIM3
+_R_LLVM_FUNC = r"llvm\.func (?:\w+ )*@(\w+)\("
+_R_WORKSPACE_SIZE = f"accv\.workspace_size = {_R_INT}"
+_WORKSPACE_SIZE_FN_SUFFIX = "_workspace_size"
+_SET_WORKSPACE_FN_SUFFIX = "_SetWorkspace"
+_STREAM_FN_SUFFIX = "_stream"
+_ASYNC_FN_SUFFIX = "_async"
+
+_WORKSPACE_DECLARATION = """
+// Sets the scratch buffer used for the temporary allocations of the functions in this package
+// that are called on the current thread. Size it with the <function>_workspace_size functions or
+// the "workspace" auxiliary metadata of each function. Allocations that don't fit, or that are
+// made on other threads (including the worker thread that runs the <function>_async calls),
+// fall back to the heap.
+void {set_workspace_fn}(void* buffer, uintptr_t size);
+"""
+
+
+def _make_c_declarations(decls: List[str]) -> str:
+    "Wraps declarations appended to a HAT header so that they have C linkage"
+    return "\n".join(["#if defined(__cplusplus)", 'extern "C"', "{", "#endif // defined(__cplusplus)"] + decls +
+                     ["#if defined(__cplusplus)", '} // extern "C"', "#endif // defined(__cplusplus)", ""])
+
+
+def _parse_workspace_sizes(lowered_mlir_path: str, set_workspace_fn_name: str) -> Dict[str, dict]:
+    "Scrapes the per-function workspace requirements annotated by the workspace allocator from the lowered MLIR"
+    workspaces = {}
+    func_names = set()
+    with open(lowered_mlir_path) as f:
+        for line in f:
+            func = re.search(_R_LLVM_FUNC, line)
+            if not func:
+                continue
+            func_names.add(func[1])
+            size = re.search(_R_WORKSPACE_SIZE, line)
+            if size:
+                workspaces[func[1]] = {
+                    "static_size": int(size[1]),
+                    "runtime_sized": "accv.dynamic_workspace" in line,
+                    "set_function": set_workspace_fn_name
+                }
+
+    # Link each function to the companion that computes its workspace size from its runtime dimensions
+    for name, workspace in workspaces.items():
+        size_fn_name = name + _WORKSPACE_SIZE_FN_SUFFIX
+        if size_fn_name in func_names:
+            workspace["size_function"] = size_fn_name
+    return workspaces
+
+
+def _make_workspace_size_declaration(hat_func: hat.Function, size_fn_name: str) -> str:
+    "Declares the workspace size companion of a function, which takes the function's input scalars by value"
+    dims = [
+        f"{arg.declared_type} {arg.name}" for arg in hat_func.arguments
+        if arg.logical_type == hat.ParameterType.Element and arg.usage == hat.UsageType.Input
+    ]
+    return f"int64_t {size_fn_name}({', '.join(dims) or 'void'});"
+
+
+def _make_stream_declaration(hat_func: hat.Function, stream_fn_name: str) -> str:
+    "Declares the streaming driver of a function, which takes the same arguments as the function"
+    args = [f"{arg.declared_type} {arg.name}" for arg in hat_func.arguments]
+    return f"void {stream_fn_name}({', '.join(args) or 'void'});"
+
+
+def _make_async_declaration(hat_func: hat.Function, async_fn_name: str) -> str:
+    "Declares the asynchronous entry point of a function, which takes the function's arguments and a completion callback"
+    args = [f"{arg.declared_type} {arg.name}" for arg in hat_func.arguments]
+    args += ["void (*completion_cb)(void* user_data)", "void* user_data"]
+    return f"int32_t {async_fn_name}({', '.join(args)});"
+
+
+def _validate_streaming(args: List[Union["accera.Dimension", "accera.Array"]], dim: "accera.Dimension", tile_size: int):
+    "Checks that the arrays sized by the streaming dimension can be walked in contiguous tiles of rows"
+    if not isinstance(dim, _lang_python._lang.Dimension) or not any(arg is dim for arg in args):
+        raise ValueError("The streaming dimension must be one of the function's Dimension arguments")
+    if dim.role != _lang_python.Role.INPUT:
+        raise ValueError("The streaming dimension must be an input")
+    if not isinstance(tile_size, int) or tile_size <= 0:
+        raise ValueError(f"Invalid streaming tile size {tile_size}")
+
+    streamed = [arg for arg in args if isinstance(arg, lang.Array) and any(d is dim for d in arg.shape)]
+    if not streamed:
+        raise ValueError("At least one array argument must be sized by the streaming dimension")
+    for arr in streamed:
+        if arr.shape[0] is not dim or any(d is dim for d in arr.shape[1:]):
+            raise ValueError("The streaming dimension must be the outermost dimension of the arrays it sizes, and only that one")
+        if arr.layout != lang.Array.Layout.FIRST_MAJOR:
+            raise ValueError("Streamed arrays must have the FIRST_MAJOR layout")
 
 
 @singledispatch
@@ -157,6 +245,8 @@ class Package:
         NONE = auto()    # (enable auto unroll | low precision fp ops)
         DISABLE_AUTO_UNROLL = auto()
         HIGH_PRECISION_FLOATING_POINT_OPS = auto()
+        WORKSPACE_ALLOCATOR = auto()    # serve temporary heap allocations from a caller-provided workspace
+        HUGE_PAGES = auto()    # back large caches, temporary arrays and packed buffers with huge pages
 
     Platform = Platform
 
@@ -364,6 +454,12 @@ class Package:
             if isinstance(arr, lang.Array):
                 _resolve_array_shape(source, arr)
 
+        if function_opts.get("streaming"):
+            _validate_streaming(args, *function_opts["streaming"])
+
+        if function_opts.get("async_entry"):
+            self._dynamic_dependencies.add(LibraryDependency.PTHREADS)
+
         if isinstance(source, lang.Nest) or isinstance(source, lang.Schedule):
             # assumption: convenience functions are for host targets only
             source = source.create_plan(Target.HOST)
@@ -431,6 +527,42 @@ class Package:
         else:
             raise ValueError("Invalid type for source")
 
+    def add_batch_interleave_helpers(self,
+                                     array: "accera.Array",
+                                     batch_dim: int = 0,
+                                     base_name: str = "") -> Tuple["accera.Function", "accera.Function"]:
+        """Adds functions that convert a batch between the first-major layout and the batch-interleaved layout of
+        `accera.batch_interleaved_layout`, so that callers can keep their data in the standard layout.
+
+        Returns the pair of functions (pack, unpack). `pack(standard, interleaved)` copies a first-major batch into the
+        interleaved layout, and `unpack(interleaved, standard)` copies it back.
+
+        Args:
+            array: An array with the shape and element type of the batch
+            batch_dim: The batch dimension of the array
+            base_name: A base name for the functions, which are suffixed with "_pack" and "_unpack"
+        """
+        shape = tuple(array.shape)
+        interleaved_layout = lang.batch_interleaved_layout(shape, batch_dim)
+        base_name = base_name or array.name or "batch"
+
+        def make_copy(source_layout, dest_layout, suffix):
+            source = lang.Array(role=_lang_python.Role.INPUT, element_type=array.element_type, shape=shape, layout=source_layout)
+            dest = lang.Array(role=_lang_python.Role.INPUT_OUTPUT, element_type=array.element_type, shape=shape, layout=dest_layout)
+
+            nest = lang.Nest(shape=shape)
+            indices = tuple(nest.get_indices())
+
+            @nest.iteration_logic
+            def _():
+                dest[indices] = source[indices]
+
+            return self.add(nest, args=(source, dest), base_name=f"{base_name}_{suffix}")
+
+        pack = make_copy(lang.Array.Layout.FIRST_MAJOR, interleaved_layout, "pack")
+        unpack = make_copy(interleaved_layout, lang.Array.Layout.FIRST_MAJOR, "unpack")
+        return pack, unpack
+
     def _add_functions_to_module(self, module, fail_on_error=False):
         with SetActiveModule(module):
             to_pop = []
@@ -540,6 +672,10 @@ class Package:
         accc_opts = accc.Options.NONE
         if options & Package._Options.DISABLE_AUTO_UNROLL:
             accc_opts |= accc.Options.DISABLE_AUTO_UNROLL
+        if options & Package._Options.WORKSPACE_ALLOCATOR:
+            accc_opts |= accc.Options.WORKSPACE_ALLOCATOR
+        if options & Package._Options.HUGE_PAGES:
+            accc_opts |= accc.Options.HUGE_PAGES
         return accc_opts
 
     def _apply_options_to_funcs(self, options: _Options):
@@ -555,6 +691,7 @@ class Package:
         mode: Mode = Mode.RELEASE,
         platform: Platform = Platform.HOST,
         tolerance: float = 1e-5,
+        verification_samples: int = None,
         output_dir: str = None,
         fail_on_error: bool = False,
         profile: bool = False,
@@ -569,6 +706,9 @@ class Package:
             mode: The package mode, such as whether it is optimized or used for debugging.
             platform: The platform where the package runs.
             tolerance: The tolerance for correctness checking when `mode = Package.Mode.DEBUG`.
+            verification_samples: The approximate number of output elements to check when `mode = Package.Mode.DEBUG`.
+                The reference implementation only computes the sampled elements, which keeps checking fast for large
+                outputs. Defaults to checking every output element.
             output_dir: The path to an output directory. Defaults to the current directory if unspecified.
         """
 
@@ -613,9 +753,13 @@ class Package:
 
         # Debug mode: add utility functions for checking results and mark target functions
         if mode == Package.Mode.DEBUG:
+            if verification_samples is not None and verification_samples <= 0:
+                raise ValueError("verification_samples must be a positive integer")
+
             debug_utilities = self._add_debug_utilities(tolerance)
             for fn_name, utilities in debug_utilities.items():
                 self._fns[fn_name].output_verifiers = utilities
+                self._fns[fn_name].verification_samples = verification_samples or 0
 
         # Create the package module
         package_module = _lang_python._Module(name=name, options=compiler_options)
@@ -656,6 +800,7 @@ class Package:
             dump_all_passes=dump_ir,
             dump_intrapass_ir=dump_ir_verbose,
             gpu_only=compiler_options.gpu_only,
+            num_threads=target.num_threads,
             quiet=_quiet,
             _options=accc_options
         )
@@ -696,6 +841,16 @@ class Package:
                 # Merge the function maps
                 hat_file._function_table.function_map.update(support._function_table.function_map)
 
+            workspaces = {}
+            companion_decls = []
+            if _opts & Package._Options.WORKSPACE_ALLOCATOR and output_type == accc.ModuleOutputType.OBJECT:
+                # The setter is named after the package, so that packages loaded together don't share a workspace
+                set_workspace_fn_name = name + _SET_WORKSPACE_FN_SUFFIX
+                companion_decls.append(_WORKSPACE_DECLARATION.format(set_workspace_fn=set_workspace_fn_name))
+                workspaces = _parse_workspace_sizes(
+                    proj.module_file_sets[0].lowered_mlir_filepath, set_workspace_fn_name
+                )
+
             decl_code = hat_file.declaration.code
             hat_file.dependencies.dynamic = dynamic_dependencies + supporting_objs
             hat_file.declaration.code = decl_code._new("\n".join(map(str, ["", decl_code] + supporting_decls)))
@@ -711,6 +866,44 @@ class Package:
 
                     hat_func.auxiliary = fn.auxiliary
 
+                    if fn_name in workspaces:
+                        hat_func.auxiliary = {
+                            **fn.auxiliary, "accera": {
+                                **fn.auxiliary.get("accera", {}), "workspace": workspaces[fn_name]
+                            }
+                        }
+
+                        if "size_function" in workspaces[fn_name]:
+                            companion_decls.append(
+                                _make_workspace_size_declaration(hat_func, workspaces[fn_name]["size_function"])
+                            )
+
+                    if fn.streaming and output_type == accc.ModuleOutputType.OBJECT:
+                        stream_fn_name = fn_name + _STREAM_FN_SUFFIX
+                        dim, tile_size = fn.streaming
+                        hat_func.auxiliary = {
+                            **hat_func.auxiliary, "accera": {
+                                **hat_func.auxiliary.get("accera", {}), "streaming": {
+                                    "driver": stream_fn_name,
+                                    "dimension": fn.arg_names[fn.requested_args.index(dim)],
+                                    "tile_size": tile_size
+                                }
+                            }
+                        }
+                        companion_decls.append(_make_stream_declaration(hat_func, stream_fn_name))
+
+                    if fn.async_entry and output_type == accc.ModuleOutputType.OBJECT:
+                        async_fn_name = fn_name + _ASYNC_FN_SUFFIX
+                        hat_func.auxiliary = {
+                            **hat_func.auxiliary, "accera": {
+                                **hat_func.auxiliary.get("accera", {}), "async": {
+                                    "entry_point": async_fn_name,
+                                    "completion_callback": "void (*)(void* user_data)"
+                                }
+                            }
+                        }
+                        companion_decls.append(_make_async_declaration(hat_func, async_fn_name))
+
                     if (fn.target.category == Target.Category.GPU and fn.target.runtime != Target.Runtime.VULKAN):
                         # TODO: Remove this when the header is emitted as part of the compilation
                         gpu_source = proj.module_file_sets[0].translated_source_filepath
@@ -742,6 +935,10 @@ class Package:
                             runtime=fn.target.runtime.name,
                         )
 
+            if companion_decls:
+                decl_code = hat_file.declaration.code
+                hat_file.declaration.code = decl_code._new("\n".join(map(str, [decl_code, _make_c_declarations(companion_decls)])))
+
             if target_device.is_windows():
                 hat_os = hat.OperatingSystem.Windows
             elif target_device.is_macOS():
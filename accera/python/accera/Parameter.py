@@ -3,7 +3,7 @@
 # Licensed under the MIT License. See LICENSE in the project root for license information.
 ####################################################################################################
 import operator as ops
-from typing import Any, List, Callable, Union
+from typing import Any, List, Callable, Tuple, Union
 from varname import varname
 
 # TODO: rename DelayedParameter to Parameter
@@ -163,8 +163,37 @@ def create_and_set_parameters(possible_values: List, append_suffix_to_varnames:
          name += token_hex(4)
     return DelayedParameter(name=name, possible_values=possible_values)
 
+def expand_parameter_choices(parameter_choices: dict) -> Tuple[List[DelayedParameter], List[list]]:
+    """Expands a dictionary that maps each parameter to its possible values into parallel lists of
+    parameters and their choices. Scalar values become single-element choices and loop orders are
+    expanded to every permutation of their indices.
+
+    Args:
+        parameter_choices: A dictionary that maps each parameter to its possible values.
+    """
+    import itertools
+    from .lang import LoopIndex
+
+    choices = []
+    keys = []
+
+    for key, value in parameter_choices.items():
+        try:
+            _ = iter(value)
+        except TypeError:
+            value = [value]
+
+        # if the parameter is a loop order, we permute the indices
+        if all(isinstance(v, LoopIndex) for v in value):
+            value = list(itertools.permutations(value, len(value)))
+
+        choices.append(list(value))
+        keys.append(key)
+
+    return keys, choices
+
 def create_parameter_grid(
-    parameter_choices: dict, filter_func: Callable = None, sample: int = 0, seed=None
+    parameter_choices: dict, filter_func: Callable = None, sample: int = 0, seed=None, report: bool = False
 ) -> List[dict]:
     """
     Create a parameter grid from a dictionary that maps each parameter to its possible values,
@@ -184,32 +213,26 @@ def create_parameter_grid(
                                         }
 
             filter_func: A callable to filter parameter_choices which returns a bool to indicate whether a given parameter combination should be included in the grid.
+                         Alternatively, a `Constraint` (such as `divisible` or `fits_in_cache` from `accera.Constraints`), or a list of
+                         constraints and callables which must all accept a combination.
             sample: A number to limit the number of parameter grid.
             seed: A number as the seed value for the generator to start with to generate a random number.
+            report: Print how many combinations were pruned by each constraint.
     """
     import itertools
+    import logging
     import random
-    from .lang import LoopIndex
-
-    choices = []
-    keys = []
-
-    for key, value in parameter_choices.items():
-        try:
-            _ = iter(value)
-        except TypeError:
-            value = [value]
-
-        # if the parameter is a loop order, we permute the indices
-        if all(isinstance(v, LoopIndex) for v in value):
-            value = list(itertools.permutations(value, len(value)))
-
-        choices.append(value)
-        keys.append(key)
+    from .Constraints import PruningReport, make_variant_filter
 
+    keys, choices = expand_parameter_choices(parameter_choices)
     choice_variants = itertools.product(*choices)
 
-    filtered_choice_variants = list(filter(filter_func, choice_variants))
+    pruning_report = PruningReport()
+    filtered_choice_variants = list(filter(make_variant_filter(keys, filter_func, pruning_report), choice_variants))
+    logging.info(str(pruning_report))
+    if report:
+        print(pruning_report)
+
     if sample > 0 and sample < len(filtered_choice_variants):
         if seed:
             random.seed(seed)
@@ -27,6 +27,7 @@ class Platform(Enum):
 class LibraryDependency(Enum):
     OPENMP = "openmp"
     VULKAN = "vulkan"
+    PTHREADS = "pthreads"
 
 
 def find_vulkan_wrapper(file_name):
@@ -73,6 +74,13 @@ platform_libraries = {
             "target_file": "libomp.lib",
             "version": ""
         }
+    },
+    # pthreads is part of the C library on macOS, and Windows uses the Win32 thread API
+    LibraryDependency.PTHREADS: {
+        Platform.LINUX: {
+            "target_file": "-lpthread",
+            "version": ""
+        }
     }
 }
 
@@ -0,0 +1,43 @@
+####################################################################################################
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See LICENSE in the project root for license information.
+####################################################################################################
+
+import numpy as np
+from typing import Tuple, Union
+
+from ._lang_python import _fill_random_values, _fill_random_int_values
+
+
+def random_array(
+    shape: Union[int, Tuple[int]],
+    dtype=np.float32,
+    low: Union[int, float] = None,
+    high: Union[int, float] = None,
+    seed: int = 0,
+    offset: int = 0
+) -> np.ndarray:
+    """Creates an array filled with uniformly distributed random values, for initializing test and benchmark inputs.
+
+    The values are generated in parallel from a counter-based generator, so they only depend on the seed and on the
+    position in the stream, and not on the number of threads used.
+
+    Args:
+        shape: The shape of the array
+        dtype: The element type of the array. Integer types are drawn from [low, high], floating-point types from [low, high)
+        low: The lower bound of the values (defaults to -1.0 for floating-point types and 0 for integer types)
+        high: The upper bound of the values (defaults to 1.0 for floating-point types and 100 for integer types)
+        seed: Selects the random stream
+        offset: The position in the stream of the first element, e.g. to continue a stream across several arrays
+    """
+    dtype = np.dtype(dtype)
+    if np.issubdtype(dtype, np.integer):
+        buffer = np.empty(shape, dtype=np.intc)
+        _fill_random_int_values(buffer, seed, offset, 0 if low is None else int(low), 100 if high is None else int(high))
+    elif np.issubdtype(dtype, np.floating):
+        buffer = np.empty(shape, dtype=np.float32)
+        _fill_random_values(buffer, seed, offset, -1.0 if low is None else float(low), 1.0 if high is None else float(high))
+    else:
+        raise ValueError(f"Unsupported dtype for random_array: {dtype}")
+
+    return buffer if buffer.dtype == dtype else buffer.astype(dtype)
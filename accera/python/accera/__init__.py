@@ -11,14 +11,16 @@ except:
 
 from .Targets import Target, KNOWN_DEVICES, KNOWN_CPUS, KNOWN_GPUS
 from .Parameter import DelayedParameter, create_parameters, create_parameter_grid
+from .Constraints import Constraint
 from .Constants import *
 from .Package import Package
+from .Random import random_array
 
 from .lang import *
 from ._lang_python import CompilerOptions, ScalarType, _GetTargetDeviceFromName, AllocateFlags, Role
 from ._lang_python import (
     abs, max, min, ceil, floor, sqrt, exp, fast_exp, fast_exp_mlas, log, log10, log2, sin, cos, tan, sinh, cosh, tanh, logical_and, logical_or,
-    logical_not, cast, round, remainderf, type_size_bytes
+    logical_not, cast, round, remainderf, type_size_bytes, atomic_add, atomic_max, atomic_min, atomic_exchange
 )
 from ._lang_python._lang import MMAShape, MMASchedulingPolicy, MMAFragmentOp, CacheStrategy
 
@@ -69,14 +69,15 @@ class Array:
 
                 where s_offset=0 in the current implementation.
 
-               Currently, only affine memory maps for the first-major and last-major layouts are supported. For example,
-               given a 4-dimensional shape vector v_shape = (s0, s1, s2, s3):
+               Currently, only affine memory maps of dense layouts are supported, which store the dimensions in some order
+               without gaps. For example, given a 4-dimensional shape vector v_shape = (s0, s1, s2, s3):
 
                     First-major: (s0xs1xs2, s0xs1, s2, 1)
 
                     Last-major: (1, s0, s0xs1, s0xs1xs2)
 
               In both cases, the last dimension (s3) is not used in computing the affine memory map.
+              `accera.batch_interleaved_layout` computes the affine memory map that stores a batch dimension innermost.
             offset: The offset of the affine memory map | integer (positive, zero, or negative), default: 0
             shape: The array shape. Required for roles other than `Role.CONST`, should not be specified for `Role.CONST`
         """
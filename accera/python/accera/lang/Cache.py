@@ -8,6 +8,7 @@ from typing import Any, Tuple, Union
 
 from .Array import Array
 from .LoopIndex import LoopIndex
+from .Layout import BlockedLayout
 from .._lang_python._lang import (
     CacheIndexing, _CacheAllocation, CacheStrategy, _MemorySpace, _MemoryAffineCoefficients, _DimensionOrder
 )
@@ -22,7 +23,7 @@ class Cache:
     level: int = None
     trigger_level: int = None
     element_type: "accera.ScalarType" = None
-    layout: Union[Array.Layout, Tuple[int]] = None
+    layout: Union[Array.Layout, Tuple[int], BlockedLayout] = None
     max_elements: int = None
     thrifty: bool = False
     double_buffer: bool = False
@@ -56,6 +57,15 @@ class Cache:
 
             mmap_layout = MemoryMapLayout(self.layout, self.target_shape, self.offset)
             return _MemoryAffineCoefficients(mmap_layout.coefficients, mmap_layout.offset)
+        if isinstance(self.layout, BlockedLayout):
+            return _MemoryAffineCoefficients(
+                [],
+                self.offset,
+                block_sizes=list(self.layout.block_sizes),
+                block_order=list(self.layout.order),
+                padding=self.layout.padding,
+                swizzle=list(self.layout.swizzle or [])
+            )
         return None
 
     @property
@@ -78,6 +78,9 @@ class Function:
     auxiliary: dict = field(default_factory=dict)
     target: Target = Target.HOST
     output_verifiers: list = field(default_factory=list)
+    verification_samples: int = 0 # number of sampled output elements to verify in debug mode, 0 verifies all
+    streaming: tuple = None # (dimension, tile size) of the <name>_stream driver that calls this function on tiles of rows
+    async_entry: bool = False # async_entry == True emits <name>_async, which runs this function on a new thread
 
     def __post_init__(self):
         # automatically fill if not specified
@@ -97,9 +100,14 @@ class Function:
         if self.args:
             usages = [role_to_usage(arg) for arg in self.requested_args]
             self._native_fn.parameters(self.args, usages, self.arg_size_references, self.arg_names, self.arg_sizes)
+            constraints = self._get_arg_constraints()
+            if constraints:
+                self._native_fn.argumentConstraints(constraints)
 
             if self.output_verifiers:
                 self._native_fn.outputVerifiers(self.output_verifiers)
+                if self.verification_samples:
+                    self._native_fn.verificationSamples(self.verification_samples)
 
         self._native_fn.inlinable(not self.no_inline)
         self._native_fn.inlinable_into(not self.no_inline_into)
@@ -125,10 +133,24 @@ class Function:
             api_decl = _DeclareFunction(self.name)
             if self.args:
                 api_decl.parameters(self.args, usages, self.arg_size_references, self.arg_names, self.arg_sizes)
+                if constraints:
+                    api_decl.argumentConstraints(constraints)
             if self.base_name:
                 api_decl.baseName(self.base_name)
+            if self.streaming:
+                dim, tile_size = self.streaming
+                api_decl.streaming(self.requested_args.index(dim), tile_size)
+            if self.async_entry:
+                api_decl.asyncEntry(True)
             api_decl.public(True).decorated(False).headerDecl(True).rawPointerAPI(True).define(self._native_fn)
 
+    def _get_arg_constraints(self):
+        "Returns the declared min/max/multiple_of constraints per argument, or None if no argument has any"
+        dims = [arg if isinstance(arg, Dimension) else None for arg in self.requested_args]
+        if any(d is not None and (d.min is not None or d.max is not None or d.multiple_of is not None) for d in dims):
+            return dims
+        return None
+
     def __call__(self, *args):
         self._emit()
         self._native_fn.__call__(list(map(_unpack_arg, args)))
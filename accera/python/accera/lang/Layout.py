@@ -5,7 +5,7 @@
 
 from enum import Enum, auto
 from dataclasses import dataclass
-from typing import Tuple, Union
+from typing import List, Tuple, Union
 
 
 class Layout(Enum):
@@ -55,6 +55,42 @@ def get_coefficients_for_layout(layout: Layout, shape: Tuple[int]):
     return coeffs[::-1] if layout == Layout.FIRST_MAJOR else coeffs
 
 
+def _infer_dimension_order(coefficients: Tuple[int], shape: Tuple[int]) -> List[int]:
+    "The major-to-minor order of the dimensions of a dense layout with the given coefficients, or None if it isn't dense"
+    if len(coefficients) != len(shape):
+        return None
+
+    # dimensions of size 1 don't move through memory, so their coefficients don't matter
+    order = sorted([d for d in range(len(shape)) if shape[d] != 1], key=lambda d: coefficients[d], reverse=True)
+    stride = 1
+    for d in reversed(order):
+        if coefficients[d] != stride:
+            return None
+        stride *= shape[d]
+    return [d for d in range(len(shape)) if shape[d] == 1] + order
+
+
+def batch_interleaved_layout(shape: Tuple[int], batch_dim: int = 0) -> Tuple[int]:
+    """The coefficients of a layout that stores `batch_dim` innermost and the other dimensions first-major, so that the
+    same element of consecutive problems in a batch is contiguous. For a batch of `B` matrices of shape `(M, N)`,
+    `batch_interleaved_layout((B, M, N))` is `(1, N * B, B)`.
+
+    Use it as the `layout` of an `accera.Array` to vectorize across the problems of a batch with
+    `Schedule.interleave_batch`.
+    """
+    rank = len(shape)
+    if not 0 <= batch_dim < rank:
+        raise ValueError(f"Batch dimension {batch_dim} is out of range for a {rank}-dimensional array")
+    if not all(isinstance(s, int) for s in shape):
+        raise ValueError("Batch-interleaved layouts need a static shape")
+
+    coefficients = [0] * rank
+    stride = 1
+    for d in [batch_dim] + [d for d in reversed(range(rank)) if d != batch_dim]:
+        coefficients[d], stride = stride, stride * shape[d]
+    return tuple(coefficients)
+
+
 @dataclass(frozen=True)
 class MemoryMapLayout:
     layout: Union[Tuple[int], Layout]
@@ -76,9 +112,209 @@ class MemoryMapLayout:
                 result = range(ndim)
             elif self.layout == first_major_coeffs[::-1]:
                 result = range(ndim)[::-1]
+            else:
+                result = _infer_dimension_order(self.layout, self.shape)
         elif isinstance(self.layout, Layout):
             if self.layout == Layout.FIRST_MAJOR:
                 result = range(ndim)
             elif self.layout == Layout.LAST_MAJOR:
                 result = range(ndim)[::-1]
         return result
+
+
+@dataclass(frozen=True)
+class BlockedLayout:
+    """A cache layout that stores the active block as a grid of blocks, optionally padded or swizzled so that
+    power-of-two strides don't map to the same cache sets.
+
+    The layout is resolved against the shape of the active block when the cache is created, so the same layout can be
+    used for caches of any size. Use the constructors below rather than building one directly.
+    """
+
+    #: The block size along each dimension, or 0 to leave a dimension unblocked.
+    block_sizes: Tuple[int]
+
+    #: The major-to-minor order of the block components, where `d` is the block index along dimension `d`
+    #: and `rank + d` is the position within the block along dimension `d`. Components that are left out are
+    #: placed outermost. Defaults to the block indices followed by the positions within a block.
+    order: Tuple[int] = ()
+
+    #: Elements added to the stride of the second-innermost component.
+    padding: int = 0
+
+    #: None, or (dim, source_dim, shift): the position within a block along `dim` is rotated by `shift` times the
+    #: position within a block along `source_dim`, modulo the block size along `dim`.
+    swizzle: Tuple[int, int, int] = None
+
+    @staticmethod
+    def blocked(*block_sizes: int) -> "BlockedLayout":
+        """Stores the array as a first-major grid of first-major blocks, e.g. `blocked(8, 8)` for a 2D "panel of panels".
+
+        Args:
+            block_sizes: The block size along each dimension, or 0 to leave a dimension unblocked.
+        """
+        return BlockedLayout(tuple(block_sizes))
+
+    @staticmethod
+    def panels(rank: int, dim: int, size: int) -> "BlockedLayout":
+        """Stores the array as panels of `size` elements along `dim`, with the elements of each panel interleaved
+        along `dim` innermost. For a matrix multiplication, `panels(2, 0, MR)` packs A into MR-row micro-panels and
+        `panels(2, 1, NR)` packs B into NR-column micro-panels.
+        """
+        block_sizes = [0] * rank
+        block_sizes[dim] = size
+        order = [dim] + [rank + d for d in range(rank) if d != dim] + [rank + dim]
+        return BlockedLayout(tuple(block_sizes), tuple(order))
+
+    @staticmethod
+    def nchwc(block: int) -> "BlockedLayout":
+        "Stores an NCHW array as NCHWc: the channels are split into blocks of `block`, which are stored innermost"
+        return BlockedLayout((0, block, 0, 0), (4 + 0, 1, 4 + 2, 4 + 3, 4 + 1))
+
+    @staticmethod
+    def padded(rank: int, padding: int) -> "BlockedLayout":
+        "A first-major layout whose leading dimension is padded by `padding` elements"
+        return BlockedLayout((0, ) * rank, padding=padding)
+
+    @staticmethod
+    def swizzled(rank: int, shift: int = 1) -> "BlockedLayout":
+        """A first-major layout whose rows are rotated by `shift` elements per row, which spreads the elements of a
+        column across cache sets without padding. Accesses along a row stay contiguous except where they wrap around.
+        """
+        if rank < 2:
+            raise ValueError("Swizzled layouts need at least 2 dimensions")
+        return BlockedLayout((0, ) * rank, swizzle=(rank - 1, rank - 2, shift))
+
+    def _resolve(self, shape: Tuple[int]) -> List[Tuple[int, bool, int, int, int]]:
+        "(dim, within_block, block_size, extent, stride) of each component, major to minor, as the lowering computes them"
+        rank = len(shape)
+        if len(self.block_sizes) != rank:
+            raise ValueError("Blocked layouts need one block size per dimension")
+        if len(set(self.order)) != len(self.order) or any(c < 0 or c >= 2 * rank for c in self.order):
+            raise ValueError("Blocked layout order must list each block component at most once")
+
+        order = list(self.order) or list(range(2 * rank))
+        order = [c for c in range(2 * rank) if c not in order] + order
+
+        components = []
+        for c in order:
+            dim = c % rank
+            block = min(self.block_sizes[dim], shape[dim]) if self.block_sizes[dim] > 0 else shape[dim]
+            within = c >= rank
+            components.append([dim, within, block, block if within else -(-shape[dim] // block), 0])
+
+        stride = 1
+        for k in reversed(range(len(components))):
+            components[k][4] = stride
+            stride = stride * components[k][3] + (self.padding if k == len(components) - 1 else 0)
+        return [tuple(c) for c in components]
+
+    def position(self, index: Tuple[int], shape: Tuple[int]) -> int:
+        "The position of an element of a buffer with the given shape"
+        components = self._resolve(shape)
+        blocks = {dim: block for dim, _, block, _, _ in components}
+        in_block = [i % blocks[d] for d, i in enumerate(index)]
+        position = 0
+        for dim, within, block, extent, stride in components:
+            if not within:
+                value = index[dim] // block
+            elif self.swizzle and self.swizzle[0] == dim:
+                value = (in_block[dim] + in_block[self.swizzle[1]] * self.swizzle[2]) % block
+            else:
+                value = in_block[dim]
+            position += value * stride
+        return position
+
+    def buffer_size(self, shape: Tuple[int]) -> int:
+        return sum(stride * (extent - 1) for _, _, _, extent, stride in self._resolve(shape)) + 1
+
+
+def pad_layout(layout: Union[Layout, BlockedLayout], rank: int, padding: int) -> BlockedLayout:
+    "Adds `padding` elements to the leading dimension of a first-major, last-major or blocked layout"
+    from dataclasses import replace
+
+    if isinstance(layout, BlockedLayout):
+        return replace(layout, padding=layout.padding + padding)
+    if layout == Layout.FIRST_MAJOR:
+        return BlockedLayout((0, ) * rank, padding=padding)
+    if layout == Layout.LAST_MAJOR:
+        return BlockedLayout((0, ) * rank, tuple(rank + d for d in reversed(range(rank))), padding=padding)
+    raise ValueError(f"Can't pad the layout {layout}")
+
+
+def dense_strides(layout: Union[Layout, Tuple[int]], shape: Tuple[int]) -> List[int]:
+    "The strides (in elements) of a dense buffer of `shape` laid out by `layout`, or the coefficients of an explicit layout"
+    if not isinstance(layout, Layout):
+        return list(layout)
+    dims = range(len(shape)) if layout == Layout.LAST_MAJOR else reversed(range(len(shape)))
+    strides, stride = [0] * len(shape), 1
+    for d in dims:
+        strides[d], stride = stride, stride * shape[d]
+    return strides
+
+
+@dataclass
+class ConflictReport:
+    "How the lines of a region of a buffer map to the sets of a cache"
+    num_lines: int
+    num_sets: int
+    sets_used: int
+    max_lines_per_set: int
+    conflicting_lines: int    # lines that don't fit in their set even though the region fits in the cache
+
+    @property
+    def has_conflicts(self) -> bool:
+        return self.conflicting_lines > 0
+
+    def __str__(self):
+        return (
+            f"{self.num_lines} lines map to {self.sets_used} of {self.num_sets} sets "
+            f"(up to {self.max_lines_per_set} per set), {self.conflicting_lines} conflicting lines"
+        )
+
+
+def check_conflicts(
+    layout: Union[Layout, Tuple[int], BlockedLayout],
+    shape: Tuple[int],
+    cache_size_bytes: int,
+    line_bytes: int = 64,
+    associativity: int = 8,
+    element_bytes: int = 4,
+    region: Tuple[int] = None
+) -> ConflictReport:
+    """Checks whether a region of a buffer laid out by `layout` causes conflict misses in a set-associative cache.
+
+    Args:
+        layout: The layout of the buffer.
+        shape: The shape of the buffer, e.g. the active block of a cache.
+        cache_size_bytes: The capacity of the cache.
+        line_bytes: The cache line size.
+        associativity: The number of lines per set.
+        element_bytes: The size of an element.
+        region: The shape of the region accessed together (e.g. by the innermost tile), anchored at the origin.
+            Defaults to the whole buffer.
+    """
+    from itertools import product
+
+    region = region or shape
+    if isinstance(layout, BlockedLayout):
+        position = lambda index: layout.position(index, shape)
+    else:
+        coefficients = dense_strides(layout, shape)
+        position = lambda index: sum(c * i for c, i in zip(coefficients, index))
+
+    lines = {position(index) * element_bytes // line_bytes for index in product(*[range(r) for r in region])}
+
+    num_sets = max(cache_size_bytes // (line_bytes * associativity), 1)
+    lines_per_set = {}
+    for line in lines:
+        lines_per_set[line % num_sets] = lines_per_set.get(line % num_sets, 0) + 1
+
+    fits = len(lines) <= num_sets * associativity
+    return ConflictReport(
+        num_lines=len(lines),
+        num_sets=num_sets,
+        sets_used=len(lines_per_set),
+        max_lines_per_set=max(lines_per_set.values(), default=0),
+        conflicting_lines=sum(max(n - associativity, 0) for n in lines_per_set.values()) if fits else 0
+    )
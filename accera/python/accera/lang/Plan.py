@@ -12,6 +12,7 @@ from ..Parameter import DelayedParameter
 from .Array import Array
 from .Schedule import Schedule, IndexTransform
 from .Cache import Cache, DelayedCache
+from .Layout import BlockedLayout
 from .Function import Function
 from .LoopIndex import LoopIndex
 from .NativeLoopNestContext import NativeLoopNestContext
@@ -62,6 +63,27 @@ class Plan:
     def print(self):
         self._sched.print(lambda index: self._index_attrs.get(index, []))
 
+    def analyze(
+        self,
+        parameters: Mapping[DelayedParameter, Any] = None,
+        memory_bandwidth_GBps: float = None,
+        peak_GFLOPs: float = None
+    ) -> "PlanAnalysis":
+        """Estimates the data footprint of each loop level and cache of the plan, and a roofline model of its performance.
+
+        The analysis runs before any code is generated: the iteration logic is traced to find the array accesses and
+        arithmetic of one iteration, and the footprints are the bounding boxes of the elements accessed below each loop.
+
+        Args:
+            parameters: Values for the parameters of the plan, if it is parameterized.
+            memory_bandwidth_GBps: The main memory bandwidth used for the roofline estimate.
+            peak_GFLOPs: The peak arithmetic rate used for the roofline estimate. Defaults to an estimate from the target's
+                frequency, vector width and the number of parallelized iterations.
+        """
+        from .PlanAnalysis import analyze_plan
+
+        return analyze_plan(self, parameters, memory_bandwidth_GBps, peak_GFLOPs)
+
     def _get_heuristic_parameters(self):
         return self._heuristic_params
 
@@ -195,6 +217,12 @@ class Plan:
         num_threads = min(max_threads, self._target.num_threads, self._sched._get_num_split_iterations(indices))
         logging.debug(f"Parallelizing with {num_threads} thread(s)")
 
+        if self._target.category == Target.Category.CPU:
+            from .PlanAnalysis import check_false_sharing, false_sharing_warning
+
+            for report in check_false_sharing(self, indices, policy, num_threads):
+                logging.warning(false_sharing_warning(report))
+
         idxs = [context.mapping[id(index)] for index in indices]
 
         context.plan.parallelize(
@@ -383,7 +411,7 @@ class Plan:
         source: Union[Array, Cache],
         index: Union[LoopIndex, DelayedParameter] = None,
         trigger_index: Union[LoopIndex, DelayedParameter] = None,
-        layout: Union[Array.Layout, DelayedParameter] = None,
+        layout: Union[Array.Layout, BlockedLayout, DelayedParameter] = None,
         max_elements: int = None,
         element_type: Union[ScalarType, DelayedParameter] = None,
         thrifty: Union[bool, DelayedParameter] = None,
@@ -395,6 +423,8 @@ class Plan:
         _shared_memory_offset: Union[int, DelayedParameter] = None,
         vectorize: Union[bool, DelayedParameter, object] = AUTO,
         strategy: CacheStrategy = AUTO,
+        pad_to_avoid_conflicts: bool = False,
+        hierarchy: str = None,
         _delayed_cache: DelayedCache = None,
         _temp_array_multicaches: bool = False # experimental: allow multi-caching of TEMP arrays
     ):
@@ -404,12 +434,14 @@ class Plan:
             source: The array or cache from which this cache is copied.
             index: The index used to determine the cache level. Specify one and only one of `index`, `level`, `max_elements`.
             trigger_index: The index used to determine what level to fill the cache at. `trigger_index` can't come after `index` in the schedule order, and will default to `index` if not specified. Specify at most one of `trigger_index` or `trigger_level`.
-            layout: The affine memory map, if different from the source.
+            layout: The affine memory map, if different from the source. Can be a `BlockedLayout` to block, pad or swizzle the cache.
             level: The key-slice level to cache (the number of wildcard dimensions in a key-slice). Specify one and only one of `index`, `level`, `max_elements`.
             trigger_level: The key-slice level to fill the cache at. `trigger_level` can't be smaller than `level`, and will default to `level` if not specified. Specify at most one of `trigger_index` or `trigger_level`.
             max_elements: The maximum elements to include in the cached region. Specify one and only one of `index`, `level`, `max_elements`.
             element_type: The element type to use in the cache. Defaults to the element type of the cached array.
             strategy: The thread to data mapping pattern to use when collaboratively caching by multiple threads. Defaults to AUTO which will resolve to the strategy best suited for the current target environment.
+            pad_to_avoid_conflicts: Pad the leading dimension of the cache by the fewest cache lines that keep the innermost tile from overflowing the sets of the target's L1 cache. The padding is chosen from the target's cache line size and L1 size, assuming 8-way associativity. Requires `index` or `level` and a schedule without parameters.
+            hierarchy: Set to "auto" to create a chain of hierarchical caches sized to the target's L3, L2 and L1 caches instead of a single cache. The loops and, unless `layout` is specified, the layouts are chosen automatically. Can't be combined with `index`, `trigger_index`, `level`, `trigger_level` or `max_elements`. Returns the innermost cache.
             thrifty: Use thrifty caching (copy data into a cache only if the cached data differs from the original active block). This defaults to False as it slows down compilation speed so it is intended as an opt-in feature.
             double_buffer: Make this a double buffer cache by copying data one iteration ahead and using private memory on GPU for this procedure.
             vectorize: Whether to vectorize the cache operations. Defaults to AUTO, which will behave like `vectorize=True` if the loopnest has a vectorized loop or `vectorize=False` if the loopnest has no vectorized loops.
@@ -420,6 +452,40 @@ class Plan:
                 | MemorySpace.SHARED  | True          | MemorySpace.PRIVATE             |
                 | !MemorySpace.SHARED | True          | Same value as location          |
         """
+        if hierarchy is not None:
+            if hierarchy != "auto":
+                raise ValueError("The only supported cache hierarchy is 'auto'")
+            if any(arg is not None for arg in (index, trigger_index, level, trigger_level, max_elements)):
+                raise ValueError(
+                    "Can't specify index, trigger_index, level, trigger_level or max_elements with an automatic cache hierarchy"
+                )
+            if not isinstance(source, Array):
+                raise ValueError("Automatic cache hierarchies can only be created for arrays")
+            if self._sched._delayed_calls or getattr(getattr(self._sched, "_nest", None), "_delayed_calls", None):
+                raise ValueError("Automatic cache hierarchies require a schedule without parameters")
+
+            from .PlanAnalysis import auto_cache_hierarchy
+
+            cache = source
+            for cache_index, cache_layout in auto_cache_hierarchy(self, source, layout):
+                cache = self.cache(
+                    cache,
+                    index=cache_index,
+                    layout=cache_layout or source._requested_layout,
+                    element_type=element_type,
+                    thrifty=thrifty,
+                    location=location,
+                    vectorize=vectorize,
+                    pad_to_avoid_conflicts=pad_to_avoid_conflicts
+                )
+            return cache
+
+        if pad_to_avoid_conflicts:
+            if max_elements is not None:
+                raise ValueError("Padding caches to avoid conflicts requires a cache index or level")
+            if self._sched._delayed_calls or getattr(getattr(self._sched, "_nest", None), "_delayed_calls", None):
+                raise ValueError("Padding caches to avoid conflicts requires a schedule without parameters")
+
         if (
             any(
                 [
@@ -454,6 +520,7 @@ class Plan:
                     source=source,
                     max_elements=max_elements,
                     location=location,
+                    pad_to_avoid_conflicts=pad_to_avoid_conflicts,
                     _delayed_cache=delayed_cache,
                 )
             ] = {
@@ -626,6 +693,23 @@ class Plan:
         if element_type is None:
             element_type = source.element_type
 
+        if isinstance(layout, BlockedLayout):
+            source_shape = source.target_shape if isinstance(source, Cache) else source.shape
+            if len(layout.block_sizes) != len(source_shape):
+                raise ValueError("Blocked layouts need one block size per dimension of the cached array")
+
+        if pad_to_avoid_conflicts:
+            from .PlanAnalysis import conflict_free_padding, _base_array
+            from .Layout import pad_layout
+
+            if not isinstance(layout, (Array.Layout, BlockedLayout)) or layout == Array.Layout.DEFERRED:
+                raise ValueError("Padding caches to avoid conflicts requires a first-major, last-major or blocked layout")
+
+            base_array = _base_array(source)
+            padding = conflict_free_padding(self, base_array, index, layout, element_type)
+            if padding:
+                layout = pad_layout(layout, len(base_array.shape), padding)
+
         cache = Cache(
             plan=self,
             target=source,
@@ -0,0 +1,884 @@
+####################################################################################################
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See LICENSE in the project root for license information.
+####################################################################################################
+
+import math
+import os
+from dataclasses import dataclass, field
+from functools import reduce
+from itertools import product
+from typing import Any, Dict, List, Optional, Tuple, Union
+
+from .Array import Array
+from .Cache import Cache, DelayedCache
+from .Layout import BlockedLayout, ConflictReport, Layout, check_conflicts, dense_strides, pad_layout
+from .LoopIndex import LoopIndex
+from ..Parameter import DelayedParameter
+
+
+def _resolve(value):
+    return value.get_value() if isinstance(value, DelayedParameter) else value
+
+
+def _product(values) -> int:
+    return reduce(lambda a, b: a * b, values, 1)
+
+
+################################################################################
+# Symbolic tracing of iteration logic
+################################################################################
+
+
+class _AffineExpr:
+    "A linear combination of nest indices plus a constant, as used to index arrays in iteration logic"
+
+    def __init__(self, coefficients: Dict[LoopIndex, int] = None, constant: int = 0):
+        self.coefficients = coefficients or {}
+        self.constant = constant
+
+    @staticmethod
+    def wrap(value):
+        if isinstance(value, _AffineExpr):
+            return value
+        if isinstance(value, int):
+            return _AffineExpr(constant=value)
+        return None
+
+    def __add__(self, other):
+        other = _AffineExpr.wrap(other)
+        if other is None:
+            return NotImplemented
+        coefficients = dict(self.coefficients)
+        for index, c in other.coefficients.items():
+            coefficients[index] = coefficients.get(index, 0) + c
+        return _AffineExpr(coefficients, self.constant + other.constant)
+
+    __radd__ = __add__
+
+    def __neg__(self):
+        return _AffineExpr({index: -c for index, c in self.coefficients.items()}, -self.constant)
+
+    def __sub__(self, other):
+        other = _AffineExpr.wrap(other)
+        return NotImplemented if other is None else self + (-other)
+
+    def __rsub__(self, other):
+        return (-self) + other
+
+    def __mul__(self, other):
+        if isinstance(other, int):
+            return _AffineExpr({index: c * other for index, c in self.coefficients.items()}, self.constant * other)
+        other = _AffineExpr.wrap(other)
+        if other is not None and not other.coefficients:
+            return self * other.constant
+        if other is not None and not self.coefficients:
+            return other * self.constant
+        return _NonAffine(self, other)
+
+    __rmul__ = __mul__
+
+    def _non_affine(self, other=None):
+        return _NonAffine(self, other)
+
+    __floordiv__ = __rfloordiv__ = __mod__ = __rmod__ = __truediv__ = __rtruediv__ = _non_affine
+
+
+class _NonAffine(_AffineExpr):
+    "An index expression that isn't affine; the access may touch the whole dimension"
+
+    def __init__(self, *operands):
+        indices = {}
+        for operand in operands:
+            if isinstance(operand, _AffineExpr):
+                indices.update({index: 1 for index in operand.coefficients})
+        super().__init__(indices)
+
+    def _combine(self, other=None):
+        return _NonAffine(self, other if isinstance(other, _AffineExpr) else None)
+
+    __add__ = __radd__ = __sub__ = __rsub__ = __mul__ = __rmul__ = __neg__ = _combine
+
+
+class _TraceValue:
+    "A stand-in for an element value that counts the arithmetic performed on it"
+
+    def __init__(self, tracer: "_Tracer"):
+        self.tracer = tracer
+
+    def _op(self, other=None):
+        self.tracer.flops += 1
+        return _TraceValue(self.tracer)
+
+    __add__ = __radd__ = __iadd__ = __sub__ = __rsub__ = __isub__ = _op
+    __mul__ = __rmul__ = __imul__ = __truediv__ = __rtruediv__ = __itruediv__ = _op
+    __floordiv__ = __rfloordiv__ = __mod__ = __rmod__ = __pow__ = __rpow__ = _op
+    __neg__ = __abs__ = _op
+    __lt__ = __le__ = __gt__ = __ge__ = _op
+
+
+class _TracingArray:
+    "A stand-in for an array that records the index expressions of each access"
+
+    def __init__(self, tracer: "_Tracer", array: Array):
+        self.tracer = tracer
+        self.array = array
+
+    def _record(self, key, write: bool):
+        key = key if isinstance(key, tuple) else (key, )
+        exprs = []
+        for k in key:
+            expr = _AffineExpr.wrap(k)
+            exprs.append(expr if expr is not None else _NonAffine())
+        self.tracer.accesses.append((self.array, tuple(exprs), write))
+
+    def __getitem__(self, key):
+        self._record(key, write=False)
+        return _TraceValue(self.tracer)
+
+    def __setitem__(self, key, value):
+        self._record(key, write=True)
+
+
+class _Tracer:
+    def __init__(self):
+        self.flops = 0
+        self.accesses: List[Tuple[Array, Tuple[_AffineExpr, ...], bool]] = []
+        self.errors: List[str] = []
+
+    def trace(self, logic_fn):
+        replacements = {}
+        for name, value in logic_fn.get_captures().items():
+            if isinstance(value, Array):
+                replacements[name] = _TracingArray(self, value)
+            elif isinstance(value, LoopIndex):
+                replacements[name] = _AffineExpr({value: 1})
+            elif isinstance(value, DelayedParameter):
+                replacements[name] = value.get_value()
+        try:
+            logic_fn(**replacements)
+        except Exception as e:
+            self.errors.append(f"Iteration logic '{logic_fn.__name__}' could only be partially analyzed: {e}")
+
+
+################################################################################
+# Resolving the schedule and plan for the current parameter values
+################################################################################
+
+
+def _replay(plan: "accera.Plan", parameters: dict = None):
+    "Sets parameter values and replays the parameterized nest and schedule transformations, as `Package.add` does"
+    for param, value in (parameters or {}).items():
+        param.set_value(value)
+
+    sched = plan._sched
+    if not hasattr(sched, "_nest"):
+        raise NotImplementedError("Analysis of fused schedules is not supported")
+    sched._nest._replay_delayed_calls()
+    sched._replay_delayed_calls()
+
+
+def _resolved_index_attrs(plan: "accera.Plan") -> Dict[LoopIndex, List[str]]:
+    "The vectorized, unrolled and parallelized loops of the plan, including parameterized calls"
+    attrs = {index: list(a) for index, a in plan._index_attrs.items()}
+    for call, params in plan._delayed_calls.items():
+        name = call.func.__name__
+        if name in ("vectorize", "unroll"):
+            index = _resolve(params[0] if isinstance(params, (list, tuple)) else params)
+            attrs.setdefault(index, []).append("vectorized" if name == "vectorize" else "unrolled")
+        elif name == "parallelize":
+            indices = _resolve(params["indices"])
+            for index in ([indices] if isinstance(indices, LoopIndex) else indices):
+                attrs.setdefault(index, []).append("parallelized")
+    return attrs
+
+
+def _resolved_caches(plan: "accera.Plan") -> List[dict]:
+    "The caches of the plan as dictionaries of their arguments, including parameterized calls"
+    caches = []
+    for cmd in plan._commands:
+        if getattr(getattr(cmd, "func", None), "__name__", "") != "_add_cache":
+            continue
+        cache = cmd.args[0]
+
+        # Parameterized caches are also enqueued as commands once a variant has been added, so take those from the delayed calls only
+        if isinstance(cache, DelayedCache):
+            continue
+        caches.append({
+            "source": cache.target,
+            "index": cache.index,
+            "trigger_index": cache.trigger_index,
+            "level": cache.level,
+            "max_elements": cache.max_elements,
+            "element_type": cache.element_type,
+            "double_buffer": cache.double_buffer,
+            "layout": cache.layout,
+        })
+
+    for call, params in plan._delayed_calls.items():
+        if call.func.__name__ == "cache":
+            cache = {key: _resolve(value) for key, value in params.items()}
+            cache["source"] = call.keywords.get("source")
+            cache["max_elements"] = _resolve(call.keywords.get("max_elements"))
+            cache.setdefault("layout", _resolve(call.keywords.get("layout")))
+            caches.append(cache)
+    return caches
+
+
+def _resolved_parallelizations(plan: "accera.Plan") -> List[Tuple[List[LoopIndex], str, Optional[int]]]:
+    "The (indices, policy, max_threads) of each parallelize call of the plan, including parameterized calls"
+    calls = []
+    for cmd in plan._commands:
+        if getattr(getattr(cmd, "func", None), "__name__", "") == "_parallelize":
+            calls.append(tuple(cmd.args[:3]))
+    for call, params in plan._delayed_calls.items():
+        if call.func.__name__ == "parallelize":
+            calls.append((_resolve(params["indices"]), _resolve(params["policy"]), _resolve(params["max_threads"])))
+    return [([indices] if isinstance(indices, LoopIndex) else list(indices), policy or "static", max_threads)
+            for indices, policy, max_threads in calls]
+
+
+def _base_array(source) -> Array:
+    while isinstance(source, Cache):
+        source = source.target
+    return source
+
+
+################################################################################
+# Analysis results
+################################################################################
+
+
+@dataclass
+class CacheAnalysis:
+    "The active block of one cache"
+    array: str
+    index: str    # the loop the cache is placed at
+    depth: int    # the position of that loop in the schedule order
+    shape: List[int]    # the extents of the active block
+    elements: int
+    bytes: int
+    fills: int    # how many times the cache is filled per call
+    bytes_packed: int    # the bytes copied into (and, for written arrays, out of) the cache per call
+    fits_in: Optional[str]    # the smallest target cache level that holds the active block, e.g. "L1"
+    layout: Any = None
+    conflicting_lines: int = 0    # L1 lines of the innermost tile that exceed the associativity of their set
+
+
+@dataclass
+class LoopLevelAnalysis:
+    "The data touched by one execution of the loop at `depth` (including the loops inside it)"
+    index: str
+    depth: int
+    iterations: int
+    step: int
+    attributes: List[str]
+    footprints: Dict[str, int]    # bytes per array
+    flops: int
+    arithmetic_intensity: float    # flops per byte of distinct data touched
+
+
+@dataclass
+class RooflineEstimate:
+    flops: int    # per call
+    memory_bytes: int    # estimated traffic to main memory per call
+    peak_GFLOPs: float
+    memory_bandwidth_GBps: float
+    arithmetic_intensity: float
+    attainable_GFLOPs: float
+    estimated_time_s: float
+    bound: str    # "compute" or "memory"
+
+
+@dataclass
+class FalseSharingReport:
+    "Neighboring thread partitions of a parallelized loop that write to the same cache lines of an array"
+    array: str
+    index: str    # the innermost parallelized loop
+    policy: str
+    chunk: int    # iterations of the parallelized loops per partition
+    boundaries: int    # partition boundaries checked
+    shared_boundaries: int    # boundaries where the partitions on either side write to the same line
+    aligned_chunk: int    # the fewest iterations of `index` whose writes end on a line boundary, 0 if unknown
+
+    def __str__(self):
+        return (
+            f"{self.shared_boundaries} of {self.boundaries} boundaries between the {self.policy} partitions of {self.index} "
+            f"({self.chunk} iteration{'s' if self.chunk != 1 else ''} each) split cache lines of {self.array}"
+        )
+
+
+@dataclass
+class PlanAnalysis:
+    caches: List[CacheAnalysis] = field(default_factory=list)
+    levels: List[LoopLevelAnalysis] = field(default_factory=list)
+    flops_per_iteration: int = 0
+    tile_depth: int = 0    # the depth of the innermost tile, see `Plan.analyze`
+    roofline: RooflineEstimate = None
+    false_sharing: List[FalseSharingReport] = field(default_factory=list)
+    warnings: List[str] = field(default_factory=list)
+
+    @property
+    def tile(self) -> LoopLevelAnalysis:
+        return self.levels[self.tile_depth]
+
+    def __str__(self):
+        lines = ["Loop levels:"]
+        for level in self.levels:
+            marker = " <- innermost tile" if level.depth == self.tile_depth else ""
+            attrs = f" [{', '.join(level.attributes)}]" if level.attributes else ""
+            footprint = sum(level.footprints.values())
+            lines.append(
+                f"  {level.depth}: {level.index} x{level.iterations} (step {level.step}){attrs}: "
+                f"{footprint} bytes, {level.flops} flops, {level.arithmetic_intensity:.3g} flops/byte{marker}"
+            )
+        if self.caches:
+            lines.append("Caches:")
+        for c in self.caches:
+            lines.append(
+                f"  {c.array} at {c.index} (depth {c.depth}): {'x'.join(map(str, c.shape))} = {c.bytes} bytes"
+                f"{' (fits in ' + c.fits_in + ')' if c.fits_in else ''}, filled {c.fills} times, {c.bytes_packed} bytes packed per call"
+                f"{', ' + str(c.conflicting_lines) + ' conflicting L1 lines' if c.conflicting_lines else ''}"
+            )
+        if self.roofline:
+            r = self.roofline
+            lines.append(
+                f"Roofline: {r.flops} flops, {r.memory_bytes} bytes from memory, {r.arithmetic_intensity:.3g} flops/byte, "
+                f"{r.attainable_GFLOPs:.3g} of {r.peak_GFLOPs:.3g} GFLOP/s attainable ({r.bound} bound), ~{r.estimated_time_s:.3g} s per call"
+            )
+        if self.false_sharing:
+            lines.append("False sharing:")
+        lines += [f"  {f}" for f in self.false_sharing]
+        lines += [f"Warning: {w}" for w in self.warnings]
+        return "\n".join(lines)
+
+
+################################################################################
+# Analysis
+################################################################################
+
+# Used when neither the target nor the caller provides the main memory bandwidth
+DEFAULT_MEMORY_BANDWIDTH_GBps = 25.0
+
+# Targets don't describe the associativity of their caches, so conflicts are checked against a typical L1
+DEFAULT_ASSOCIATIVITY = 8
+
+# Larger tiles are not checked for conflicts
+MAX_CONFLICT_CHECK_ELEMENTS = 1 << 16
+
+
+# OpenMP hands out one iteration at a time with the dynamic policy
+DYNAMIC_CHUNK_ITERATIONS = 1
+
+# Only the first partition boundaries, and partitions that write fewer elements per iteration, are checked for false sharing
+MAX_FALSE_SHARING_BOUNDARIES = 4096
+MAX_FALSE_SHARING_ELEMENTS = 1 << 16
+
+
+def _frequency_GHz(target) -> float:
+    if target.frequency_GHz:
+        return target.frequency_GHz
+    try:
+        import cpuinfo
+        hz = cpuinfo.get_cpu_info().get("hz_advertised")
+        if hz and hz[0]:
+            return hz[0] / 1e9
+    except Exception:
+        pass
+    return 2.0
+
+
+class _LoopNestModel:
+    "The loops of a schedule with static bounds, and the accesses and arithmetic of its iteration logic"
+
+    def __init__(self, sched: "accera.Schedule"):
+        from .._lang_python import type_size_bytes
+
+        self.sched = sched
+        self.order = list(sched._indices)
+        self.entries = []
+        for index in self.order:
+            entry = sched._index_map[sched._resolve_index(index)]
+            if not all(isinstance(x, int) for x in entry.interval()):
+                raise ValueError("Plan analysis requires static loop bounds")
+            self.entries.append(entry)
+
+        # the nest index that each loop was split from
+        self.roots = []
+        for index in self.order:
+            while sched._index_map[index].parent is not None:
+                index = sched._index_map[index].parent
+            self.roots.append(index)
+
+        self.names = {}
+        for k, index in enumerate(self.order):
+            self.names[index] = index.name or f"{self.roots[k].name or 'index'}_{k}"
+
+        self.tracer = _Tracer()
+        for logic_fn in sched._nest.get_logic():
+            self.tracer.trace(logic_fn)
+
+        self.arrays: Dict[int, Array] = {}
+        self.reads, self.writes = set(), set()
+        for array, _, write in self.tracer.accesses:
+            self.arrays[id(array)] = array
+            (self.writes if write else self.reads).add(id(array))
+
+        n = len(self.order)
+        self.iterations_inside = [_product(e.num_iterations() for e in self.entries[k:]) for k in range(n)]
+        self.iterations_outside = [_product(e.num_iterations() for e in self.entries[:k]) for k in range(n)]
+        self._type_size_bytes = type_size_bytes
+
+    def array_name(self, array: Array) -> str:
+        return array.name or f"array{list(self.arrays).index(id(array))}"
+
+    def element_bytes(self, array: Array, element_type=None) -> int:
+        return self._type_size_bytes(element_type or array.element_type)
+
+    def directions(self, array: Array) -> int:
+        "1 if the array is only read or only written, 2 if it is both"
+        return (id(array) in self.reads) + (id(array) in self.writes)
+
+    def footprint(self, array: Array, depth: int) -> List[int]:
+        "The bounding box of the array elements accessed by one execution of the loop at `depth`"
+        # the span of each nest index within the region
+        spans = {}
+        for k in range(depth, len(self.order)):
+            spans[self.roots[k]] = spans.get(self.roots[k], 0) + (self.entries[k].num_iterations() - 1) * self.entries[k].step
+        shape = [_resolve(s) for s in array.shape]
+
+        extents = None
+        for a, exprs, _ in self.tracer.accesses:
+            if a is not array:
+                continue
+            access = []
+            for dim, expr in enumerate(exprs):
+                size = shape[dim] if dim < len(shape) and isinstance(shape[dim], int) else None
+                if isinstance(expr, _NonAffine):
+                    extent = size if any(spans.get(i, 0) for i in expr.coefficients) else 1
+                    extent = extent or 1
+                else:
+                    extent = sum(abs(c) * spans.get(i, 0) for i, c in expr.coefficients.items()) + 1
+                access.append(min(extent, size) if size else extent)
+            # several accesses to the same array (e.g. a stencil) widen the box
+            extents = access if extents is None else [max(a, b) for a, b in zip(extents, access)]
+        return extents or []
+
+    def footprint_bytes(self, array: Array, depth: int, element_type=None) -> int:
+        return _product(self.footprint(array, depth)) * self.element_bytes(array, element_type)
+
+    def inner_tile_depth(self) -> int:
+        "The depth of the outermost of the innermost run of inner split loops, or of the innermost loop"
+        depth = len(self.order) - 1
+        while depth > 0 and self.sched._index_map[self.order[depth - 1]].parent is not None:
+            depth -= 1
+        if self.sched._index_map[self.order[depth]].parent is None and depth < len(self.order) - 1:
+            depth = len(self.order) - 1
+        return depth
+
+    def dimensions_indexed_by(self, array: Array, index: LoopIndex) -> List[int]:
+        "The dimensions of the array whose index expressions depend on the loop"
+        root = self.roots[self.order.index(index)] if index in self.order else index
+        dims = set()
+        for a, exprs, _ in self.tracer.accesses:
+            if a is array:
+                dims.update(d for d, expr in enumerate(exprs) if expr.coefficients.get(root))
+        return sorted(dims)
+
+
+def _check_tile_conflicts(
+    model: _LoopNestModel, target: "accera.Target", array: Array, depth: int, layout, element_type=None
+) -> Optional[ConflictReport]:
+    "Checks the innermost tile of a cache of `array` at `depth` for conflict misses in the target's L1 cache"
+    if not target.cache_sizes:
+        return None
+    shape = model.footprint(array, depth)
+    region = [min(a, b) for a, b in zip(model.footprint(array, max(model.inner_tile_depth(), depth)), shape)]
+    if _product(region) > MAX_CONFLICT_CHECK_ELEMENTS:
+        return None
+    return check_conflicts(
+        layout,
+        shape,
+        target.cache_sizes[0] * 1024,
+        (target.cache_lines or [64])[0],
+        DEFAULT_ASSOCIATIVITY,
+        model.element_bytes(array, element_type),
+        region
+    )
+
+
+def _check_false_sharing(
+    model: _LoopNestModel, target: "accera.Target", indices: List[LoopIndex], policy: str, num_threads: int
+) -> List[FalseSharingReport]:
+    """Checks whether the thread partitions of the parallelized loops write to the same cache lines of an output.
+
+    Partitions are contiguous runs of iterations of the (collapsed) parallelized loops: the iterations divided
+    evenly among the threads with the static policy, and single iterations with the dynamic policy. The
+    lines written by the last iteration before each boundary are compared with those written by the first
+    iteration after it, assuming line-aligned arrays.
+    """
+    depths = [model.order.index(index) for index in indices if index in model.order]
+    if not depths:
+        return []
+    counts = [model.entries[k].num_iterations() for k in depths]
+    total = _product(counts)
+    threads = min(num_threads or 1, total)
+    if threads <= 1:
+        return []
+
+    if policy == "dynamic":
+        chunk = DYNAMIC_CHUNK_ITERATIONS
+        boundaries = range(chunk, total, chunk)[:MAX_FALSE_SHARING_BOUNDARIES]
+    else:
+        # as in OpenMP, the first (total % threads) partitions get one more iteration
+        chunk, extra = divmod(total, threads)
+        boundaries = [t * chunk + min(t, extra) for t in range(1, threads)][:MAX_FALSE_SHARING_BOUNDARIES]
+    line_bytes = (target.cache_lines or [64])[0]
+    innermost = max(depths)
+    parallel_roots = {model.roots[k] for k in depths}
+
+    def values_at(flat: int) -> Dict[LoopIndex, int]:
+        "The values of the nest indices at the start of iteration `flat` of the collapsed parallelized loops"
+        values = {}
+        for k, count in reversed(list(zip(depths, counts))):
+            flat, digit = divmod(flat, count)
+            values[model.roots[k]] = values.get(model.roots[k], 0) + digit * model.entries[k].step
+        return values
+
+    reports = []
+    for array in [model.arrays[a] for a in model.writes]:
+        layout = array._requested_layout
+        shape = [_resolve(s) for s in array.shape]
+        writes = [exprs for a, exprs, write in model.tracer.accesses if a is array and write]
+        if (
+            isinstance(layout, BlockedLayout) or not all(isinstance(s, int) for s in shape)
+            or any(isinstance(e, _NonAffine) for exprs in writes for e in exprs)
+            or not any(e.coefficients.get(r) for exprs in writes for e in exprs for r in parallel_roots)
+        ):
+            # arrays written by every partition are reductions rather than false sharing
+            continue
+
+        # the elements written by one iteration of the innermost parallelized loop, relative to its origin
+        region = model.footprint(array, innermost + 1)
+        if _product(region) > MAX_FALSE_SHARING_ELEMENTS:
+            continue
+        strides = dense_strides(layout, shape)
+        element_bytes = model.element_bytes(array)
+        relative = {sum(s * i for s, i in zip(strides, index)) * element_bytes for index in product(*[range(r) for r in region])}
+
+        def origin(flat: int) -> int:
+            values = values_at(flat)
+            return min(
+                sum(s * (e.constant + sum(c * values.get(i, 0) for i, c in e.coefficients.items())) for s, e in zip(strides, exprs))
+                for exprs in writes
+            ) * element_bytes
+
+        shared, checked = 0, {}
+        for boundary in boundaries:
+            before, after = origin(boundary - 1), origin(boundary)
+            key = (before % line_bytes, after - before)
+            if key not in checked:
+                lines_before = {(before + r) // line_bytes for r in relative}
+                checked[key] = any((after + r) // line_bytes in lines_before for r in relative)
+            shared += checked[key]
+
+        if shared:
+            step_bytes = origin(1) - origin(0) if counts[-1] > 1 else 0
+            aligned = line_bytes // math.gcd(line_bytes, step_bytes) if step_bytes > 0 else 0
+            reports.append(
+                FalseSharingReport(
+                    array=model.array_name(array),
+                    index=model.names[model.order[innermost]],
+                    policy=policy,
+                    chunk=chunk,
+                    boundaries=len(boundaries),
+                    shared_boundaries=shared,
+                    aligned_chunk=aligned
+                )
+            )
+    return reports
+
+
+def false_sharing_warning(report: FalseSharingReport) -> str:
+    advice = (
+        f", consider splitting {report.index} so that each parallel iteration covers a multiple of {report.aligned_chunk} "
+        "of its iterations" if report.aligned_chunk > 1 else ""
+    )
+    return f"False sharing: {report}{advice}"
+
+
+def check_false_sharing(plan: "accera.Plan", indices: List[LoopIndex], policy: str, num_threads: int) -> List[FalseSharingReport]:
+    "Checks a parallelize call of a plan with a resolved schedule for false sharing, see `_check_false_sharing`"
+    sched = plan._sched
+    if not hasattr(sched, "_nest"):
+        return []
+    try:
+        model = _LoopNestModel(sched)
+    except ValueError:
+        return []    # dynamic loop bounds
+    return _check_false_sharing(model, plan._target, indices, policy, num_threads)
+
+
+def analyze_plan(
+    plan: "accera.Plan",
+    parameters: dict = None,
+    memory_bandwidth_GBps: float = None,
+    peak_GFLOPs: float = None
+) -> PlanAnalysis:
+    _replay(plan, parameters)
+    target = plan._target
+    result = PlanAnalysis()
+
+    model = _LoopNestModel(plan._sched)
+    order, entries, names, tracer, arrays = model.order, model.entries, model.names, model.tracer, model.arrays
+    result.warnings += tracer.errors
+    result.flops_per_iteration = tracer.flops
+
+    array_name, element_bytes, footprint = model.array_name, model.element_bytes, model.footprint
+    iterations_inside, iterations_outside = model.iterations_inside, model.iterations_outside
+
+    attrs = _resolved_index_attrs(plan)
+    for k, index in enumerate(order):
+        footprints = {array_name(a): _product(footprint(a, k)) * element_bytes(a) for a in arrays.values()}
+        flops = tracer.flops * iterations_inside[k]
+        total = sum(footprints.values())
+        result.levels.append(
+            LoopLevelAnalysis(
+                index=names[index],
+                depth=k,
+                iterations=entries[k].num_iterations(),
+                step=entries[k].step,
+                attributes=attrs.get(index, []),
+                footprints=footprints,
+                flops=flops,
+                arithmetic_intensity=flops / total if total else 0.0
+            )
+        )
+
+    def fits_in(num_bytes: int) -> Optional[str]:
+        for level, size_KB in enumerate(target.cache_sizes or []):
+            if num_bytes <= size_KB * 1024:
+                return f"L{level + 1}"
+        return None
+
+    cached = set()
+    cached_arrays = []
+    deepest_cache = None
+    for cache in _resolved_caches(plan):
+        array = _base_array(cache["source"])
+        if not isinstance(array, Array) or id(array) not in arrays:
+            continue
+
+        if cache.get("index") in order:
+            depth = order.index(cache["index"])
+        elif cache.get("level"):
+            depth = len(order) - cache["level"]
+        elif cache.get("max_elements"):
+            # the outermost level whose active block fits the budget, as the lowering picks it
+            depth = next(
+                (k for k in range(len(order)) if _product(footprint(array, k)) <= cache["max_elements"]), len(order) - 1
+            )
+        else:
+            continue
+
+        trigger = cache.get("trigger_index")
+        if trigger in order:
+            trigger_depth = order.index(trigger)
+        elif cache.get("trigger_level"):
+            trigger_depth = len(order) - cache["trigger_level"]
+        else:
+            trigger_depth = depth
+
+        shape = footprint(array, depth)
+        elements = _product(shape)
+        element_type = cache.get("element_type") or array.element_type
+        num_bytes = elements * element_bytes(array, element_type)
+        fills = iterations_outside[trigger_depth]
+        directions = model.directions(array)
+
+        result.caches.append(
+            CacheAnalysis(
+                array=array_name(array),
+                index=names[order[depth]],
+                depth=depth,
+                shape=shape,
+                elements=elements,
+                bytes=num_bytes,
+                fills=fills,
+                bytes_packed=fills * num_bytes * max(directions, 1),
+                fits_in=fits_in(num_bytes),
+                layout=cache.get("layout") or array._requested_layout
+            )
+        )
+        cached.add(id(array))
+        cached_arrays.append(array)
+        deepest_cache = depth if deepest_cache is None else max(deepest_cache, depth)
+
+    # The innermost tile is the region of the deepest cache or, without caches, the loops that are all
+    # inner split loops (the ones that were created by splitting)
+    inner_tile_depth = model.inner_tile_depth()
+    result.tile_depth = deepest_cache if deepest_cache is not None else inner_tile_depth
+
+    # Conflict misses: the lines of the innermost tile that share an L1 set with more lines than it can hold
+    for c, array in zip(result.caches, cached_arrays):
+        if c.layout in (None, Layout.DEFERRED):
+            continue
+        report = _check_tile_conflicts(model, target, array, c.depth, c.layout)
+        if report:
+            c.conflicting_lines = report.conflicting_lines
+            if report.has_conflicts:
+                result.warnings.append(
+                    f"The innermost tile of the cache of {c.array} at {c.index} has conflict misses in L1 ({report}), "
+                    "consider pad_to_avoid_conflicts=True or a padded or swizzled layout"
+                )
+
+    # False sharing: thread partitions of the parallelized loops that write to the same lines
+    for indices, policy, max_threads in _resolved_parallelizations(plan):
+        target_threads = target.num_threads or os.cpu_count() or 1
+        num_threads = min(max_threads or target_threads, target_threads)
+        for report in _check_false_sharing(model, target, indices, policy, num_threads):
+            result.false_sharing.append(report)
+            result.warnings.append(false_sharing_warning(report))
+
+    # Roofline: cached arrays are read from memory once per cache fill, other arrays once per tile
+    tiles = iterations_outside[result.tile_depth]
+    memory_bytes = sum(c.bytes_packed for c in result.caches)
+    for array in arrays.values():
+        if id(array) not in cached:
+            directions = model.directions(array)
+            memory_bytes += tiles * _product(footprint(array, result.tile_depth)) * element_bytes(array) * directions
+    flops = tracer.flops * iterations_inside[0] if order else tracer.flops
+
+    if peak_GFLOPs is None:
+        element_sizes = [element_bytes(a) for a in arrays.values()] or [4]
+        vectorized = any("vectorized" in a for a in attrs.values())
+        lanes = max(target.vector_bytes // min(element_sizes), 1) if vectorized and target.vector_bytes else 1
+        threads = 1
+        parallel = [k for k, index in enumerate(order) if "parallelized" in attrs.get(index, [])]
+        if parallel:
+            cores = target.num_cores or os.cpu_count() or 1
+            threads = min(cores, _product(entries[k].num_iterations() for k in parallel))
+        peak_GFLOPs = _frequency_GHz(target) * lanes * 2 * threads    # 2 for fused multiply-add
+    bandwidth = memory_bandwidth_GBps or DEFAULT_MEMORY_BANDWIDTH_GBps
+
+    intensity = flops / memory_bytes if memory_bytes else float("inf")
+    attainable = min(peak_GFLOPs, intensity * bandwidth)
+    result.roofline = RooflineEstimate(
+        flops=flops,
+        memory_bytes=memory_bytes,
+        peak_GFLOPs=peak_GFLOPs,
+        memory_bandwidth_GBps=bandwidth,
+        arithmetic_intensity=intensity,
+        attainable_GFLOPs=attainable,
+        estimated_time_s=max(flops / (peak_GFLOPs * 1e9), memory_bytes / (bandwidth * 1e9)),
+        bound="compute" if intensity * bandwidth >= peak_GFLOPs else "memory"
+    )
+    if memory_bandwidth_GBps is None:
+        result.warnings.append(
+            f"Assuming {DEFAULT_MEMORY_BANDWIDTH_GBps} GB/s of memory bandwidth, pass memory_bandwidth_GBps for a better estimate"
+        )
+    return result
+
+
+# The share of a cache level that an automatically placed cache may fill, leaving room for the other operands
+AUTO_CACHE_FRACTION = 0.5
+
+
+def auto_cache_hierarchy(plan: "accera.Plan", array: Array,
+                         layout: Array.Layout = None) -> List[Tuple[LoopIndex, Array.Layout]]:
+    """Chooses where to place a chain of caches of `array`, one per level of the target's cache hierarchy.
+
+    For each of L3, L2 and L1 (as available), the cache is placed at the outermost loop whose active block fits in
+    `AUTO_CACHE_FRACTION` of that level, which maximizes the reuse of each copy. Levels whose placement wouldn't
+    shrink the active block of the next outer cache are skipped.
+
+    Unless a layout is given, the caches are laid out so that the dimension indexed by the vectorized loop (or,
+    without one, by the innermost loop) is contiguous.
+
+    Returns:
+        The (index, layout) of each cache, outermost first.
+    """
+    sched = plan._sched
+    if not hasattr(sched, "_nest"):
+        raise NotImplementedError("Automatic cache hierarchies are not supported for fused schedules")
+
+    model = _LoopNestModel(sched)
+    if id(array) not in model.arrays:
+        raise ValueError(f"{model.array_name(array)} isn't accessed by the iteration logic")
+
+    target = plan._target
+    cache_sizes = (target.cache_sizes or [])[:3]
+    if not cache_sizes:
+        raise ValueError(f"Target {target.name} has no cache size information")
+
+    depths = []
+    for level in reversed(range(len(cache_sizes))):
+        capacity = cache_sizes[level] * 1024 * AUTO_CACHE_FRACTION    # cache sizes are in KB
+        depth = next((k for k in range(len(model.order)) if model.footprint_bytes(array, k) <= capacity), None)
+        if depth is None:
+            continue
+        if depths and (
+            depth <= depths[-1] or model.footprint_bytes(array, depth) == model.footprint_bytes(array, depths[-1])
+        ):
+            continue
+        depths.append(depth)
+
+    if not depths:
+        raise ValueError(
+            f"No loop has an active block of {model.array_name(array)} that fits in the caches of target {target.name}"
+        )
+
+    if layout is None:
+        vectorized = [
+            index for index, attrs in _resolved_index_attrs(plan).items() if "vectorized" in attrs and index in model.order
+        ]
+        innermost = max(vectorized, key=model.order.index) if vectorized else model.order[-1]
+        dims = model.dimensions_indexed_by(array, innermost)
+        num_dims = len(array.shape)
+        if num_dims > 1 and dims == [num_dims - 1]:
+            layout = Array.Layout.FIRST_MAJOR
+        elif num_dims > 1 and dims == [0]:
+            layout = Array.Layout.LAST_MAJOR
+
+    return [(model.order[depth], layout) for depth in depths]
+
+
+def conflict_free_padding(
+    plan: "accera.Plan", array: Array, index: LoopIndex, layout: Union[Array.Layout, BlockedLayout], element_type=None
+) -> int:
+    """Chooses the padding of the leading dimension of a cache of `array` at `index` that removes the L1 conflict
+    misses of its innermost tile.
+
+    Paddings of whole cache lines are tried in increasing order, up to one line per set. Returns 0 if the unpadded
+    layout has no conflicts or no padding improves it, otherwise the smallest padding (in elements) with the fewest
+    conflicting lines.
+    """
+    sched = plan._sched
+    if not hasattr(sched, "_nest"):
+        raise NotImplementedError("Padding caches to avoid conflicts is not supported for fused schedules")
+
+    model = _LoopNestModel(sched)
+    if id(array) not in model.arrays:
+        raise ValueError(f"{model.array_name(array)} isn't accessed by the iteration logic")
+    if index not in model.order:
+        raise ValueError("Padding caches to avoid conflicts requires a cache index or level")
+
+    depth = model.order.index(index)
+    target = plan._target
+    rank = len(array.shape)
+    report = _check_tile_conflicts(model, target, array, depth, layout, element_type)
+    if rank < 2 or not report or not report.has_conflicts:
+        return 0
+
+    line_elements = max(((target.cache_lines or [64])[0]) // model.element_bytes(array, element_type), 1)
+    best, fewest = 0, report.conflicting_lines
+    for lines in range(1, report.num_sets + 1):
+        padding = lines * line_elements
+        conflicts = _check_tile_conflicts(
+            model, target, array, depth, pad_layout(layout, rank, padding), element_type
+        ).conflicting_lines
+        if conflicts < fewest:
+            best, fewest = padding, conflicts
+        if not conflicts:
+            break
+    return best
@@ -302,6 +302,29 @@ class Schedule:
 
         return split_indices
 
+    def interleave_batch(self, index: LoopIndex, lanes: int) -> LoopIndex:
+        """Vectorizes across the problems of a batch rather than within each problem. The batch dimension `index` is
+        split into groups of `lanes` problems, and the problems within a group are moved innermost:
+
+            bb = schedule.interleave_batch(b, 8)
+            plan = schedule.create_plan()
+            plan.vectorize(bb)
+
+        computes 8 problems at once, which fills the vector registers for batches of matrices that are too small to
+        vectorize individually. Lay out the arrays with `accera.batch_interleaved_layout` so that the vectorized
+        accesses are contiguous.
+
+        Args:
+            index: The batch dimension
+            lanes: The number of problems computed at once, usually the number of elements in a vector register
+
+        Returns:
+            The innermost dimension, to be vectorized
+        """
+        inner_index = self.split(index, lanes)
+        self.reorder([i for i in self._indices if i != inner_index] + [inner_index])
+        return inner_index
+
     def is_valid_loop_order(self, loop_order: Tuple[LoopIndex]) -> bool:
         """This method is used to validate the order of parent index and inner index, inner index should precede its parant index.
 
@@ -12,6 +12,7 @@ from .Nest import Nest
 from .Schedule import Schedule, FusedSchedule, fuse
 from .Plan import Plan
 from .Cache import Cache
+from .Layout import BlockedLayout, batch_interleaved_layout, check_conflicts
 from .Function import Function
 from .LogicFunction import logic_function, LogicFunction
 from .LoopIndex import LoopIndex
@@ -25,7 +25,7 @@ else:
     DEV_MODE = True
     sys.path.insert(1, os.getcwd())
 
-from accera import ScalarType, Array, Function, Nest, Target, Package, algorithms, cast, AllocateFlags, Role
+from accera import ScalarType, Array, Function, Nest, Target, Package, algorithms, cast, AllocateFlags, Role, BlockedLayout
 from accera.test import verifiers
 from accera.test.test_utils import expectedFailure, FailedReason, avx2_cpu, get_avx_platform
 from accera._lang_python._lang import Dimension, EnterProfileRegion, ExitProfileRegion, PrintProfileResults
@@ -918,6 +918,49 @@ class DSLTest_01Arrays(unittest.TestCase):
         function = package.add(nest, args=(N, A, B), base_name="test_runtimesizes_vector_add")
         self._verify_helper(package, test_name, function.name, correctness_check_values)
 
+    def test_runtimesizes_constrained_vector_add(self) -> None:
+        N = Dimension(name="N", multiple_of=16, max=4096)
+        self.assertEqual(N.multiple_of, 16)
+        self.assertEqual(N.max, 4096)
+        self.assertIsNone(N.min)
+
+        A = Array(shape=(N, ), element_type=ScalarType.float32, role=Role.INPUT)
+        B = Array(shape=(N, ), element_type=ScalarType.float32, role=Role.INPUT_OUTPUT)
+
+        nest = Nest((N, ))
+
+        i = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            B[i] += A[i]
+
+        # N is a multiple of the split size, so the boundary loop is provably empty
+        schedule = nest.create_schedule()
+        ii = schedule.split(i, 16)
+        plan = schedule.create_plan()
+        plan.vectorize(ii)
+
+        package = Package()
+
+        N_test = np.int64(256)
+        A_test = np.random.random((N_test, )).astype(np.float32)
+        B_test = np.random.random((N_test, )).astype(np.float32)
+        correctness_check_values = {
+            "pre": [N_test, A_test, B_test],
+            "post": [N_test, A_test, B_test + A_test],
+        }
+
+        test_name = "test_runtimesizes_constrained_vector_add"
+        function = package.add(plan, args=(N, A, B), base_name=test_name)
+        self._verify_helper(package, test_name, function.name, correctness_check_values)
+
+    def test_dimension_invalid_constraints(self) -> None:
+        with self.assertRaises(Exception):
+            Dimension(name="N", min=64, max=32)
+        with self.assertRaises(Exception):
+            Dimension(name="N", multiple_of=0)
+
     def _simple_runtimesize_loopnest_common(self, name, splits=[]) -> None:
         M = Dimension()
 
@@ -4232,6 +4275,44 @@ class DSLTest_06PlansCaching(unittest.TestCase):
                     after=correctness_check_values["post"],
                 )
 
+    def _create_matmul_schedule(self, size: int = 256) -> Tuple:
+        M = N = S = size
+
+        A = Array(role=Role.INPUT, shape=(M, S), name="A")
+        B = Array(role=Role.INPUT, shape=(S, N), name="B")
+        C = Array(role=Role.INPUT_OUTPUT, shape=(M, N), name="C")
+
+        nest = Nest(shape=(M, N, S))
+        i, j, k = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            C[i, j] += A[i, k] * B[k, j]
+
+        return nest.create_schedule(), (A, B, C), (i, j, k)
+
+    def _create_tiled_matmul_schedule(self) -> Tuple:
+        # 32x64x128 tiles of a 256^3 matmul, with the k tile outside the j tile
+        schedule, args, (i, j, k) = self._create_matmul_schedule()
+        ii = schedule.split(i, 32)
+        jj = schedule.split(j, 64)
+        kk = schedule.split(k, 128)
+        schedule.reorder(i, j, k, ii, kk, jj)
+
+        return schedule, args, (i, j, k, ii, jj, kk)
+
+    def _verify_matmul_plan(self, plan, args: Tuple[Array], package_name) -> None:
+        A, B, C = args
+        A_test = np.random.random(A.shape).astype(np.float32)
+        B_test = np.random.random(B.shape).astype(np.float32)
+        C_test = np.random.random(C.shape).astype(np.float32)
+        correctness_check_values = {
+            "pre": [A_test, B_test, C_test],
+            "post": [A_test, B_test, C_test + A_test @ B_test],
+        }
+
+        self._verify_plan(plan, list(args), package_name, correctness_check_values=correctness_check_values)
+
     def test_caching_by_level(self) -> None:
         plan, args, indices = self._create_plan((16, 10, 11))
         A, B, C = args
@@ -4424,6 +4505,110 @@ class DSLTest_06PlansCaching(unittest.TestCase):
             correctness_check_values=correctness_check_values,
         )
 
+    def test_plan_analysis(self) -> None:
+        schedule, (A, B, C), (i, j, k, ii, jj, kk) = self._create_tiled_matmul_schedule()
+
+        target = Target(category=Target.Category.CPU, cache_sizes=[32, 1024], vector_bytes=32, frequency_GHz=3.0)
+        plan = schedule.create_plan(target)
+        plan.cache(B, index=ii)
+        plan.cache(C, index=ii)
+        plan.vectorize(jj)
+
+        analysis = plan.analyze(memory_bandwidth_GBps=20)
+        self.assertEqual(analysis.flops_per_iteration, 2)
+        self.assertEqual(analysis.tile_depth, 3)
+
+        BB, CC = analysis.caches
+        self.assertEqual(BB.shape, [128, 64])
+        self.assertEqual(BB.bytes, 128 * 64 * 4)
+        self.assertEqual(BB.fits_in, "L1")
+        self.assertEqual(BB.fills, 8 * 4 * 2)
+        self.assertEqual(CC.shape, [32, 64])
+        self.assertEqual(CC.bytes_packed, 64 * 32 * 64 * 4 * 2)    # C is copied in and out
+
+        # the whole nest touches all of A, B and C once
+        self.assertEqual(sum(analysis.levels[0].footprints.values()), 3 * 256 * 256 * 4)
+        self.assertEqual(analysis.levels[4].footprints, {"A": 128 * 4, "B": 128 * 64 * 4, "C": 64 * 4})
+
+        roofline = analysis.roofline
+        self.assertEqual(roofline.flops, 2 * 256 * 256 * 256)
+        # cached B and C, plus one 32x128 block of A per tile
+        self.assertEqual(roofline.memory_bytes, 2097152 + 1048576 + 64 * 32 * 128 * 4)
+        self.assertEqual(roofline.peak_GFLOPs, 3.0 * 8 * 2)
+        self.assertEqual(roofline.bound, "compute")
+
+    def test_caching_hierarchy_auto(self) -> None:
+        schedule, (A, B, C), (i, j, k) = self._create_matmul_schedule()
+        jj = schedule.split(j, 64)
+        kk = schedule.split(k, 128)
+        jjj = schedule.split(jj, 8)
+        ii = schedule.split(i, 4)
+        schedule.reorder(j, k, i, jj, kk, ii, jjj)
+
+        target = Target(category=Target.Category.CPU, cache_sizes=[32, 256, 2048], vector_bytes=32)
+        plan = schedule.create_plan(target)
+        plan.vectorize(jjj)
+
+        with self.assertRaises(ValueError):
+            plan.cache(B, hierarchy="auto", level=2)
+
+        BBB = plan.cache(B, hierarchy="auto")
+
+        # L3: all of B (256 KB) fits in half of 2 MB. L2: a 256x64 panel (64 KB) at k.
+        # L1: a 128x8 micro-panel (4 KB) at kk, contiguous along the vectorized dimension.
+        BB = BBB.target
+        self.assertEqual(BBB.index, kk)
+        self.assertEqual(BB.index, k)
+        self.assertEqual(BB.target.index, j)
+        self.assertEqual(BB.target.target, B)
+        self.assertEqual(BBB.layout, Array.Layout.FIRST_MAJOR)
+
+        self._verify_matmul_plan(plan, (A, B, C), "test_caching_hierarchy_auto")
+
+    def test_caching_blocked_layouts(self) -> None:
+        schedule, (A, B, C), (i, j, k, ii, jj, kk) = self._create_tiled_matmul_schedule()
+
+        target = Target(category=Target.Category.CPU, cache_sizes=[32, 1024], cache_lines=[64, 64], vector_bytes=32)
+
+        # Walking down the 1 KB rows of a row-major copy of B maps the 128x64 tile to 16 of the 64 L1 sets
+        unpadded_plan = schedule.create_plan(target)
+        unpadded_plan.cache(B, index=i, layout=Array.Layout.FIRST_MAJOR)
+        unpadded_analysis = unpadded_plan.analyze(memory_bandwidth_GBps=20)
+        self.assertGreater(unpadded_analysis.caches[0].conflicting_lines, 0)
+
+        with self.assertRaises(ValueError):
+            unpadded_plan.cache(A, index=j, layout=BlockedLayout.blocked(8, 8, 8))
+
+        plan = schedule.create_plan(target)
+        plan.cache(A, index=j, layout=BlockedLayout.panels(2, 0, 4))
+        plan.cache(B, index=i, layout=BlockedLayout.padded(2, 16))
+        plan.cache(C, index=k, layout=BlockedLayout.swizzled(2))
+
+        analysis = plan.analyze(memory_bandwidth_GBps=20)
+        self.assertEqual([c.conflicting_lines for c in analysis.caches], [0, 0, 0])
+
+        self._verify_matmul_plan(plan, (A, B, C), "test_caching_blocked_layouts")
+
+    def test_caching_pad_to_avoid_conflicts(self) -> None:
+        schedule, (A, B, C), (i, j, k, ii, jj, kk) = self._create_tiled_matmul_schedule()
+
+        target = Target(category=Target.Category.CPU, cache_sizes=[32, 1024], cache_lines=[64, 64], vector_bytes=32)
+        plan = schedule.create_plan(target)
+
+        with self.assertRaises(ValueError):
+            plan.cache(A, max_elements=1024, pad_to_avoid_conflicts=True)
+
+        # The 1 KB rows of B are padded by one 64-byte line, the 32x256 block of A walked along its rows is left alone
+        AA = plan.cache(A, index=j, pad_to_avoid_conflicts=True)
+        BB = plan.cache(B, index=i, pad_to_avoid_conflicts=True)
+        self.assertEqual(AA.layout, Array.Layout.FIRST_MAJOR)
+        self.assertEqual(BB.layout, BlockedLayout.padded(2, 16))
+
+        analysis = plan.analyze(memory_bandwidth_GBps=20)
+        self.assertEqual([c.conflicting_lines for c in analysis.caches], [0, 0])
+
+        self._verify_matmul_plan(plan, (A, B, C), "test_caching_pad_to_avoid_conflicts")
+
 
 class DSLTest_07PlansVectorizationParallelization(unittest.TestCase):
 
@@ -4758,6 +4943,140 @@ class DSLTest_07PlansVectorizationParallelization(unittest.TestCase):
             # fully collapsed will result in correctness issues because parallelizing k can stomp on the C matrix
             # where multiple threads try to update C[i, j] for different values of k
 
+    def test_parallelize_false_sharing(self) -> None:
+        # rows of 20 floats (80 bytes) don't line up with 64-byte cache lines
+        A = Array(role=Role.INPUT, shape=(64, 20), name="A")
+        B = Array(role=Role.INPUT_OUTPUT, shape=(64, 20), name="B")
+
+        nest = Nest(shape=(64, 20))
+        i, j = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            B[i, j] += A[i, j]
+
+        target = Target(category=Target.Category.CPU, num_threads=4, cache_sizes=[32], cache_lines=[64])
+
+        schedule = nest.create_schedule()
+        plan = schedule.create_plan(target)
+        plan.parallelize(indices=i, policy="dynamic")
+
+        analysis = plan.analyze(memory_bandwidth_GBps=20)
+        report, = analysis.false_sharing
+        self.assertEqual(report.array, "B")
+        self.assertEqual(report.boundaries, 63)
+        self.assertEqual(report.shared_boundaries, 63 - 63 // 4)    # every 4th row (320 bytes) starts a line
+        self.assertEqual(report.aligned_chunk, 4)
+
+        # static partitions of 16 rows are line-aligned
+        plan = schedule.create_plan(target)
+        plan.parallelize(indices=i)
+        self.assertEqual(plan.analyze(memory_bandwidth_GBps=20).false_sharing, [])
+
+        # and so are dynamic partitions of 4 rows
+        schedule = nest.create_schedule()
+        ii = schedule.split(i, 4)
+        plan = schedule.create_plan(target)
+        plan.parallelize(indices=i, policy="dynamic")
+        self.assertEqual(plan.analyze(memory_bandwidth_GBps=20).false_sharing, [])
+
+    def test_parallelize_atomic_histogram(self) -> None:
+        from accera import atomic_add
+
+        A = Array(role=Role.INPUT, element_type=ScalarType.int32, shape=(64, 1024))
+        H = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.int32, shape=(256, ))
+
+        nest = Nest(shape=(64, 1024))
+        i, j = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            atomic_add(H[A[i, j]], 1)
+
+        target = Target("HOST", num_threads=4)
+
+        # disable correctness checking on windows because the
+        # install location of libomp.dll is non-standard as of now
+        if sys.platform.startswith("win"):
+            correctness_check_values = None
+        else:
+            A_test = np.random.randint(0, H.shape[0], A.shape).astype(np.int32)
+            H_test = np.random.randint(0, 10, H.shape).astype(np.int32)
+            correctness_check_values = {
+                "pre": [A_test, H_test],
+                "post": [A_test, H_test + np.bincount(A_test.ravel(), minlength=H.shape[0]).astype(np.int32)],
+            }
+
+        # each row updates the 256 bins 1024 times, so the bins are privatized per row and merged atomically
+        schedule = nest.create_schedule()
+        plan = schedule.create_plan(target)
+        plan.parallelize(indices=i)
+        self._verify_plan(
+            plan,
+            [A, H],
+            "test_parallelize_atomic_histogram",
+            correctness_check_values,
+            check_parallelization=True
+        )
+
+    def test_vectorize_batch_interleaved(self) -> None:
+        from accera import batch_interleaved_layout
+
+        batch, M, N, K = 64, 4, 4, 4
+        A = Array(role=Role.INPUT, shape=(batch, M, K), layout=batch_interleaved_layout((batch, M, K)))
+        B = Array(role=Role.INPUT, shape=(batch, K, N), layout=batch_interleaved_layout((batch, K, N)))
+        C = Array(role=Role.INPUT_OUTPUT, shape=(batch, M, N), layout=batch_interleaved_layout((batch, M, N)))
+        self.assertEqual(A.requested_layout, (1, K * batch, batch))
+
+        nest = Nest(shape=(batch, M, N, K))
+        b, i, j, k = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            C[b, i, j] += A[b, i, k] * B[b, k, j]
+
+        target = Target(category=Target.Category.CPU, vector_bytes=32, vector_registers=16)
+
+        # 8 matrices are multiplied at once, one per lane
+        schedule = nest.create_schedule()
+        bb = schedule.interleave_batch(b, 8)
+        self.assertEqual(schedule.get_indices()[-1], bb)
+
+        plan = schedule.create_plan(target)
+        plan.vectorize(bb)
+
+        def interleaved(x):
+            # a view of x in logical order, whose memory holds the batch innermost
+            return np.moveaxis(np.ascontiguousarray(np.moveaxis(x, 0, -1)), -1, 0)
+
+        A_test = np.random.random(A.shape).astype(np.float32)
+        B_test = np.random.random(B.shape).astype(np.float32)
+        C_test = np.random.random(C.shape).astype(np.float32)
+
+        package = Package()
+        function = package.add(plan, args=(A, B, C), base_name="batch_interleaved_gemm")
+        pack, unpack = package.add_batch_interleave_helpers(C, base_name="batch_interleaved_C")
+
+        package_name = "test_vectorize_batch_interleaved"
+        output_dir = pathlib.Path(TEST_PACKAGE_DIR) / package_name
+        with verifiers.VerifyPackage(self, package_name, output_dir) as v:
+            package.build(package_name, format=TEST_FORMAT, mode=Package.Mode.RELEASE, output_dir=output_dir)
+            v.check_correctness(
+                function.name,
+                before=[interleaved(A_test), interleaved(B_test), interleaved(C_test)],
+                after=[interleaved(A_test), interleaved(B_test), interleaved(C_test + A_test @ B_test)]
+            )
+            v.check_correctness(
+                pack.name,
+                before=[C_test, interleaved(np.zeros_like(C_test))],
+                after=[C_test, interleaved(C_test)]
+            )
+            v.check_correctness(
+                unpack.name,
+                before=[interleaved(C_test), np.zeros_like(C_test)],
+                after=[interleaved(C_test), C_test]
+            )
+
 
 class DSLTest_08DeferredLayout(unittest.TestCase):
 
@@ -5471,6 +5790,72 @@ class DSLTest_09Parameters(unittest.TestCase):
                 output_dir=TEST_PACKAGE_DIR,
             )
 
+    def test_parameterization_grid_constraints(self) -> None:
+        from accera import create_parameter_grid, create_parameters, Nest, Target
+        from accera.Constraints import at_most, divisible, fits_in_cache, vector_width_divides
+
+        M, N, K = 64, 64, 64
+        A = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(M, K))
+        B = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(K, N))
+        C = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(M, N))
+
+        nest = Nest(shape=(M, N, K))
+        i, j, k = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            C[i, j] += A[i, k] * B[k, j]
+
+        P0, P1, P2 = create_parameters()
+        schedule = nest.create_schedule()
+        ii = schedule.split(i, P0)
+        jj = schedule.split(j, P1)
+        kk = schedule.split(k, P2)
+        schedule.reorder(i, j, k, ii, kk, jj)
+
+        target = Target(category=Target.Category.CPU, vector_bytes=32, cache_sizes=[32, 1024])
+        plan = schedule.create_plan(target)
+
+        constraints = [
+            at_most(P0, M),
+            divisible(M, P0),
+            vector_width_divides(P1, target),
+            fits_in_cache(P0 * P2 + P2 * P1 + P0 * P1, target, level=1),
+        ]
+        parameters = create_parameter_grid({
+            P0: [4, 16, 48, 128],
+            P1: [4, 8, 16, 32],
+            P2: [16, 64, 256],
+        }, filter_func=constraints, report=True)
+
+        # P0 = 128 is larger than M, P0 = 48 doesn't divide M, P1 = 4 is narrower than 8 floats,
+        # and P0 * P2 + P2 * P1 + P0 * P1 floats must fit in 32KB
+        self.assertEqual([c.num_rejected for c in constraints], [12, 12, 6, 3])
+        self.assertEqual(len(parameters), 48 - 33)
+        for p in parameters:
+            self.assertLessEqual((p[P0] * p[P2] + p[P2] * p[P1] + p[P0] * p[P1]) * 4, 32 * 1024)
+            self.assertEqual(p[P1] % 8, 0)
+
+        # Constraints and plain filter functions can be mixed
+        parameters = create_parameter_grid({
+            P0: [4, 16, 48, 128],
+            P1: [4, 8, 16, 32],
+            P2: [16, 64, 256],
+        }, filter_func=constraints + [lambda p: p[2] <= 64])
+        self.assertEqual(len(parameters), 12)
+
+        package = Package()
+        package_name = "test_parameterization_grid_constraints"
+        package.add(plan, args=(A, B, C), parameters=parameters, base_name="matmul")
+
+        with verifiers.VerifyPackage(self, package_name, TEST_PACKAGE_DIR):
+            package.build(
+                name=package_name,
+                format=TEST_FORMAT,
+                mode=_get_test_mode(),
+                output_dir=TEST_PACKAGE_DIR,
+            )
+
     def test_fusion_parameterization_1(self) -> None:
         from accera import create_parameters, Nest, fuse
 
@@ -6152,6 +6537,103 @@ class DSLTest_10Packages(unittest.TestCase):
             except Exception as e:
                 print(e)
 
+    def test_debug_mode_sampled(self) -> None:
+        M = N = K = 256
+        A = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(M, K))
+        B = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(K, N))
+        C = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(M, N))
+
+        nest = Nest(shape=(M, N, K))
+        i, j, k = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            C[i, j] += A[i, k] * B[k, j]
+
+        schedule = nest.create_schedule()
+
+        ii = schedule.split(i, 4)
+        schedule.reorder(i, k, j, ii)
+        plan = schedule.create_plan()
+        plan.unroll(ii)
+
+        package = Package()
+        package_name = "MySampledDebugPackage"
+        function = package.add(plan, args=(A, B, C), base_name="func1")
+        output_dir = pathlib.Path(TEST_PACKAGE_DIR) / package_name
+
+        with verifiers.VerifyPackage(self, package_name, output_dir) as v:
+            package.build(
+                package_name,
+                format=TEST_FORMAT,
+                output_dir=output_dir,
+                mode=Package.Mode.DEBUG,
+                tolerance=1e-3,
+                verification_samples=64,
+            )
+
+            A_test = np.random.random(A.shape).astype(np.float32)
+            B_test = np.random.random(B.shape).astype(np.float32)
+            C_test = np.random.random(C.shape).astype(np.float32)
+
+            v.check_correctness(
+                function.name,
+                before=[A_test, B_test, C_test],
+                after=[A_test, B_test, C_test + A_test @ B_test],
+                tolerance=1e-3,
+            )
+
+    def test_debug_mode_reference_plan(self) -> None:
+        M = N = K = 64
+        A = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(M, K))
+        B = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(K, N))
+        C = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(M, N))
+
+        nest = Nest(shape=(M, N, K))
+        i, j, k = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            C[i, j] += A[i, k] * B[k, j]
+
+        # The checked plan is sequential and scalar, so the parallel and vector code
+        # in the debug function comes from the reference implementation
+        schedule = nest.create_schedule()
+        ii = schedule.split(i, 4)
+        schedule.reorder(i, k, j, ii)
+        plan = schedule.create_plan(Target("HOST", num_threads=4))
+        plan.unroll(ii)
+
+        package = Package()
+        package_name = "MyDebugPackageReferencePlan"
+        function = package.add(plan, args=(A, B, C), base_name="func1")
+        output_dir = pathlib.Path(TEST_PACKAGE_DIR) / package_name
+
+        with verifiers.VerifyPackage(self, package_name, output_dir) as v:
+            package.build(
+                package_name,
+                format=TEST_FORMAT,
+                output_dir=output_dir,
+                mode=Package.Mode.DEBUG,
+                tolerance=1e-5,
+            )
+
+            checker = v.file_checker(f"{package_name}_llvm.mlir")
+            checker.check(f"@_debug_{function.name}_internal(")
+            checker.check("omp.parallel")
+            checker.check("vector<")
+            checker.run()
+
+            A_test = np.random.random(A.shape).astype(np.float32)
+            B_test = np.random.random(B.shape).astype(np.float32)
+            C_test = np.random.random(C.shape).astype(np.float32)
+
+            v.check_correctness(
+                function.name,
+                before=[A_test, B_test, C_test],
+                after=[A_test, B_test, C_test + A_test @ B_test],
+            )
+
     def test_debug_mode_fusion_1(self) -> None:
         from accera import fuse
 
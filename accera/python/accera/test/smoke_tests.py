@@ -1200,6 +1200,44 @@ class SmokeTest(unittest.TestCase):
         with verifiers.VerifyPackage(self, package_name, TEST_PACKAGE_DIR):
             package.build(package_name, format=self.PACKAGE_FORMAT, mode=self.PACKAGE_MODE, output_dir=TEST_PACKAGE_DIR)
 
+    def test_block_sparse_mlas_matmul(self) -> None:
+        from accera.samples.BlockSparseMatrixMultiplication import BlockSparseMLAS
+
+        package = Package()
+        M, N, K = [31, 64, 96]
+        block_rows, block_cols = 1, 8
+
+        # Keep about a tenth of the 1x8 blocks of the weights, and about half of them in a denser variant
+        # whose blocks are too many to be unrolled
+        rng = np.random.default_rng(seed=0)
+        functions = []
+        for density in [0.1, 0.5]:
+            block_mask = rng.random((K // block_rows, N // block_cols)) < density
+            block_mask[0, 0] = True
+            mask = np.kron(block_mask, np.ones((block_rows, block_cols), dtype=bool))
+            W_data = np.where(mask, rng.random((K, N)), 0).astype(np.float32)
+
+            A = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(M, K))
+            C = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(M, N))
+            function = package.add(
+                *BlockSparseMLAS(A, C, W_data), base_name=f"block_sparse_mlas_{M}_{N}_{K}_{int(density * 100)}"
+            )
+            functions.append((function, W_data))
+
+        package_name = "block_sparse_mlas"
+        output_dir = pathlib.Path(TEST_PACKAGE_DIR) / package_name
+        shutil.rmtree(output_dir, ignore_errors=True)
+        with verifiers.VerifyPackage(self, package_name, output_dir) as v:
+            package.build(package_name, output_dir=output_dir, mode=self.PACKAGE_MODE, format=self.PACKAGE_FORMAT)
+
+            # check build and correctness
+            if avx2_cpu():
+                for function, W_data in functions:
+                    A_test = np.random.random((M, K)).astype(np.float32)
+                    C_test = np.random.random((M, N)).astype(np.float32)
+                    C_ref = C_test + A_test @ W_data
+                    v.check_correctness(function.name, before=(A_test, C_test), after=(A_test, C_ref))
+
     def test_const_array_shared_across_functions(self) -> None:
         # In this scenario we use a single CONST data matrix in two Accera functions,
         # the first will perform matmul and the second will perform elementwise add
@@ -2894,6 +2932,346 @@ class SmokeTest(unittest.TestCase):
         with verifiers.VerifyPackage(self, package_name, output_dir):
             package.build(name=package_name, format=self.PACKAGE_FORMAT, mode=self.PACKAGE_MODE, output_dir=output_dir)
 
+    def test_workspace_allocator(self) -> None:
+        import ctypes
+        from hatlib import HATFile, HATPackage
+
+        M, N = create_dimensions()
+
+        A = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(M, N))
+        # Runtime-sized temporaries are heap-allocated, which is what the workspace allocator serves
+        B = Array(role=Role.TEMP, element_type=ScalarType.float32, shape=(M, N))
+        C = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(N, M))
+
+        nest = Nest(shape=(M, N))
+        i, j = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            B[i, j] = A[i, j]
+            C[j, i] = B[i, j]
+
+        package = Package()
+        function = package.add(nest, args=(M, N, A, C), base_name="test_workspace_allocator")
+
+        # A statically-sized heap temporary, whose workspace size doesn't depend on any argument
+        M_static, N_static = 16, 24
+        A_static = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(M_static, N_static))
+        B_static = Array(
+            role=Role.TEMP, element_type=ScalarType.float32, shape=(M_static, N_static), flags=AllocateFlags.HEAP
+        )
+        C_static = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(N_static, M_static))
+
+        static_nest = Nest(shape=(M_static, N_static))
+        i, j = static_nest.get_indices()
+
+        @static_nest.iteration_logic
+        def _():
+            B_static[i, j] = A_static[i, j]
+            C_static[j, i] = B_static[i, j]
+
+        static_function = package.add(static_nest, args=(A_static, C_static), base_name="test_workspace_allocator_static")
+
+        # Each heap block is the allocation rounded up to 64 bytes, plus a 64-byte header
+        def workspace_block_size(size_in_bytes):
+            return (size_in_bytes + 2 * 64 - 1) // 64 * 64
+
+        package_name = "test_workspace_allocator"
+        output_dir = pathlib.Path(TEST_PACKAGE_DIR) / package_name
+        shutil.rmtree(output_dir, ignore_errors=True)
+
+        with verifiers.VerifyPackage(self, package_name, output_dir) as v:
+            package.build(
+                name=package_name,
+                format=self.PACKAGE_FORMAT,
+                mode=self.PACKAGE_MODE,
+                output_dir=output_dir,
+                _opts=Package._Options.WORKSPACE_ALLOCATOR
+            )
+
+            checker = v.file_checker(f"{package_name}_llvm.mlir")
+            checker.check("llvm.call @__accera_workspace_alloc(")
+            checker.check("llvm.call @__accera_workspace_free(")
+            checker.check(f"llvm.func @{function.name}_workspace_size(")
+            checker.check(f"llvm.func @{package_name}_SetWorkspace(")
+            checker.check("thread_local @__accera_workspace_offset(")
+            checker.run()
+
+            checker = v.file_checker(f"{package_name}.hat")
+            checker.check(f"void {package_name}_SetWorkspace(void* buffer, uintptr_t size);")
+            checker.check(f"int64_t {function.name}_workspace_size(")
+            checker.run()
+
+            hat_package = HATPackage(output_dir / f"{package_name}.hat")
+            hat_function = next(fn for fn in hat_package.get_functions() if fn.name == function.name)
+            workspace = hat_function.auxiliary["accera"]["workspace"]
+            self.assertEqual(workspace["static_size"], 0)
+            self.assertTrue(workspace["runtime_sized"])
+            self.assertEqual(workspace["size_function"], f"{function.name}_workspace_size")
+            self.assertEqual(workspace["set_function"], f"{package_name}_SetWorkspace")
+
+            # Register a workspace sized for the call, filled with a sentinel so that its use can be observed
+            M_test, N_test = 48, 40
+            link_target = HATFile.Deserialize(output_dir / f"{package_name}.hat").dependencies.link_target
+            library = ctypes.CDLL(str(output_dir / link_target))
+            size_fn = getattr(library, workspace["size_function"])
+            size_fn.restype = ctypes.c_int64
+            size_fn.argtypes = [ctypes.c_int64, ctypes.c_int64]
+            workspace_size = size_fn(M_test, N_test)
+            self.assertEqual(workspace_size, workspace_block_size(M_test * N_test * 4))
+            self.assertEqual(size_fn(N_test, M_test), workspace_size)
+            self.assertEqual(size_fn(2 * M_test, N_test), workspace_block_size(2 * M_test * N_test * 4))
+
+            workspace_buffer = np.full(workspace_size, 0xCD, dtype=np.uint8)
+            set_workspace = getattr(library, workspace["set_function"])
+            set_workspace.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+            set_workspace(workspace_buffer.ctypes.data, workspace_size)
+            try:
+                A_test = np.random.rand(M_test, N_test).astype(np.float32)
+                C_test = np.random.rand(N_test, M_test).astype(np.float32)
+                v.check_correctness(function.name, before=(A_test, C_test), after=(A_test, A_test.T))
+            finally:
+                set_workspace(None, 0)
+
+            # The temporary was served from the workspace rather than the heap
+            self.assertTrue(np.any(workspace_buffer != 0xCD))
+
+            # The static size is known ahead of time and reported by the size function as well
+            static_hat_function = next(fn for fn in hat_package.get_functions() if fn.name == static_function.name)
+            static_workspace = static_hat_function.auxiliary["accera"]["workspace"]
+            static_size = workspace_block_size(M_static * N_static * 4)
+            self.assertEqual(static_workspace["static_size"], static_size)
+            self.assertFalse(static_workspace["runtime_sized"])
+
+            static_size_fn = getattr(library, static_workspace["size_function"])
+            static_size_fn.restype = ctypes.c_int64
+            static_size_fn.argtypes = []
+            self.assertEqual(static_size_fn(), static_size)
+
+            A_static_test = np.random.rand(M_static, N_static).astype(np.float32)
+            C_static_test = np.random.rand(N_static, M_static).astype(np.float32)
+            v.check_correctness(
+                static_function.name, before=(A_static_test, C_static_test), after=(A_static_test, A_static_test.T)
+            )
+
+            # A second package loaded into the same process exports its own setter, and each package's functions
+            # allocate from the workspace registered with their own package
+            other_package = Package()
+            other_function = other_package.add(nest, args=(M, N, A, C), base_name="test_workspace_allocator_other")
+
+            other_package_name = "test_workspace_allocator_other"
+            other_output_dir = pathlib.Path(TEST_PACKAGE_DIR) / other_package_name
+            shutil.rmtree(other_output_dir, ignore_errors=True)
+
+            with verifiers.VerifyPackage(self, other_package_name, other_output_dir) as other_v:
+                other_package.build(
+                    name=other_package_name,
+                    format=self.PACKAGE_FORMAT,
+                    mode=self.PACKAGE_MODE,
+                    output_dir=other_output_dir,
+                    _opts=Package._Options.WORKSPACE_ALLOCATOR
+                )
+
+                other_hat_package = HATPackage(other_output_dir / f"{other_package_name}.hat")
+                other_hat_function = next(
+                    fn for fn in other_hat_package.get_functions() if fn.name == other_function.name
+                )
+                other_workspace = other_hat_function.auxiliary["accera"]["workspace"]
+                self.assertEqual(other_workspace["set_function"], f"{other_package_name}_SetWorkspace")
+
+                other_link_target = HATFile.Deserialize(other_output_dir / f"{other_package_name}.hat"
+                                                        ).dependencies.link_target
+                other_library = ctypes.CDLL(str(other_output_dir / other_link_target))
+                self.assertFalse(hasattr(other_library, workspace["set_function"]))
+                other_set_workspace = getattr(other_library, other_workspace["set_function"])
+                other_set_workspace.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+
+                workspace_buffer = np.full(workspace_size, 0xCD, dtype=np.uint8)
+                other_workspace_buffer = np.full(workspace_size, 0xCD, dtype=np.uint8)
+                set_workspace(workspace_buffer.ctypes.data, workspace_size)
+                other_set_workspace(other_workspace_buffer.ctypes.data, workspace_size)
+                try:
+                    other_v.check_correctness(other_function.name, before=(A_test, C_test), after=(A_test, A_test.T))
+                    self.assertTrue(np.any(other_workspace_buffer != 0xCD))
+                    self.assertTrue(np.all(workspace_buffer == 0xCD))
+
+                    v.check_correctness(function.name, before=(A_test, C_test), after=(A_test, A_test.T))
+                    self.assertTrue(np.any(workspace_buffer != 0xCD))
+                finally:
+                    set_workspace(None, 0)
+                    other_set_workspace(None, 0)
+
+    def test_streaming_driver(self) -> None:
+        import ctypes
+        from hatlib import HATFile, HATPackage
+
+        N = create_dimensions()
+        K = 64
+
+        A = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(N, K))
+        W = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(K, ))
+        S = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(N, ))
+
+        nest = Nest(shape=(N, K))
+        i, k = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            S[i] += A[i, k] * W[k]
+
+        package = Package()
+        function = package.add(
+            nest, args=(N, A, W, S), base_name="test_streaming_driver", function_opts={"streaming": (N, 256)}
+        )
+
+        # Only arrays whose outermost dimension is the streaming dimension can be streamed
+        with self.assertRaises(ValueError):
+            AT = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(K, N))
+            package.add(nest, args=(N, AT, S), function_opts={"streaming": (N, 256)})
+
+        package_name = "test_streaming_driver"
+        output_dir = pathlib.Path(TEST_PACKAGE_DIR) / package_name
+        shutil.rmtree(output_dir, ignore_errors=True)
+
+        with verifiers.VerifyPackage(self, package_name, output_dir) as v:
+            package.build(name=package_name, format=self.PACKAGE_FORMAT, mode=self.PACKAGE_MODE, output_dir=output_dir)
+
+            checker = v.file_checker(f"{package_name}_llvm.mlir")
+            checker.check(f"llvm.func @{function.name}_stream(")
+            if sys.platform == 'linux':
+                checker.check('llvm.call @madvise(')
+            checker.check(f"llvm.call @{function.name}(")
+            checker.run()
+
+            checker = v.file_checker(f"{package_name}.hat")
+            checker.check(f"void {function.name}_stream(")
+            checker.run()
+
+        hat_package = HATPackage(output_dir / f"{package_name}.hat")
+        hat_function = next(fn for fn in hat_package.get_functions() if fn.name == function.name)
+        streaming = hat_function.auxiliary["accera"]["streaming"]
+        self.assertEqual(streaming["driver"], f"{function.name}_stream")
+        self.assertEqual(streaming["tile_size"], 256)
+
+        # Stream a row count that the tile size doesn't divide, so that the last tile is partial
+        link_target = HATFile.Deserialize(output_dir / f"{package_name}.hat").dependencies.link_target
+        library = ctypes.CDLL(str(output_dir / link_target))
+        N_test = 3 * 256 + 100
+        A_test = np.random.random((N_test, K)).astype(np.float32)
+        W_test = np.random.random((K, )).astype(np.float32)
+        S_test = np.random.random((N_test, )).astype(np.float32)
+
+        results = {}
+        for fn_name in (function.name, streaming["driver"]):
+            fn = getattr(library, fn_name)
+            fn.restype = None
+            fn.argtypes = [ctypes.c_int64, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p]
+            S_result = S_test.copy()
+            fn(N_test, A_test.ctypes.data, W_test.ctypes.data, S_result.ctypes.data)
+            results[fn_name] = S_result
+
+        np.testing.assert_allclose(results[function.name], S_test + A_test @ W_test, rtol=1e-5)
+        np.testing.assert_array_equal(results[streaming["driver"]], results[function.name])
+
+    def test_async_entry_point(self) -> None:
+        import ctypes
+        import threading
+        from hatlib import HATFile, HATPackage
+
+        M = 64
+        N = 64
+
+        A = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(M, N))
+        B = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(M, N))
+
+        nest = Nest(shape=(M, N))
+        i, j = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            B[i, j] += A[i, j]
+
+        package = Package()
+        function = package.add(nest, args=(A, B), base_name="test_async_entry_point", function_opts={"async_entry": True})
+
+        A_test = np.random.random(A.shape).astype(np.float32)
+        B_test = np.random.random(B.shape).astype(np.float32)
+
+        package_name = "test_async_entry_point"
+        output_dir = pathlib.Path(TEST_PACKAGE_DIR) / package_name
+        shutil.rmtree(output_dir, ignore_errors=True)
+
+        with verifiers.VerifyPackage(self, package_name, output_dir) as v:
+            package.build(name=package_name, format=self.PACKAGE_FORMAT, mode=self.PACKAGE_MODE, output_dir=output_dir)
+
+            checker = v.file_checker(f"{package_name}_llvm.mlir")
+            checker.check("llvm.func internal @__accera_async_worker(")
+            checker.check("llvm.func internal @__accera_async_submit(")
+            checker.check("llvm.cmpxchg")
+            checker.check("llvm.call @CreateThread(" if sys.platform == 'win32' else "llvm.call @pthread_create(")
+            checker.check(f"llvm.func internal @{function.name}_async_run(")
+            checker.check(f"llvm.call @{function.name}(")
+            checker.check(f"llvm.func @{function.name}_async(")
+            checker.check("llvm.call @__accera_async_submit(")
+            checker.run()
+
+            checker = v.file_checker(f"{package_name}.hat")
+            checker.check(f"int32_t {function.name}_async(")
+            checker.check("void (*completion_cb)(void* user_data), void* user_data);")
+            checker.run()
+
+            # The blocking function is unchanged
+            v.check_correctness(function.name, before=(A_test, B_test), after=(A_test, A_test + B_test))
+
+        hat_package = HATPackage(output_dir / f"{package_name}.hat")
+        hat_function = next(fn for fn in hat_package.get_functions() if fn.name == function.name)
+        self.assertEqual(hat_function.auxiliary["accera"]["async"]["entry_point"], f"{function.name}_async")
+
+        # Queue the function to the package's worker thread and wait for the completion callback
+        link_target = HATFile.Deserialize(output_dir / f"{package_name}.hat").dependencies.link_target
+        library = ctypes.CDLL(str(output_dir / link_target))
+        CompletionCallback = ctypes.CFUNCTYPE(None, ctypes.c_void_p)
+        async_fn = getattr(library, hat_function.auxiliary["accera"]["async"]["entry_point"])
+        async_fn.restype = ctypes.c_int32
+        async_fn.argtypes = [ctypes.c_void_p, ctypes.c_void_p, CompletionCallback, ctypes.c_void_p]
+
+        completed = threading.Event()
+        user_data = []
+        worker_ids = []
+
+        def on_completion(data):
+            user_data.append(data)
+            worker_ids.append(threading.get_native_id())
+            completed.set()
+
+        callback = CompletionCallback(on_completion)
+        B_result = B_test.copy()
+        self.assertEqual(async_fn(A_test.ctypes.data, B_result.ctypes.data, callback, 42), 0)
+        self.assertTrue(completed.wait(timeout=60))
+        self.assertEqual(user_data, [42])
+        np.testing.assert_allclose(B_result, A_test + B_test, rtol=1e-6)
+
+        # Calls queued back to back run in order on the same persistent worker
+        num_calls = 8
+        all_completed = threading.Event()
+        B_results = [B_test.copy() for _ in range(num_calls)]
+
+        def on_each_completion(data):
+            user_data.append(data)
+            worker_ids.append(threading.get_native_id())
+            if len(user_data) == num_calls + 1:
+                all_completed.set()
+
+        each_callback = CompletionCallback(on_each_completion)
+        for idx, B_each in enumerate(B_results):
+            self.assertEqual(async_fn(A_test.ctypes.data, B_each.ctypes.data, each_callback, idx + 1), 0)
+        self.assertTrue(all_completed.wait(timeout=60))
+        self.assertEqual(user_data, [42] + list(range(1, num_calls + 1)))
+        self.assertEqual(len(set(worker_ids)), 1)
+        self.assertNotEqual(worker_ids[0], threading.get_native_id())
+        for B_each in B_results:
+            np.testing.assert_allclose(B_each, A_test + B_test, rtol=1e-6)
+
     def test_cross_compile(self) -> None:
         M = 128
         N = 256
@@ -8262,6 +8640,154 @@ class SmokeTest(unittest.TestCase):
             checker.check_not('memref.dealloc')
             checker.run()
 
+    def test_huge_pages_temp_array(self) -> None:
+        test_name = "test_huge_pages_temp_array"
+
+        package = Package()
+
+        M = 1024
+        N = 1024
+
+        A = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(M, N))
+        B = Array(role=Role.TEMP, element_type=ScalarType.float32, shape=(M, N), flags=AllocateFlags.HUGE_PAGES)
+        C = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(N, M))
+
+        nest = Nest(shape=(M, N))
+        i, j = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            B[i, j] = A[i, j]
+            C[j, i] = B[i, j]
+
+        function = package.add(nest, args=(A, C), base_name=test_name)
+
+        # Runtime-sized temporaries are heap-allocated instead of living in a global buffer
+        M_dyn, N_dyn = create_dimensions()
+
+        A_dyn = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(M_dyn, N_dyn))
+        B_dyn = Array(role=Role.TEMP, element_type=ScalarType.float32, shape=(M_dyn, N_dyn), flags=AllocateFlags.HUGE_PAGES)
+        C_dyn = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(N_dyn, M_dyn))
+
+        heap_nest = Nest(shape=(M_dyn, N_dyn))
+        i, j = heap_nest.get_indices()
+
+        @heap_nest.iteration_logic
+        def _():
+            B_dyn[i, j] = A_dyn[i, j]
+            C_dyn[j, i] = B_dyn[i, j]
+
+        heap_function = package.add(heap_nest, args=(M_dyn, N_dyn, A_dyn, C_dyn), base_name=f"{test_name}_heap")
+
+        A_test = np.random.random(A.shape).astype(np.float32)
+        C_test = np.random.random(C.shape).astype(np.float32)
+
+        A_heap_test = np.random.random((300, 200)).astype(np.float32)
+        C_heap_test = np.random.random((200, 300)).astype(np.float32)
+
+        output_dir = pathlib.Path(TEST_PACKAGE_DIR) / test_name
+        with verifiers.VerifyPackage(self, test_name, output_dir) as v:
+            package.build(
+                name=test_name,
+                format=self.PACKAGE_FORMAT,
+                mode=self.PACKAGE_MODE,
+                output_dir=output_dir
+            )
+
+            checker = v.file_checker(f"{test_name}_llvm.mlir")
+            if sys.platform == 'linux':
+                checker.check('llvm.mlir.global')
+                checker.check('{alignment = 2097152 : i64}')
+                checker.check('llvm.call @__accera_advise_huge_pages()')
+            else:
+                # Without madvise the buffers aren't over-aligned, which would only cost memory
+                checker.check_not('alignment = 2097152')
+            checker.run()
+
+            if sys.platform == 'linux':
+                # The heap buffer is requested in whole huge pages with huge page alignment, then advised
+                checker = v.file_checker(f"{test_name}_llvm.mlir")
+                checker.check('llvm.call @aligned_alloc(')
+                checker.check('llvm.call @madvise(')
+                checker.check('llvm.call @free(')
+                checker.run()
+
+            v.check_correctness(function.name, before=(A_test, C_test), after=(A_test, A_test.T))
+            v.check_correctness(
+                heap_function.name,
+                before=(A_heap_test, C_heap_test),
+                after=(A_heap_test, A_heap_test.T)
+            )
+
+    def test_cpu_cpp_source(self) -> None:
+        test_name = "test_cpu_cpp_source"
+
+        M = 64
+        N = 64
+
+        A = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(M, N))
+        B = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(M, N))
+        C = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(M, N))
+
+        nest = Nest(shape=(M, N))
+        i, j = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            C[i, j] += A[i, j] * B[i, j]
+
+        schedule = nest.create_schedule()
+        jj = schedule.split(j, 8)
+
+        plan = schedule.create_plan()
+        plan.parallelize(indices=i, max_threads=4)
+        plan.vectorize(jj)
+
+        package = Package()
+        function = package.add(plan, args=(A, B, C), base_name=test_name)
+
+        output_dir = pathlib.Path(TEST_PACKAGE_DIR) / test_name
+        shutil.rmtree(output_dir, ignore_errors=True)
+
+        with verifiers.VerifyPackage(self, test_name, output_dir, file_list=[f"{test_name}.cpp", f"{test_name}.hat"]) as v:
+            package.build(
+                name=test_name,
+                format=Package.Format.HAT_SOURCE,
+                mode=Package.Mode.RELEASE,
+                output_dir=output_dir
+            )
+
+            checker = v.file_checker(f"{test_name}.cpp")
+            checker.check("#include <cstdint>")
+            checker.check("typedef float vfloatx8_t __attribute__((vector_size(32), aligned(4)));")
+            checker.check("float *__restrict__")
+            checker.check("#pragma omp parallel for num_threads(4) schedule(static) proc_bind(close)")
+            checker.check("vfloatx8_t")
+            checker.run()
+
+        # The emitted source must build with a stock host compiler and compute the same results
+        cxx = shutil.which("c++")
+        if not cxx or sys.platform == "win32":
+            return
+
+        import ctypes
+        import subprocess
+
+        lib_path = output_dir / f"lib{test_name}.so"
+        subprocess.run(
+            [cxx, "-O2", "-fopenmp", "-shared", "-fPIC", "-o", lib_path, output_dir / f"{test_name}.cpp"],
+            check=True
+        )
+        fn = getattr(ctypes.CDLL(str(lib_path.absolute())), function.name)
+
+        A_test = np.random.random((M, N)).astype(np.float32)
+        B_test = np.random.random((M, N)).astype(np.float32)
+        C_test = np.random.random((M, N)).astype(np.float32)
+        C_ref = C_test + A_test * B_test
+
+        fn(*(ctypes.c_void_p(x.ctypes.data) for x in (A_test, B_test, C_test)))
+        np.testing.assert_allclose(C_test, C_ref, rtol=1e-5)
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=10)
@@ -476,5 +476,201 @@ class TargetsTest(unittest.TestCase):
         self.assertNotEqual(t1, t3)
 
 
+class RandomTest(unittest.TestCase):
+    def test_random_array(self) -> None:
+        import numpy as np
+        from accera import random_array
+
+        A = random_array((1024, 1024), seed=42)
+        self.assertEqual(A.dtype, np.float32)
+        self.assertTrue(np.all(A >= -1.0) and np.all(A < 1.0))
+        np.testing.assert_array_equal(A, random_array((1024, 1024), seed=42))
+        self.assertFalse(np.array_equal(A, random_array((1024, 1024), seed=43)))
+
+        # Values only depend on the position in the stream
+        tail = random_array((1024, ), seed=42, offset=1023 * 1024)
+        np.testing.assert_array_equal(A[-1], tail)
+
+        B = random_array((100, 100), dtype=np.int32, low=-5, high=5, seed=1)
+        self.assertEqual(B.dtype, np.int32)
+        self.assertEqual(B.min(), -5)
+        self.assertEqual(B.max(), 5)
+
+
+class TuningTest(unittest.TestCase):
+    def _make_tuner(self, output_dir, **kwargs):
+        from accera import create_parameters
+        from accera.tuning import Tuner, Trial
+
+        P0, P1 = create_parameters()
+        parameter_choices = {P0: [4, 8, 16, 32, 64, 128], P1: [1, 2, 4, 8]}
+
+        class FakeBuildTuner(Tuner):
+            def _build(self, variant):
+                self.num_builds += 1
+                return Trial(variant=variant, parameters=self.space.describe(variant), budget=0.0)
+
+        # Fastest at P0 = 32, P1 = 4
+        def benchmark(hat_path, function_name, budget):
+            p0 = [4, 8, 16, 32, 64, 128][tuner.current[0]]
+            p1 = [1, 2, 4, 8][tuner.current[1]]
+            return abs(p0 - 32) + abs(p1 - 4)
+
+        tuner = FakeBuildTuner(None, [], parameter_choices, output_dir=output_dir, num_workers=1, **kwargs)
+        tuner.num_builds = 0
+
+        evaluate = tuner._evaluate
+
+        def tracking_evaluate(build, budget):
+            tuner.current = build.variant
+            return evaluate(build, budget)
+
+        tuner._evaluate = tracking_evaluate
+        tuner.benchmark = benchmark
+        return tuner, P0, P1
+
+    def test_strategies_find_optimum(self) -> None:
+        import shutil
+        from accera.tuning import RandomSearch, SuccessiveHalving, EvolutionarySearch
+
+        for strategy in [RandomSearch(num_trials=24), SuccessiveHalving(num_candidates=24), EvolutionarySearch(num_trials=16, population_size=4)]:
+            output_dir = os.path.join(TEST_PACKAGE_DIR, "tuning_" + type(strategy).__name__)
+            shutil.rmtree(output_dir, ignore_errors=True)
+
+            tuner, P0, P1 = self._make_tuner(output_dir, strategy=strategy, seed=1)
+            result = tuner.run()
+            self.assertTrue(result.trials)
+            self.assertLessEqual(tuner.num_builds, 24)
+            self.assertLessEqual(result.best.score, 4)
+
+            if isinstance(strategy, SuccessiveHalving):
+                # Each candidate is built once, survivors are re-measured with a larger budget
+                self.assertEqual(tuner.num_builds, len({t.variant for t in result.trials}))
+                self.assertEqual(result.trials[-1].budget, 1.0)
+
+    def test_resume_and_early_stopping(self) -> None:
+        import shutil
+        from accera.tuning import RandomSearch
+
+        output_dir = os.path.join(TEST_PACKAGE_DIR, "tuning_resume")
+        shutil.rmtree(output_dir, ignore_errors=True)
+
+        tuner, _, _ = self._make_tuner(output_dir, strategy=RandomSearch(num_trials=12), seed=3)
+        first = tuner.run()
+        self.assertEqual(len(first.trials), 12)
+
+        # The same search is replayed from the results file without benchmarking again
+        tuner, P0, P1 = self._make_tuner(output_dir, strategy=RandomSearch(num_trials=12), seed=3)
+        tuner.benchmark = lambda *_: self.fail("trial should have been restored")
+        second = tuner.run()
+        self.assertEqual([t.score for t in first.trials], [t.score for t in second.trials])
+        self.assertEqual(set(second.best_parameters.keys()), {P0, P1})
+
+        output_dir = os.path.join(TEST_PACKAGE_DIR, "tuning_early_stopping")
+        shutil.rmtree(output_dir, ignore_errors=True)
+        tuner, _, _ = self._make_tuner(output_dir, strategy=RandomSearch(num_trials=24), early_stopping=1, seed=3)
+        self.assertLess(len(tuner.run().trials), 24)
+
+    def test_parallel_builds(self) -> None:
+        import shutil
+        from accera import Array, Nest, ScalarType, create_parameters
+        from accera.tuning import RandomSearch, Tuner
+
+        A = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(64, 64))
+        B = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(64, 64))
+        nest = Nest(shape=(64, 64))
+        i, j = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            B[i, j] += A[i, j]
+
+        P0, = create_parameters()
+        schedule = nest.create_schedule()
+        schedule.split(j, P0)
+
+        output_dir = os.path.join(TEST_PACKAGE_DIR, "tuning_parallel_builds")
+        shutil.rmtree(output_dir, ignore_errors=True)
+
+        # Listed largest first, so that the smallest split size is not also the smallest choice index
+        split_sizes = [32, 16, 8, 4]
+
+        # Scores each build by its split size, after checking that the worker produced it. Packages are named
+        # tuning_parallel_<choice index>, which maps back to the split size the variant was built with
+        def benchmark(hat_path, function_name, budget):
+            self.assertTrue(os.path.isfile(hat_path))
+            with open(hat_path) as f:
+                self.assertIn(function_name, f.read())
+            choice_index = int(os.path.basename(os.path.dirname(hat_path)).split("_")[-1])
+            return split_sizes[choice_index]
+
+        tuner = Tuner(
+            schedule,
+            args=(A, B),
+            parameter_choices={P0: split_sizes},
+            base_name="tuning_parallel",
+            benchmark=benchmark,
+            strategy=RandomSearch(num_trials=4),
+            output_dir=output_dir,
+            num_workers=2,
+            seed=0
+        )
+        result = tuner.run()
+
+        self.assertEqual(len(result.trials), 4)
+        for trial in result.trials:
+            self.assertTrue(trial.succeeded, trial.error)
+        self.assertEqual(len({t.hat_path for t in result.trials}), 4)
+        for trial in result.trials:
+            self.assertEqual(trial.score, trial.parameters[P0._name])
+        self.assertEqual(result.best_parameters, {P0: 4})
+
+    def test_cost_model_top_k(self) -> None:
+        import itertools
+        import math
+        from accera import Array, Nest, ScalarType, create_parameters, create_parameter_grid
+        from accera.tuning import CostModel, SearchSpace, Trial, TuningResult
+
+        A = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(256, 256))
+        B = Array(role=Role.INPUT, element_type=ScalarType.float32, shape=(256, 256))
+        C = Array(role=Role.INPUT_OUTPUT, element_type=ScalarType.float32, shape=(256, 256))
+        nest = Nest(shape=(256, 256, 256))
+        i, j, k = nest.get_indices()
+
+        @nest.iteration_logic
+        def _():
+            C[i, j] += A[i, k] * B[k, j]
+
+        P0, P1 = create_parameters()
+        schedule = nest.create_schedule()
+        schedule.split(i, P0)
+        jj = schedule.split(j, P1)
+        plan = schedule.create_plan()
+        plan.cache(B, jj)
+
+        parameter_choices = {P0: [4, 8, 16, 32, 64, 128], P1: [4, 8, 16, 32, 64, 128]}
+        space = SearchSpace(parameter_choices)
+
+        # Synthetic runtimes with an optimum at P0 = 16, P1 = 64, measured on half of the grid
+        def runtime(variant):
+            p0, p1 = space.values(variant)
+            return 2**(abs(math.log2(p0) - 4) + abs(math.log2(p1) - 6))
+
+        trials = [
+            Trial(variant=v, parameters=space.describe(v), budget=1.0, score=runtime(v))
+            for v in itertools.product(range(6), range(6)) if sum(v) % 2 == 0
+        ]
+        model = CostModel().fit(plan, parameter_choices, [TuningResult(space, trials)])
+        self.assertTrue(model.is_trained)
+
+        grid = create_parameter_grid(parameter_choices)
+        best = model.top_k(plan, grid, 4)
+        self.assertEqual(len(best), 4)
+        self.assertIn({P0: 16, P1: 64}, best)
+
+        # An untrained model keeps every variant
+        self.assertEqual(len(CostModel().top_k(plan, grid, 4)), len(grid))
+
+
 if __name__ == '__main__':
     unittest.main(verbosity=10)
@@ -0,0 +1,235 @@
+####################################################################################################
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See LICENSE in the project root for license information.
+####################################################################################################
+
+import json
+import logging
+import math
+import os
+from functools import reduce
+from typing import Dict, Iterable, List, Union
+
+from .SearchSpace import SearchSpace
+from .Tuner import TuningResult
+
+
+def _log2(value) -> float:
+    try:
+        return math.log2(float(value)) if float(value) > 0 else 0.0
+    except (TypeError, ValueError):
+        return 0.0
+
+
+def extract_features(plan: "accera.Plan", parameters: dict) -> Dict[str, float]:
+    """Describes one variant of a parameterized plan as a set of named numeric features.
+
+    Sets the parameter values and replays the schedule's parameterized transformations (as `Package.add` does),
+    then reads off the split sizes, loop order, per-loop plan attributes, caches and target properties.
+
+    Args:
+        plan: The parameterized plan.
+        parameters: A {DelayedParameter: value} mapping for one variant.
+    """
+    from ..lang.PlanAnalysis import _resolved_caches, _resolved_index_attrs
+
+    for param, value in parameters.items():
+        param.set_value(value)
+
+    features = {}
+    for param, value in parameters.items():
+        if isinstance(value, (int, float)) and not isinstance(value, bool):
+            features[f"param.{param._name}"] = _log2(value)
+
+    sched = plan._sched
+    sched._replay_delayed_calls()
+
+    # Loops are identified by their creation order, which is the same for every variant of the plan
+    loops = list(sched._index_map.keys())
+    loop_ids = {index: k for k, index in enumerate(loops)}
+    order = list(sched._indices)
+
+    def iterations(index) -> float:
+        try:
+            return max(float(sched._index_map[sched._resolve_index(index)].num_iterations()), 1.0)
+        except (TypeError, ValueError, KeyError):
+            return 1.0
+
+    for index in order:
+        k = loop_ids.get(index)
+        if k is None:
+            continue
+        features[f"loop{k}.iterations"] = _log2(iterations(index))
+        features[f"loop{k}.depth"] = order.index(index) / max(len(order) - 1, 1)
+
+    # Plan attributes, from both the direct calls and the parameterized ones
+    attrs = _resolved_index_attrs(plan)
+    caches = _resolved_caches(plan)
+
+    vector_volume = 1.0
+    parallel_volume = 1.0
+    for index, index_attrs in attrs.items():
+        k = loop_ids.get(index)
+        if k is None:
+            continue
+        for attr in ("vectorized", "unrolled", "parallelized"):
+            if attr in index_attrs:
+                features[f"loop{k}.{attr}"] = 1.0
+        if "vectorized" in index_attrs:
+            vector_volume *= iterations(index)
+        if "parallelized" in index_attrs:
+            parallel_volume *= iterations(index)
+    features["vectorized.volume"] = _log2(vector_volume)
+    features["parallelized.volume"] = _log2(parallel_volume)
+
+    # The iteration volume under a cache's index bounds the number of elements it holds
+    for c, cache in enumerate(caches):
+        index, level, max_elements = cache.get("index"), cache.get("level"), cache.get("max_elements")
+        if index in order:
+            level = len(order) - order.index(index)
+        if max_elements:
+            footprint = float(max_elements)
+        elif level:
+            footprint = reduce(lambda n, i: n * iterations(i), order[-level:], 1.0)
+        else:
+            footprint = 1.0
+        features[f"cache{c}.level"] = float(level or 0)
+        features[f"cache{c}.footprint"] = _log2(footprint)
+        features[f"cache{c}.double_buffer"] = float(bool(cache.get("double_buffer")))
+
+    target = plan._target
+    features["target.num_threads"] = _log2(target.num_threads or 1)
+    features["target.vector_bytes"] = _log2(target.vector_bytes or 1)
+    features["target.vector_registers"] = _log2(target.vector_registers or 1)
+    for level, size in enumerate(target.cache_sizes or []):
+        features[f"target.cache{level}"] = _log2(size)
+
+    return features
+
+
+class CostModel:
+    """A ridge regressor over `extract_features`, trained on tuning results to predict a variant's
+    log runtime without building it.
+
+    The quadratic terms let the model capture the interior optimum typical of tile sizes; it is
+    meant to rank candidates, not to predict absolute runtimes precisely.
+    """
+
+    def __init__(self, regularization: float = 1.0, min_samples: int = 8):
+        self.regularization = regularization
+        self.min_samples = min_samples
+        self.feature_names: List[str] = []
+        self.weights = None
+
+    @property
+    def is_trained(self) -> bool:
+        return self.weights is not None
+
+    def _design_matrix(self, rows: List[Dict[str, float]]):
+        import numpy as np
+
+        X = np.array([[row.get(name, 0.0) for name in self.feature_names] for row in rows], dtype=np.float64)
+        X = (X - self._mean) / self._scale
+        return np.hstack([X, X**2, np.ones((len(rows), 1))])
+
+    def fit(
+        self, plan: "accera.Plan", parameter_choices: dict, results: Iterable[Union[str, TuningResult]]
+    ) -> "CostModel":
+        """Trains the model on previous tuning runs of the same plan.
+
+        Args:
+            plan: The parameterized plan that was tuned.
+            parameter_choices: The parameter choices that were tuned over.
+            results: `TuningResult`s, or paths to the results files written by `Tuner`.
+        """
+        import numpy as np
+
+        space = SearchSpace(parameter_choices)
+        samples = {}
+        for result in results:
+            if isinstance(result, TuningResult):
+                records = [(t.variant, t.budget, t.score) for t in result.trials if t.succeeded]
+            else:
+                records = []
+                with open(result) as f:
+                    for line in f:
+                        try:
+                            r = json.loads(line)
+                        except json.JSONDecodeError:
+                            continue
+                        variant = space.find(r.get("parameter_names"), r.get("variant", []))
+                        if variant is not None and r.get("score") is not None and not r.get("error"):
+                            records.append((variant, r["budget"], r["score"]))
+
+            # Keep the most thorough measurement of each variant
+            for variant, budget, score in records:
+                if score > 0 and (variant not in samples or samples[variant][0] <= budget):
+                    samples[variant] = (budget, score)
+
+        if len(samples) < self.min_samples:
+            logging.warning(f"CostModel: {len(samples)} results are not enough to train, need {self.min_samples}")
+            self.weights = None
+            return self
+
+        rows = [extract_features(plan, space.to_parameters(v)) for v in samples]
+        y = np.log([score for _, score in samples.values()])
+
+        self.feature_names = sorted({name for row in rows for name in row})
+        X = np.array([[row.get(name, 0.0) for name in self.feature_names] for row in rows], dtype=np.float64)
+        self._mean = X.mean(axis=0)
+        self._scale = np.where(X.std(axis=0) > 0, X.std(axis=0), 1.0)
+
+        A = self._design_matrix(rows)
+        penalty = self.regularization * np.eye(A.shape[1])
+        penalty[-1, -1] = 0.0    # don't shrink the intercept
+        self.weights = np.linalg.solve(A.T @ A + penalty, A.T @ y)
+        return self
+
+    def predict(self, plan: "accera.Plan", parameters: List[dict]) -> List[float]:
+        "Predicts the runtime of each variant, in the units of the training scores"
+        import numpy as np
+
+        if not self.is_trained:
+            raise RuntimeError("The cost model has not been trained")
+        rows = [extract_features(plan, p) for p in parameters]
+        return list(np.exp(self._design_matrix(rows) @ self.weights))
+
+    def top_k(self, plan: "accera.Plan", parameters: List[dict], k: int) -> List[dict]:
+        """Keeps the `k` variants with the lowest predicted runtime, for use as
+        `Package.add(plan, ..., parameters=model.top_k(plan, parameters, k))`.
+
+        Returns `parameters` unchanged if the model hasn't been trained.
+        """
+        parameters = list(parameters)
+        if not self.is_trained or len(parameters) <= k:
+            return parameters
+
+        predictions = self.predict(plan, parameters)
+        ranked = sorted(range(len(parameters)), key=lambda i: predictions[i])[:k]
+        return [parameters[i] for i in sorted(ranked)]
+
+    def save(self, path: str):
+        os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+        with open(path, "w") as f:
+            json.dump({
+                "regularization": self.regularization,
+                "min_samples": self.min_samples,
+                "feature_names": self.feature_names,
+                "mean": list(self._mean) if self.is_trained else None,
+                "scale": list(self._scale) if self.is_trained else None,
+                "weights": list(self.weights) if self.is_trained else None,
+            }, f, indent=2)
+
+    @staticmethod
+    def load(path: str) -> "CostModel":
+        import numpy as np
+
+        with open(path) as f:
+            data = json.load(f)
+        model = CostModel(data["regularization"], data["min_samples"])
+        model.feature_names = data["feature_names"]
+        if data["weights"] is not None:
+            model._mean = np.array(data["mean"])
+            model._scale = np.array(data["scale"])
+            model.weights = np.array(data["weights"])
+        return model
@@ -0,0 +1,102 @@
+####################################################################################################
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See LICENSE in the project root for license information.
+####################################################################################################
+
+import random
+from functools import reduce
+from typing import Callable, List, Optional, Tuple
+
+from ..Constraints import make_variant_filter
+from ..Parameter import expand_parameter_choices
+
+# A point in the search space, stored as one choice index per parameter so that it is hashable and
+# can be persisted without serializing the parameter values themselves
+Variant = Tuple[int, ...]
+
+
+class SearchSpace:
+    "The set of parameter assignments that a tuning run may evaluate"
+
+    def __init__(self, parameter_choices: dict, filter_func: Callable = None, max_sample_attempts: int = 1000):
+        """Creates a search space.
+
+        Args:
+            parameter_choices: A dictionary that maps each parameter to its possible values, with the same
+                conventions as `create_parameter_grid`.
+            filter_func: A callable that receives a tuple of values (in the order of `parameter_choices`)
+                and returns whether that combination is valid, a `Constraint`, or a list of either.
+            max_sample_attempts: The number of rejected samples after which the space is treated as exhausted.
+        """
+        self.parameters, self.choices = expand_parameter_choices(parameter_choices)
+        self.filter_func = filter_func
+        self._accepts = make_variant_filter(self.parameters, filter_func)
+        self.max_sample_attempts = max_sample_attempts
+
+        for param, values in zip(self.parameters, self.choices):
+            if not values:
+                raise ValueError(f"Parameter {param._name} has no possible values")
+
+    @property
+    def size(self) -> int:
+        "The number of points in the space before filtering"
+        return reduce(lambda n, values: n * len(values), self.choices, 1)
+
+    def values(self, variant: Variant) -> tuple:
+        return tuple(values[i] for values, i in zip(self.choices, variant))
+
+    def is_valid(self, variant: Variant) -> bool:
+        return self._accepts(self.values(variant))
+
+    def to_parameters(self, variant: Variant) -> dict:
+        "Returns the {DelayedParameter: value} mapping that `Package.add` expects"
+        return dict(zip(self.parameters, self.values(variant)))
+
+    def describe(self, variant: Variant) -> dict:
+        "Returns a {parameter name: printable value} mapping, for reporting and persisting"
+        from ..lang import LoopIndex
+
+        def printable(value):
+            if isinstance(value, (tuple, list)) and all(isinstance(v, LoopIndex) for v in value):
+                return [v._name for v in value]
+            return value if isinstance(value, (int, float, str, bool)) else str(value)
+
+        return {p._name: printable(v) for p, v in zip(self.parameters, self.values(variant))}
+
+    def sample(self, rng: random.Random, exclude: set = frozenset()) -> Optional[Variant]:
+        "Draws a valid point uniformly at random, or returns None if none can be found"
+        for _ in range(self.max_sample_attempts):
+            variant = tuple(rng.randrange(len(values)) for values in self.choices)
+            if variant not in exclude and self.is_valid(variant):
+                return variant
+        return None
+
+    def mutate(self, variant: Variant, rng: random.Random, exclude: set = frozenset()) -> Optional[Variant]:
+        """Returns a valid point that differs from `variant` in one parameter, or None if none can be found.
+        Parameters are mostly moved to an adjacent choice, since neighbouring tile sizes and split factors
+        tend to perform similarly."""
+        mutable = [i for i, values in enumerate(self.choices) if len(values) > 1]
+        if not mutable:
+            return None
+
+        for _ in range(self.max_sample_attempts):
+            i = rng.choice(mutable)
+            n = len(self.choices[i])
+            if rng.random() < 0.75:
+                choice = min(max(variant[i] + rng.choice([-1, 1]), 0), n - 1)
+            else:
+                choice = rng.randrange(n)
+            if choice == variant[i]:
+                continue
+            candidate = variant[:i] + (choice, ) + variant[i + 1:]
+            if candidate not in exclude and self.is_valid(candidate):
+                return candidate
+        return None
+
+    def find(self, names: List[str], variant: List[int]) -> Optional[Variant]:
+        "Maps a persisted variant back into this space, if its parameters still match"
+        if names != [p._name for p in self.parameters] or len(variant) != len(self.choices):
+            return None
+        if any(i < 0 or i >= len(values) for i, values in zip(variant, self.choices)):
+            return None
+        return tuple(variant)
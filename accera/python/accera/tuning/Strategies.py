@@ -0,0 +1,150 @@
+####################################################################################################
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See LICENSE in the project root for license information.
+####################################################################################################
+
+import math
+import random
+from collections import deque
+from typing import List, Tuple
+
+from .SearchSpace import SearchSpace, Variant
+
+
+class SearchStrategy:
+    """The interface between the `Tuner` and a search algorithm.
+
+    The tuner repeatedly asks the strategy for a batch of (variant, budget) requests, builds and
+    benchmarks them, and reports each score back with `tell`. Lower scores are better. A strategy
+    signals that it has finished by returning an empty batch.
+    """
+
+    def reset(self, space: SearchSpace, rng: random.Random):
+        self.space = space
+        self.rng = rng
+
+    def ask(self, max_count: int) -> List[Tuple[Variant, float]]:
+        raise NotImplementedError()
+
+    def tell(self, variant: Variant, budget: float, score: float):
+        pass
+
+
+class RandomSearch(SearchStrategy):
+    "Evaluates distinct points drawn uniformly from the search space"
+
+    def __init__(self, num_trials: int = 32):
+        self.num_trials = num_trials
+
+    def reset(self, space, rng):
+        super().reset(space, rng)
+        self.visited = set()
+
+    def ask(self, max_count):
+        batch = []
+        while len(self.visited) < self.num_trials and len(batch) < max_count:
+            variant = self.space.sample(self.rng, exclude=self.visited)
+            if variant is None:
+                break
+            self.visited.add(variant)
+            batch.append((variant, 1.0))
+        return batch
+
+
+class SuccessiveHalving(SearchStrategy):
+    """Benchmarks many random candidates briefly, then repeatedly keeps the best `1 / reduction_factor`
+    of them and benchmarks the survivors with `reduction_factor` times more budget.
+
+    Each candidate is only built once; later rungs re-run its benchmark with a larger budget.
+    """
+
+    def __init__(self, num_candidates: int = 27, reduction_factor: int = 3, min_budget: float = None):
+        if reduction_factor < 2:
+            raise ValueError("reduction_factor must be at least 2")
+        self.num_candidates = num_candidates
+        self.reduction_factor = reduction_factor
+        self.min_budget = min_budget
+
+    def reset(self, space, rng):
+        super().reset(space, rng)
+        num_promotions = 0
+        remaining = self.num_candidates
+        while remaining // self.reduction_factor > 1:
+            remaining //= self.reduction_factor
+            num_promotions += 1
+
+        # By default the last rung runs with the full benchmark budget
+        self.budget = self.min_budget or float(self.reduction_factor)**-num_promotions
+        self.pending = []
+        self.scores = {}
+
+        visited = set()
+        while len(visited) < self.num_candidates:
+            variant = self.space.sample(self.rng, exclude=visited)
+            if variant is None:
+                break
+            visited.add(variant)
+            self.pending.append(variant)
+        self.rung = list(self.pending)
+
+    def ask(self, max_count):
+        if not self.pending and len(self.scores) == len(self.rung) and len(self.rung) > 1:
+            self._promote()
+
+        batch = [(variant, self.budget) for variant in self.pending[:max_count]]
+        self.pending = self.pending[max_count:]
+        return batch
+
+    def tell(self, variant, budget, score):
+        if budget == self.budget:
+            self.scores[variant] = score
+
+    def _promote(self):
+        survivors = sorted(self.rung, key=lambda v: self.scores[v])
+        survivors = survivors[:max(1, len(self.rung) // self.reduction_factor)]
+        survivors = [v for v in survivors if math.isfinite(self.scores[v])]
+
+        self.budget *= self.reduction_factor
+        self.scores = {}
+        self.rung = survivors if len(survivors) > 1 else []
+        self.pending = list(self.rung)
+
+
+class EvolutionarySearch(SearchStrategy):
+    """Regularized evolution: each new candidate is a one-parameter mutation of the best of a few
+    randomly-chosen members of the population, and it replaces the oldest member.
+
+    Mutations mostly move a parameter to an adjacent choice, so this converges quickly on search
+    spaces whose choices are listed in order (such as tile sizes).
+    """
+
+    def __init__(self, num_trials: int = 64, population_size: int = 16, tournament_size: int = 4):
+        self.num_trials = num_trials
+        self.population_size = population_size
+        self.tournament_size = tournament_size
+
+    def reset(self, space, rng):
+        super().reset(space, rng)
+        self.visited = set()
+        self.population = deque(maxlen=self.population_size)
+
+    def ask(self, max_count):
+        batch = []
+        while len(self.visited) < self.num_trials and len(batch) < max_count:
+            if len(self.visited) < self.population_size or not self.population:
+                variant = self.space.sample(self.rng, exclude=self.visited)
+            else:
+                contenders = self.rng.sample(list(self.population), min(self.tournament_size, len(self.population)))
+                parent = min(contenders, key=lambda member: member[1])[0]
+                variant = self.space.mutate(parent, self.rng, exclude=self.visited)
+                if variant is None:
+                    variant = self.space.sample(self.rng, exclude=self.visited)
+            if variant is None:
+                break
+            self.visited.add(variant)
+            batch.append((variant, 1.0))
+        return batch
+
+    def tell(self, variant, budget, score):
+        if math.isfinite(score):
+            self.population.append((variant, score))
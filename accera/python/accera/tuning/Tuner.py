@@ -0,0 +1,315 @@
+####################################################################################################
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See LICENSE in the project root for license information.
+####################################################################################################
+
+import json
+import math
+import multiprocessing
+import os
+import random
+import time
+from concurrent.futures import ProcessPoolExecutor
+from dataclasses import dataclass, field
+from typing import Callable, Dict, List, Optional, Union
+
+from ..Package import Package
+from .SearchSpace import SearchSpace, Variant
+from .Strategies import SearchStrategy, EvolutionarySearch
+
+
+@dataclass
+class Trial:
+    "The outcome of building and benchmarking one point of the search space"
+    variant: Variant
+    parameters: Dict[str, object]
+    budget: float
+    score: float = math.inf
+    function_name: str = ""
+    hat_path: str = ""
+    build_time: float = 0.0
+    error: str = ""
+
+    @property
+    def succeeded(self) -> bool:
+        return not self.error and math.isfinite(self.score)
+
+
+@dataclass
+class TuningResult:
+    "The trials run by a `Tuner`, in evaluation order"
+    space: SearchSpace
+    trials: List[Trial] = field(default_factory=list)
+
+    @property
+    def best(self) -> Optional[Trial]:
+        "The best full-budget trial, or the best trial overall if none ran with the full budget"
+        succeeded = [t for t in self.trials if t.succeeded]
+        full_budget = [t for t in succeeded if t.budget >= 1.0]
+        return min(full_budget or succeeded, key=lambda t: t.score, default=None)
+
+    @property
+    def best_parameters(self) -> Optional[dict]:
+        "The {DelayedParameter: value} mapping of the best trial, ready to pass to `Package.add`"
+        best = self.best
+        return self.space.to_parameters(best.variant) if best else None
+
+
+class HATBenchmark:
+    """Measures a built function with `hatlib.run_benchmark` and returns its minimum mean runtime in seconds.
+
+    The tuner passes a budget in (0, 1]; the measuring time is `min_time_in_sec * budget`, so cheap early
+    rounds of a `SuccessiveHalving` search take proportionally less time.
+    """
+
+    def __init__(self, batch_size: int = 10, min_time_in_sec: float = 1.0, input_sets_minimum_size_MB: int = 50):
+        self.batch_size = batch_size
+        self.min_time_in_sec = min_time_in_sec
+        self.input_sets_minimum_size_MB = input_sets_minimum_size_MB
+
+    def __call__(self, hat_path: str, function_name: str, budget: float = 1.0) -> float:
+        import hatlib
+
+        results = hatlib.run_benchmark(
+            hat_path,
+            batch_size=self.batch_size,
+            min_time_in_sec=max(self.min_time_in_sec * budget, 0.01),
+            input_sets_minimum_size_MB=self.input_sets_minimum_size_MB
+        )
+        times = [
+            float(r.min_of_means) for r in results
+            if getattr(r, "function_name", function_name) == function_name and r.min_of_means != '-'
+        ]
+        if not times:
+            raise RuntimeError(f"No benchmark results for {function_name}")
+        return min(times)
+
+
+# The tuner that forked build workers inherit. Plans, arrays and parameters hold native objects
+# that cannot be pickled, so workers are forked with the tuner already in memory instead.
+_active_tuner: "Tuner" = None
+
+
+def _build_in_worker(variant: Variant):
+    return _active_tuner._build(variant)
+
+
+class Tuner:
+    """Searches a space of parameter values for the fastest build of a parameterized function.
+
+    Candidates are built in parallel worker processes and benchmarked one at a time in this process,
+    so that measurements don't compete with each other for the machine. Every trial is appended to
+    `results_file` as it completes; a tuner pointed at an existing results file skips the trials it
+    already records, so an interrupted search can be resumed.
+    """
+
+    def __init__(
+        self,
+        source: Union["accera.Nest", "accera.Schedule", "accera.Plan", "accera.Function", Callable],
+        args: List[Union["accera.Dimension", "accera.Array"]],
+        parameter_choices: dict,
+        base_name: str = "tuned",
+        benchmark: Callable[[str, str, float], float] = None,
+        strategy: SearchStrategy = None,
+        filter_func: Callable = None,
+        format: Package.Format = Package.Format.HAT_DYNAMIC,
+        platform: Package.Platform = Package.Platform.HOST,
+        output_dir: str = "tuning",
+        results_file: str = None,
+        num_workers: int = None,
+        early_stopping: int = None,
+        seed: int = None,
+        verbose: bool = False,
+    ):
+        """Creates a tuner.
+
+        Args:
+            source: The parameterized source of the function, as accepted by `Package.add`.
+            args: The arguments of the function, as accepted by `Package.add`.
+            parameter_choices: A dictionary that maps each parameter to its possible values, with the same
+                conventions as `create_parameter_grid`.
+            base_name: The base name of the built packages and functions.
+            benchmark: A callable `(hat_path, function_name, budget) -> score` where lower scores are better.
+                Defaults to `HATBenchmark()`.
+            strategy: The search strategy. Defaults to `EvolutionarySearch()`.
+            filter_func: A callable that receives a tuple of parameter values and returns whether the
+                combination should be considered, as in `create_parameter_grid`.
+            format: The format of the built packages.
+            platform: The platform of the built packages.
+            output_dir: The directory that receives one sub-directory per built candidate.
+            results_file: The JSON-lines file that trials are persisted to. Defaults to
+                `<output_dir>/<base_name>_results.jsonl`.
+            num_workers: The number of candidates built concurrently. Defaults to the number of CPUs.
+            early_stopping: Stops the search after this many consecutive full-budget trials that
+                don't improve on the best score. Disabled by default.
+            seed: The seed for the search strategy's random choices.
+            verbose: Prints each trial as it completes.
+        """
+        self.source = source
+        self.args = args
+        self.space = SearchSpace(parameter_choices, filter_func)
+        self.base_name = base_name
+        self.benchmark = benchmark or HATBenchmark()
+        self.strategy = strategy or EvolutionarySearch()
+        self.format = format
+        self.platform = platform
+        self.output_dir = os.path.abspath(output_dir)
+        self.results_file = results_file or os.path.join(self.output_dir, f"{base_name}_results.jsonl")
+        self.num_workers = num_workers or os.cpu_count() or 1
+        self.early_stopping = early_stopping
+        self.seed = seed
+        self.verbose = verbose
+
+    def run(self) -> TuningResult:
+        "Runs the search and returns its trials. Trials already recorded in `results_file` are reused, not repeated"
+        global _active_tuner
+
+        os.makedirs(self.output_dir, exist_ok=True)
+        previous = self._load_results()
+        builds = {t.variant: t for t in previous.values() if t.hat_path or t.error}
+
+        result = TuningResult(self.space)
+        best_score = math.inf
+        trials_since_improvement = 0
+
+        self.strategy.reset(self.space, random.Random(self.seed))
+        while True:
+            batch = self.strategy.ask(self.num_workers)
+            if not batch:
+                break
+
+            # Build whatever this batch needs that hasn't been built already
+            to_build = list(dict.fromkeys(v for v, _ in batch if v not in builds))
+            for trial in self._build_all(to_build):
+                builds[trial.variant] = trial
+
+            for variant, budget in batch:
+                trial = previous.get((variant, budget))
+                if trial is None:
+                    trial = self._evaluate(builds[variant], budget)
+                    self._save_result(trial)
+                result.trials.append(trial)
+                self.strategy.tell(variant, budget, trial.score)
+
+                if self.verbose:
+                    outcome = f"{trial.score:.6g}" if trial.succeeded else f"failed ({trial.error})"
+                    print(f"[tuning] {trial.parameters} (budget {budget:.3g}): {outcome}")
+
+                if budget >= 1.0:
+                    if trial.score < best_score:
+                        best_score = trial.score
+                        trials_since_improvement = 0
+                    else:
+                        trials_since_improvement += 1
+
+            if self.early_stopping and trials_since_improvement >= self.early_stopping:
+                break
+
+        _active_tuner = None
+        return result
+
+    def _build_all(self, variants: List[Variant]) -> List[Trial]:
+        global _active_tuner
+
+        if len(variants) > 1 and self.num_workers > 1 and "fork" in multiprocessing.get_all_start_methods():
+            _active_tuner = self
+            with ProcessPoolExecutor(
+                max_workers=min(self.num_workers, len(variants)), mp_context=multiprocessing.get_context("fork")
+            ) as executor:
+                return list(executor.map(_build_in_worker, variants))
+
+        return [self._build(v) for v in variants]
+
+    def _build(self, variant: Variant) -> Trial:
+        trial = Trial(variant=variant, parameters=self.space.describe(variant), budget=0.0)
+        package_name = f"{self.base_name}_" + "_".join(map(str, variant))
+        package_dir = os.path.join(self.output_dir, package_name)
+
+        start = time.perf_counter()
+        try:
+            package = Package()
+            function = package.add(
+                self.source, args=self.args, base_name=self.base_name, parameters=self.space.to_parameters(variant)
+            )
+            package.build(
+                package_name, format=self.format, platform=self.platform, output_dir=package_dir, fail_on_error=True
+            )
+            trial.function_name = function.name
+            trial.hat_path = os.path.join(package_dir, package_name + ".hat")
+        except Exception as e:
+            trial.error = f"build failed: {e}"
+        trial.build_time = time.perf_counter() - start
+        return trial
+
+    def _evaluate(self, build: Trial, budget: float) -> Trial:
+        trial = Trial(
+            variant=build.variant,
+            parameters=build.parameters,
+            budget=budget,
+            function_name=build.function_name,
+            hat_path=build.hat_path,
+            build_time=build.build_time,
+            error=build.error
+        )
+        if not trial.error:
+            try:
+                trial.score = float(self.benchmark(trial.hat_path, trial.function_name, budget))
+            except Exception as e:
+                trial.error = f"benchmark failed: {e}"
+        return trial
+
+    def _save_result(self, trial: Trial):
+        record = {
+            "parameter_names": [p._name for p in self.space.parameters],
+            "variant": list(trial.variant),
+            "parameters": trial.parameters,
+            "budget": trial.budget,
+            "score": trial.score if math.isfinite(trial.score) else None,
+            "function_name": trial.function_name,
+            "hat_path": trial.hat_path,
+            "build_time": trial.build_time,
+            "error": trial.error,
+        }
+        with open(self.results_file, "a") as f:
+            f.write(json.dumps(record) + "\n")
+
+    def _load_results(self) -> Dict[tuple, Trial]:
+        trials = {}
+        if not os.path.isfile(self.results_file):
+            return trials
+
+        with open(self.results_file) as f:
+            for line in f:
+                try:
+                    record = json.loads(line)
+                except json.JSONDecodeError:
+                    continue    # a partially-written line from an interrupted run
+                variant = self.space.find(record.get("parameter_names"), record.get("variant", []))
+                if variant is None:
+                    continue
+                if record["hat_path"] and not os.path.isfile(record["hat_path"]):
+                    continue
+                trials[(variant, record["budget"])] = Trial(
+                    variant=variant,
+                    parameters=record["parameters"],
+                    budget=record["budget"],
+                    score=math.inf if record["score"] is None else record["score"],
+                    function_name=record["function_name"],
+                    hat_path=record["hat_path"],
+                    build_time=record["build_time"],
+                    error=record["error"]
+                )
+        return trials
+
+
+def tune(
+    source: Union["accera.Nest", "accera.Schedule", "accera.Plan", "accera.Function", Callable],
+    args: List[Union["accera.Dimension", "accera.Array"]],
+    parameter_choices: dict,
+    **kwargs
+) -> TuningResult:
+    """Searches for the fastest build of a parameterized function. Accepts the same arguments as `Tuner`.
+
+    Returns the trials that were run; `result.best_parameters` holds the best parameter values found.
+    """
+    return Tuner(source, args, parameter_choices, **kwargs).run()
@@ -0,0 +1,9 @@
+####################################################################################################
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See LICENSE in the project root for license information.
+####################################################################################################
+
+from .SearchSpace import SearchSpace
+from .Strategies import SearchStrategy, RandomSearch, SuccessiveHalving, EvolutionarySearch
+from .Tuner import Trial, TuningResult, HATBenchmark, Tuner, tune
+from .CostModel import CostModel, extract_features
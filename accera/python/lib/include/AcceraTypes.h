@@ -31,6 +31,7 @@ namespace lang
     void DefineExecutionPlanTypes(pybind11::module& module);
     void DefinePackagingTypes(pybind11::module& module, pybind11::module& subModule);
     void DefineOperations(pybind11::module& module);
+    void DefineRuntimeUtilities(pybind11::module& module);
 
 } // namespace lang
 } // namespace python
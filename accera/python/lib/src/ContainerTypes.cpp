@@ -44,7 +44,8 @@ namespace
             .value("GLOBAL", value::AllocateFlags::Global)
             .value("STACK", value::AllocateFlags::Stack)
             .value("HEAP", value::AllocateFlags::Heap)
-            .value("THREAD_LOCAL", value::AllocateFlags::ThreadLocal);
+            .value("THREAD_LOCAL", value::AllocateFlags::ThreadLocal)
+            .value("HUGE_PAGES", value::AllocateFlags::HugePages);
 
         py::enum_<value::Role>(module, "Role", "Defines how the container will be used")
             .value("CONST", value::Role::Const)
@@ -167,6 +168,10 @@ Args:
         });
         module.def("round", &value::Round);
         module.def("remainderf", &value::Remainderf);
+        module.def("atomic_add", &value::AtomicAdd);
+        module.def("atomic_max", &value::AtomicMax);
+        module.def("atomic_min", &value::AtomicMin);
+        module.def("atomic_exchange", &value::AtomicExchange);
         module.def("type_size_bytes", [](value::ValueType type) {
             switch (type)
             {
@@ -450,11 +455,24 @@ specific to the EmitterContext, specified by the Emittable type.
     {
         py::class_<value::ScalarDimension>(module, "Dimension", "A View type that wraps a _Valor instance and enforces a memory layout that represents a single value")
             .def(py::init<value::Role>(), "role"_a = value::Role::Input)
-            .def(py::init<const std::string&, value::Role>(), "name"_a, "role"_a = value::Role::Input)
+            .def(py::init([](const std::string& name, value::Role role, std::optional<int64_t> min, std::optional<int64_t> max, std::optional<int64_t> multipleOf) {
+                     value::ScalarDimension dim(name, role);
+                     dim.SetConstraints({ min, max, multipleOf });
+                     return dim;
+                 }),
+                 "name"_a = "",
+                 "role"_a = value::Role::Input,
+                 "min"_a = std::nullopt,
+                 "max"_a = std::nullopt,
+                 "multiple_of"_a = std::nullopt,
+                 "Creates a named dimension. The optional min, max, and multiple_of constraints are promises about the runtime value that the compiler uses to eliminate bounds checks and boundary loops")
             .def(py::init<value::Value, const std::string&, value::Role>(), "value"_a, "name"_a = "", "role"_a = value::Role::Input)
             .def_property("name", &value::ScalarDimension::GetName, &value::ScalarDimension::SetName)
             .def_property_readonly("type", &value::ScalarDimension::GetType)
             .def_property_readonly("role", &value::ScalarDimension::GetRole)
+            .def_property_readonly("min", [](const value::ScalarDimension& dim) { return dim.GetConstraints().min; })
+            .def_property_readonly("max", [](const value::ScalarDimension& dim) { return dim.GetConstraints().max; })
+            .def_property_readonly("multiple_of", [](const value::ScalarDimension& dim) { return dim.GetConstraints().multipleOf; })
             .def_property("_value", &value::ScalarDimension::GetValue, &value::ScalarDimension::SetValue);
 
         py::implicitly_convertible<value::Value, value::ScalarDimension>();
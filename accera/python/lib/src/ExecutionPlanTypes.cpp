@@ -125,7 +125,15 @@ namespace
             .def_readwrite("blocks_per_SM", &value::targets::GPU::blocksPerSM);
 
         py::class_<util::MemoryAffineCoefficients>(module, "_MemoryAffineCoefficients", "Used for mapping Array or Cache dimensions to memory locations")
-            .def(py::init<std::vector<int64_t>, int64_t>(), "coefficients"_a, "offset"_a = 0);
+            .def(py::init([](std::vector<int64_t> coefficients, int64_t offset, std::vector<int64_t> blockSizes, std::vector<int64_t> blockOrder, int64_t padding, std::vector<int64_t> swizzle) {
+                     return util::MemoryAffineCoefficients{ coefficients, offset, blockSizes, blockOrder, padding, swizzle };
+                 }),
+                 "coefficients"_a,
+                 "offset"_a = 0,
+                 "block_sizes"_a = std::vector<int64_t>{},
+                 "block_order"_a = std::vector<int64_t>{},
+                 "padding"_a = 0,
+                 "swizzle"_a = std::vector<int64_t>{});
 
         py::class_<util::DimensionOrder>(module, "_DimensionOrder", "Describes the physical order of Array or Cache dimensions as a permutation of the logical order")
             .def(py::init<std::vector<int64_t>>(), "order"_a);
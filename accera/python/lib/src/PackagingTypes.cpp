@@ -180,6 +180,22 @@ Args:
             .def("addTag", &value::FunctionDeclaration::AddTag, "addTag"_a, py::return_value_policy::reference_internal, "A tag to add to a function as an attribute.")
             .def("baseName", &value::FunctionDeclaration::BaseName, "baseName"_a, py::return_value_policy::reference_internal, "Sets the base name for this function to use as an alias in the generated header file.")
             .def("outputVerifiers", &value::FunctionDeclaration::OutputVerifiers, "outputVerifiers"_a, py::return_value_policy::reference_internal, "Sets the verification functions for output checking, one per output argument.")
+            .def("verificationSamples", &value::FunctionDeclaration::VerificationSamples, "samples"_a, py::return_value_policy::reference_internal, "Sets the approximate number of output elements to sample when checking outputs.")
+            .def("streaming", &value::FunctionDeclaration::Streaming, "dim_arg_index"_a, "tile_size"_a, py::return_value_policy::reference_internal, "Requests a streaming driver that calls this function on tiles of the arrays sized by a dimension argument.")
+            .def("asyncEntry", &value::FunctionDeclaration::AsyncEntry, "async_entry"_a, py::return_value_policy::reference_internal, "Sets whether an asynchronous entry point that runs this function on its own thread is emitted.")
+            .def(
+                "argumentConstraints", [](value::FunctionDeclaration& fn, const std::vector<std::optional<value::ScalarDimension>>& dims) -> value::FunctionDeclaration& {
+                    std::vector<value::DimensionConstraints> constraints;
+                    constraints.reserve(dims.size());
+                    for (const auto& dim : dims)
+                    {
+                        constraints.push_back(dim ? dim->GetConstraints() : value::DimensionConstraints{});
+                    }
+                    return fn.ArgumentConstraints(constraints);
+                },
+                "dims"_a,
+                py::return_value_policy::reference_internal,
+                "Sets the declared range constraints of each argument, with None for arguments that are not constrained dimensions.")
             .def(
                 "define", [](value::FunctionDeclaration& fn, std::function<std::optional<value::Value>(std::vector<value::Value>)> defFn) -> value::FunctionDeclaration& {
                     (void)fn.Define(defFn);
@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) Microsoft Corporation. All rights reserved.
+//  Licensed under the MIT License. See LICENSE in the project root for license information.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "AcceraTypes.h"
+
+#include <pybind11/numpy.h>
+
+#include <runtime/include/Random.h>
+
+namespace py = pybind11;
+
+using namespace pybind11::literals;
+
+namespace accera::python::lang
+{
+void DefineRuntimeUtilities(py::module& module)
+{
+    module.def(
+              "_fill_random_values",
+              [](py::array_t<float, py::array::c_style> buffer, uint64_t seed, uint64_t offset, float lo, float hi) {
+                  auto data = buffer.mutable_data();
+                  auto size = static_cast<uint64_t>(buffer.size());
+                  py::gil_scoped_release release;
+                  FillRandomValues(data, size, seed, offset, lo, hi);
+              },
+              "buffer"_a,
+              "seed"_a,
+              "offset"_a,
+              "lo"_a,
+              "hi"_a,
+              "Fills a contiguous float32 array in place with uniformly distributed values in [lo, hi)")
+        .def(
+            "_fill_random_int_values",
+            [](py::array_t<int, py::array::c_style> buffer, uint64_t seed, uint64_t offset, int lo, int hi) {
+                auto data = buffer.mutable_data();
+                auto size = static_cast<uint64_t>(buffer.size());
+                py::gil_scoped_release release;
+                FillRandomIntValues(data, size, seed, offset, lo, hi);
+            },
+            "buffer"_a,
+            "seed"_a,
+            "offset"_a,
+            "lo"_a,
+            "hi"_a,
+            "Fills a contiguous int32 array in place with uniformly distributed values in [lo, hi]");
+}
+} // namespace accera::python::lang
@@ -33,6 +33,7 @@ PYBIND11_MODULE(_lang_python, m)
     lang::DefineSchedulingTypes(lang_mod);
     lang::DefinePackagingTypes(m, lang_mod);
     lang::DefineOperations(lang_mod);
+    lang::DefineRuntimeUtilities(m);
 
 #ifdef ACCERA_VERSION_INFO
     m.attr("__version__") = MACRO_STRINGIFY(ACCERA_VERSION_INFO);
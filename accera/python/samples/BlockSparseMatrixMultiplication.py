@@ -0,0 +1,76 @@
+####################################################################################################
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See LICENSE in the project root for license information.
+####################################################################################################
+
+from typing import Sequence, NamedTuple
+from accera import Array, Nest, Role, Target
+
+
+class Options(NamedTuple):
+    BlockShape: Sequence[int] = [1, 8]
+    NumRowsInKernel: int = 6
+    MaxUnrolledBlocks: int = 16
+
+
+def BlockSparseMLAS(A: Array, C: Array, weights: "numpy.ndarray", opts=Options(), target=Target.HOST):
+    """C += A @ weights, where `weights` is a constant block-sparse matrix known at build time
+
+    The non-zero blocks of `weights` are packed into a compressed buffer that is embedded in the package, along with the
+    row and column offsets of each block. The nest only iterates over the non-zero blocks, and each block is computed
+    with a dense microkernel: rows of A are unrolled and the columns of a block are vectorized. Patterns with few
+    non-zero blocks also unroll the loop over the blocks.
+
+    Returns the plan and the arguments of the function, (A, C).
+    """
+    import numpy as np
+
+    if len(A.shape) != 2 or len(C.shape) != 2 or weights.ndim != 2:
+        raise RuntimeError("Invalid shapes for arguments")
+
+    M, K = A.shape
+    _K_W, N = weights.shape
+    if K != _K_W or tuple(C.shape) != (M, N):
+        raise RuntimeError("Incompatible shapes for arguments")
+
+    block_rows, block_cols = opts.BlockShape
+    if K % block_rows or N % block_cols:
+        raise RuntimeError(f"The weights of shape {weights.shape} can't be divided into blocks of {tuple(opts.BlockShape)}")
+
+    # Find the non-zero blocks, ordered by block column so that the updates of a column of C are consecutive
+    blocks = weights.reshape(K // block_rows, block_rows, N // block_cols, block_cols).swapaxes(1, 2)
+    nonzero = np.argwhere(np.any(blocks != 0, axis=(2, 3)))
+    nonzero = nonzero[np.lexsort((nonzero[:, 0], nonzero[:, 1]))]
+    num_blocks = len(nonzero)
+    if not num_blocks:
+        raise RuntimeError("The weights don't have any non-zero blocks")
+
+    packed = Array(
+        role=Role.CONST, element_type=A.element_type, data=np.ascontiguousarray(blocks[nonzero[:, 0], nonzero[:, 1]])
+    )
+    row_offsets = Array(role=Role.CONST, data=(nonzero[:, 0] * block_rows).astype(np.int64))
+    col_offsets = Array(role=Role.CONST, data=(nonzero[:, 1] * block_cols).astype(np.int64))
+
+    nest = Nest(shape=(num_blocks, M, block_rows, block_cols))
+    b, i, k, j = nest.get_indices()
+
+    @nest.iteration_logic
+    def _():
+        C[i, col_offsets[b] + j] += A[i, row_offsets[b] + k] * packed[b, k, j]
+
+    schedule = nest.create_schedule()
+
+    num_rows_in_kernel = min(opts.NumRowsInKernel, M)
+    ii = schedule.split(i, num_rows_in_kernel)
+    schedule.reorder(b, i, k, ii, j)
+
+    plan = schedule.create_plan(target)
+
+    if num_blocks <= opts.MaxUnrolledBlocks:
+        plan.unroll(b)
+    plan.unroll(k)
+    plan.unroll(ii)
+    if target.vectorization_info:
+        plan.vectorize(j)
+
+    return plan, (A, C)
@@ -1,2 +1,3 @@
 from .MatrixMultiplication import MLAS, Options as MLASOptions
 from .OfflineCacheMatrixMultiplication import EmitTimeCacheMLAS, RuntimeInitCacheMLAS, Options as OfflineCacheMLASOptions
+from .BlockSparseMatrixMultiplication import BlockSparseMLAS, Options as BlockSparseMLASOptions
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #if defined(__cplusplus)
 extern "C" {
 #endif // defined(__cplusplus)
@@ -19,6 +21,12 @@ void GetNextRandomIntValue(int*, int lo, int hi);
 void GetNextNRandomValues(float* buffer, unsigned int N);
 void GetNextNRandomIntValues(int* buffer, int lo, int hi, unsigned int N);
 
+// Stateless fills from a counter-based (Philox4x32-10) stream: element i of the buffer
+// receives the value at position (offset + i) of the stream selected by seed, so the
+// results are identical regardless of how the work is split across threads.
+void FillRandomValues(float* buffer, uint64_t N, uint64_t seed, uint64_t offset, float lo, float hi);
+void FillRandomIntValues(int* buffer, uint64_t N, uint64_t seed, uint64_t offset, int lo, int hi);
+
 #if defined(__cplusplus)
 } // extern "C"
 #endif // defined(__cplusplus)
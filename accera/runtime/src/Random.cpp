@@ -8,41 +8,163 @@
 
 #include "Random.h"
 
-#include <random>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 
-static std::default_random_engine RandomEngine;
+namespace
+{
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+constexpr uint32_t PhiloxM0 = 0xD2511F53;
+constexpr uint32_t PhiloxM1 = 0xCD9E8D57;
+constexpr uint32_t PhiloxW0 = 0x9E3779B9;
+constexpr uint32_t PhiloxW1 = 0xBB67AE85;
+constexpr int PhiloxRounds = 10;
+
+// Each counter block produces 4 values. Blocks are generated in batches laid out as
+// structure-of-arrays so that the rounds vectorize across the batch.
+constexpr uint64_t ValuesPerBlock = 4;
+constexpr uint64_t BatchBlocks = 16;
+constexpr uint64_t BatchValues = BatchBlocks * ValuesPerBlock;
+
+// Minimum number of values each worker thread fills
+constexpr uint64_t ParallelGrainSize = 1 << 16;
+
+std::atomic<uint64_t> RandomSeed{ 0 };
+std::atomic<uint64_t> RandomOffset{ 0 };
+
+void GeneratePhiloxBatch(uint64_t firstBlock, uint64_t seed, uint32_t* out)
+{
+    uint32_t c0[BatchBlocks], c1[BatchBlocks], c2[BatchBlocks], c3[BatchBlocks];
+    for (uint64_t b = 0; b < BatchBlocks; ++b)
+    {
+        c0[b] = static_cast<uint32_t>(firstBlock + b);
+        c1[b] = static_cast<uint32_t>((firstBlock + b) >> 32);
+        c2[b] = 0;
+        c3[b] = 0;
+    }
+
+    auto k0 = static_cast<uint32_t>(seed);
+    auto k1 = static_cast<uint32_t>(seed >> 32);
+    for (int round = 0; round < PhiloxRounds; ++round)
+    {
+        for (uint64_t b = 0; b < BatchBlocks; ++b)
+        {
+            uint64_t p0 = static_cast<uint64_t>(PhiloxM0) * c0[b];
+            uint64_t p1 = static_cast<uint64_t>(PhiloxM1) * c2[b];
+            uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[b] ^ k0;
+            uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[b] ^ k1;
+            c1[b] = static_cast<uint32_t>(p1);
+            c3[b] = static_cast<uint32_t>(p0);
+            c0[b] = n0;
+            c2[b] = n2;
+        }
+        k0 += PhiloxW0;
+        k1 += PhiloxW1;
+    }
+
+    for (uint64_t b = 0; b < BatchBlocks; ++b)
+    {
+        out[b * ValuesPerBlock + 0] = c0[b];
+        out[b * ValuesPerBlock + 1] = c1[b];
+        out[b * ValuesPerBlock + 2] = c2[b];
+        out[b * ValuesPerBlock + 3] = c3[b];
+    }
+}
+
+// Fills buffer[begin, end) with convert(bits) where bits is the value at stream position offset + i
+template <typename T, typename ConvertFn>
+void FillRange(T* buffer, uint64_t begin, uint64_t end, uint64_t seed, uint64_t offset, ConvertFn convert)
+{
+    uint32_t bits[BatchValues];
+    uint64_t position = offset + begin;
+    uint64_t idx = begin;
+    while (idx < end)
+    {
+        uint64_t batchStart = position / BatchValues * BatchValues;
+        GeneratePhiloxBatch(batchStart / ValuesPerBlock, seed, bits);
+
+        uint64_t first = position - batchStart;
+        uint64_t count = std::min(BatchValues - first, end - idx);
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            buffer[idx + i] = convert(bits[first + i]);
+        }
+        idx += count;
+        position += count;
+    }
+}
+
+template <typename T, typename ConvertFn>
+void ParallelFill(T* buffer, uint64_t N, uint64_t seed, uint64_t offset, ConvertFn convert)
+{
+    uint64_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t numThreads = std::min(maxThreads, (N + ParallelGrainSize - 1) / ParallelGrainSize);
+    if (numThreads <= 1)
+    {
+        FillRange(buffer, 0, N, seed, offset, convert);
+        return;
+    }
+
+    // Split on batch boundaries so that no batch is generated twice
+    uint64_t chunk = (N + numThreads - 1) / numThreads;
+    chunk = (chunk + BatchValues - 1) / BatchValues * BatchValues;
+
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads);
+    for (uint64_t begin = 0; begin < N; begin += chunk)
+    {
+        uint64_t end = std::min(N, begin + chunk);
+        workers.emplace_back([=] { FillRange(buffer, begin, end, seed, offset, convert); });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+} // namespace
+
+void FillRandomValues(float* val, uint64_t N, uint64_t seed, uint64_t offset, float lo, float hi)
+{
+    // Use the upper 24 bits to get evenly spaced floats in [0, 1)
+    const float scale = (hi - lo) / 16777216.0f;
+    ParallelFill(val, N, seed, offset, [=](uint32_t bits) {
+        return lo + static_cast<float>(bits >> 8) * scale;
+    });
+}
+
+void FillRandomIntValues(int* val, uint64_t N, uint64_t seed, uint64_t offset, int lo, int hi)
+{
+    // Values are in the closed range [lo, hi], matching std::uniform_int_distribution
+    const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(hi) - lo + 1);
+    ParallelFill(val, N, seed, offset, [=](uint32_t bits) {
+        return static_cast<int>(lo + static_cast<int64_t>((bits * range) >> 32));
+    });
+}
 
 void GetNextRandomValue(float* val)
 {
-    std::uniform_real_distribution<> distribution(-1.0f, 1.0f);
-    *val = distribution(RandomEngine);
+    GetNextNRandomValues(val, 1);
 }
 
 void GetNextRandomIntValue(int* val, int lo, int hi)
 {
-    std::uniform_int_distribution<> distribution(lo, hi);
-    *val = distribution(RandomEngine);
+    GetNextNRandomIntValues(val, lo, hi, 1);
 }
 
 void GetNextNRandomValues(float* val, unsigned int N)
 {
-    std::uniform_real_distribution<> distribution(-1.0f, 1.0f);
-    for (unsigned int idx = 0; idx < N; ++idx)
-    {
-        val[idx] = distribution(RandomEngine);
-    }
+    FillRandomValues(val, N, RandomSeed, RandomOffset.fetch_add(N), -1.0f, 1.0f);
 }
 
 void GetNextNRandomIntValues(int* val, int lo, int hi, unsigned int N)
 {
-    std::uniform_int_distribution<> distribution(lo, hi);
-    for (unsigned int idx = 0; idx < N; ++idx)
-    {
-        val[idx] = distribution(RandomEngine);
-    }
+    FillRandomIntValues(val, N, RandomSeed, RandomOffset.fetch_add(N), lo, hi);
 }
 
 void ResetRandomEngine(unsigned int seed)
 {
-    RandomEngine.seed(seed);
+    RandomSeed = seed;
+    RandomOffset = 0;
 }
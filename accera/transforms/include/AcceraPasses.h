@@ -6,9 +6,14 @@
 
 #pragma once
 
+#include "accera/GemmToLoopNest.h"
+#include "affine/AccumulatorPromotion.h"
 #include "affine/AffineSimplifications.h"
 #include "affine/AffineLoopNormalize.h"
+#include "affine/AtomicPrivatization.h"
 #include "affine/CheckBoundsPass.h"
+#include "affine/IndexStrengthReduction.h"
+#include "argo/ArgoToLoopNest.h"
 #include "exec/ExecutionPlanToAffineLoweringPass.h"
 #include "gpu/AcceraToGPUPass.h"
 #include "gpu/AcceraVulkanPasses.h"
@@ -73,6 +78,7 @@ struct AcceraPassPipelineOptions : mlir::PassPipelineOptions<AcceraPassPipelineO
 {
     Option<bool> dumpPasses{ *this, "dump-passes", llvm::cl::init(false) };
     Option<bool> gpuOnly{ *this, "gpu-only", llvm::cl::init(false) };
+    Option<bool> cppSource{ *this, "cpp-source", llvm::cl::desc("Stop lowering host code at the SCF level so it can be emitted as C++ source"), llvm::cl::init(false) };
     Option<bool> dumpIntraPassIR{ *this, "dump-intra-pass-ir", llvm::cl::init(false) };
     Option<std::string> basename{ *this, "basename", llvm::cl::init(std::string{}) };
     Option<std::string> target{ *this, "target", llvm::cl::init("host") };
@@ -95,6 +101,9 @@ struct AcceraPassPipelineOptions : mlir::PassPipelineOptions<AcceraPassPipelineO
     Option<bool> printVecOpDetails{ *this, "print-vec-details", llvm::cl::init(false) };
     Option<bool> writeBarrierGraph{ *this, "barrier-opt-dot", llvm::cl::init(false) };
     Option<std::string> barrierGraphFilename{ *this, "barrier-opt-dot-filename", llvm::cl::init(std::string{}) };
+    Option<bool> workspaceAllocator{ *this, "workspace-allocator", llvm::cl::init(false) };
+    Option<int64_t> hugePageThreshold{ *this, "huge-page-threshold", llvm::cl::init(0) };
+    Option<int64_t> numThreads{ *this, "num-threads", llvm::cl::desc("Threads used by the loop nests planned by the compiler (argo ops, GEMMs), or 0 to leave them sequential"), llvm::cl::init(0) };
 };
 
 void addAcceraToLLVMPassPipeline(mlir::OpPassManager& pm, const AcceraPassPipelineOptions& options);
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) Microsoft Corporation. All rights reserved.
+//  Licensed under the MIT License. See LICENSE in the project root for license information.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+// fwd decls
+namespace mlir
+{
+class Pass;
+template <typename OpT>
+class OperationPass;
+
+class RewritePatternSet;
+} // namespace mlir
+
+namespace accera
+{
+namespace ir::value
+{
+    class ValueFuncOp;
+}
+
+namespace value
+{
+    struct TargetDevice;
+}
+
+namespace transforms::rc
+{
+    // Target parameters for the GEMM lowering. The tiling itself comes from a table of tuned schedules,
+    // selected by the shape of the problem.
+    struct GemmToLoopNestOptions
+    {
+        int64_t vectorBytes = 32;
+        int64_t vectorUnits = 16;
+
+        // Threads used for the outermost loop of large problems, or 0 to leave them sequential
+        int64_t numThreads = 0;
+    };
+
+    GemmToLoopNestOptions GetGemmToLoopNestOptions(const accera::value::TargetDevice& target, int64_t numThreads);
+
+    void populateGemmToLoopNestPatterns(mlir::RewritePatternSet& patterns, const GemmToLoopNestOptions& options);
+    std::unique_ptr<mlir::OperationPass<accera::ir::value::ValueFuncOp>> createGemmToLoopNestPass(const GemmToLoopNestOptions& options);
+    std::unique_ptr<mlir::OperationPass<accera::ir::value::ValueFuncOp>> createGemmToLoopNestPass();
+} // namespace transforms::rc
+} // namespace accera
@@ -0,0 +1,18 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) Microsoft Corporation. All rights reserved.
+//  Licensed under the MIT License. See LICENSE in the project root for license information.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+
+namespace mlir
+{
+class Pass;
+} // namespace mlir
+
+namespace accera::transforms::affine
+{
+std::unique_ptr<mlir::Pass> createAtomicPrivatizationPass();
+} // namespace accera::transforms::affine
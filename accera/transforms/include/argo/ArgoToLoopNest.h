@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) Microsoft Corporation. All rights reserved.
+//  Licensed under the MIT License. See LICENSE in the project root for license information.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+// fwd decls
+namespace mlir
+{
+class Pass;
+template <typename OpT>
+class OperationPass;
+
+class RewritePatternSet;
+} // namespace mlir
+
+namespace accera
+{
+namespace ir::value
+{
+    class ValueFuncOp;
+}
+
+namespace value
+{
+    struct TargetDevice;
+}
+
+namespace transforms::argo
+{
+    // The plan applied to the loop nest templates that argo ops are lowered to
+    struct ArgoToLoopNestOptions
+    {
+        // Vector register size and count, as in Target.vector_bytes and Target.vector_registers
+        int64_t vectorBytes = 32;
+        int64_t vectorUnits = 16;
+
+        // Threads used for the outermost loop of each nest, or 0 to leave the nests sequential
+        int64_t numThreads = 0;
+
+        // Matmul tile: the rows of C computed by one micro-kernel, and the panel of B that is packed into a cache
+        int64_t matmulTileM = 6;
+        int64_t matmulTileN = 256;
+        int64_t matmulTileK = 128;
+    };
+
+    // The default plan for a target, e.g. 64-byte vectors with AVX-512, using the number of threads of the target
+    ArgoToLoopNestOptions GetArgoToLoopNestOptions(const accera::value::TargetDevice& target, int64_t numThreads);
+
+    void populateArgoToLoopNestPatterns(mlir::RewritePatternSet& patterns, const ArgoToLoopNestOptions& options);
+    std::unique_ptr<mlir::OperationPass<accera::ir::value::ValueFuncOp>> createArgoToLoopNestPass(const ArgoToLoopNestOptions& options);
+    std::unique_ptr<mlir::OperationPass<accera::ir::value::ValueFuncOp>> createArgoToLoopNestPass();
+} // namespace transforms::argo
+} // namespace accera
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace mlir
@@ -16,7 +17,30 @@ class OperationPass;
 
 } // namespace mlir
 
-namespace accera::transforms
+namespace accera
 {
-std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createEmitDebugFunctionPass();
-} // namespace accera::transforms
+namespace value
+{
+    struct TargetDevice;
+}
+
+namespace transforms
+{
+    // Target parameters for the plan of the reference implementation in debug functions
+    struct EmitDebugFunctionOptions
+    {
+        // Vector register size and count, used to vectorize the innermost output index
+        int64_t vectorBytes = 32;
+        int64_t vectorUnits = 16;
+
+        // Threads used for the outermost output index, or 0 to leave the reference sequential
+        int64_t numThreads = 0;
+    };
+
+    // The reference plan for a target uses the same vector shape as the loop nest templates (see GetLoopNestTargetInfo)
+    EmitDebugFunctionOptions GetEmitDebugFunctionOptions(const accera::value::TargetDevice& target, int64_t numThreads);
+
+    std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createEmitDebugFunctionPass(const EmitDebugFunctionOptions& options);
+    std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createEmitDebugFunctionPass();
+} // namespace transforms
+} // namespace accera
@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) Microsoft Corporation. All rights reserved.
+//  Licensed under the MIT License. See LICENSE in the project root for license information.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <ir/include/exec/VectorizationInfo.h>
+#include <ir/include/nest/LoopNestOps.h>
+
+#include <mlir/IR/PatternMatch.h>
+#include <mlir/IR/Value.h>
+
+#include <vector>
+
+namespace accera::value
+{
+struct TargetDevice;
+}
+
+namespace accera::transforms
+{
+// The vector registers and threads that loop nest templates are planned for
+struct LoopNestTargetInfo
+{
+    // Vector register size and count, as in Target.vector_bytes and Target.vector_registers
+    int64_t vectorBytes = 32;
+    int64_t vectorUnits = 16;
+
+    // Threads used for the outermost loop of each nest, or 0 to leave the nests sequential
+    int64_t numThreads = 0;
+};
+
+// The vector registers of a target's widest vector extension, e.g. 64-byte vectors with AVX-512, and `numThreads`
+LoopNestTargetInfo GetLoopNestTargetInfo(const accera::value::TargetDevice& target, int64_t numThreads);
+
+// A loop nest with a single kernel, and the symbolic indices of its dimensions
+struct LoopNestTemplate
+{
+    ir::loopnest::NestOp nest;
+    ir::loopnest::ScheduleOp schedule;
+    std::vector<ir::loopnest::Index> indices;
+};
+
+// Creates a nest over `sizes` whose kernel is built by `body` from the symbolic indices of the nest
+LoopNestTemplate MakeLoopNestTemplate(mlir::PatternRewriter& rewriter, mlir::ArrayRef<int64_t> sizes, llvm::function_ref<void(mlir::OpBuilder&, mlir::Location, mlir::ArrayRef<mlir::Value>)> body);
+
+// The size of an element of a scalar type, rounded up to a byte
+int64_t GetElementBytes(mlir::Type elementType);
+
+// Whether a nest over `shape` is large enough, and its outermost dimension long enough, to be worth running on `numThreads` threads
+bool ShouldParallelizeLoopNest(mlir::ArrayRef<int64_t> shape, int64_t numThreads);
+
+// Scheduling helpers, equivalent to plan.vectorize(), plan.parallelize() and plan.cache() in the DSL
+void VectorizeLoop(ir::loopnest::ScheduleOp schedule, ir::loopnest::Index index, const ir::executionPlan::VectorizationInfo& vectorizationInfo);
+void ParallelizeLoop(ir::loopnest::ScheduleOp schedule, ir::loopnest::Index index, int64_t numThreads);
+void AddActiveBlockCache(ir::loopnest::ScheduleOp schedule, mlir::Value input, ir::loopnest::Index index, const ir::executionPlan::VectorizationInfo& vectorizationInfo);
+
+// The plan for elementwise nests: vectorize the innermost dimension, and parallelize the outermost one if the nest is large enough
+void PlanElementwiseLoopNest(LoopNestTemplate& loopNest, mlir::ArrayRef<int64_t> shape, int64_t elementBytes, const ir::executionPlan::VectorizationInfo& vectorizationInfo, int64_t numThreads);
+} // namespace accera::transforms
@@ -26,6 +26,8 @@
 #include <llvm/IR/ConstantRange.h>
 #include <llvm/Support/raw_os_ostream.h>
 
+#include <optional>
+
 namespace accera::ir::util
 {
 
@@ -78,7 +80,14 @@ private:
     RangeValue resolveRangeValue(mlir::AffineForOp op);
     RangeValue resolveRangeValue(mlir::AffineApplyOp op);
     RangeValue resolveRangeValue(mlir::scf::ForOp op);
+    RangeValue resolveRangeValue(mlir::BlockArgument arg);
     RangeValue resolveRangeValue(mlir::Operation* op);
+    RangeValue resolveRemainderRange(llvm::Instruction::BinaryOps binOp, mlir::Operation* op);
+    RangeValue resolveAffineExprRange(mlir::AffineExpr expr, unsigned numDims, mlir::ValueRange operands);
+
+    void addValue(mlir::Value value);
+    std::optional<int64_t> getKnownMultiple(mlir::Value value) const;
+    std::optional<int64_t> getKnownMultiple(mlir::AffineExpr expr, unsigned numDims, mlir::ValueRange operands) const;
 
     void addSCFParallelOp(mlir::scf::ParallelOp op);
     void addAffineParallelOp(mlir::AffineParallelOp op);
@@ -39,6 +39,7 @@ void populateGlobalValueToLLVMNonMemPatterns(mlir::LLVMTypeConverter& typeConver
 void populateLocalValueToLLVMNonMemPatterns(mlir::LLVMTypeConverter& typeConverter, mlir::RewritePatternSet& patterns, accera::value::TargetDevice deviceInfo);
 void populateValueToLLVMMemPatterns(mlir::LLVMTypeConverter& typeConverter, mlir::RewritePatternSet& patterns);
 void populateReshapeOpToLLVMMemPatterns(mlir::LLVMTypeConverter& typeConverter, mlir::RewritePatternSet& patterns);
+void populateWorkspaceAllocatorPatterns(mlir::LLVMTypeConverter& typeConverter, mlir::RewritePatternSet& patterns);
 
 const mlir::LowerToLLVMOptions& GetDefaultAcceraLLVMOptions(mlir::MLIRContext* context);
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createValueToLLVMPass(mlir::LowerToLLVMOptions options);
@@ -50,5 +51,7 @@ std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createValueToLLVMPass(bool
                                                                            bool useAlignedAlloc,
                                                                            llvm::DataLayout dataLayout,
                                                                            accera::value::TargetDevice deviceInfo = {},
-                                                                           const IntraPassSnapshotOptions& options = {});
+                                                                           const IntraPassSnapshotOptions& options = {},
+                                                                           bool useWorkspaceAllocator = false,
+                                                                           int64_t hugePageThreshold = 0);
 } // namespace accera::transforms::value
@@ -154,13 +154,15 @@ void addAcceraToLLVMPassPipeline(OpPassManager& pm, const AcceraPassPipelineOpti
     accera::value::ExecutionRuntime execRuntime = options.runtime;
 
     PassManagerAdaptor pmAdaptor(pm, options.dumpPasses.getValue(), options.basename);
-    pmAdaptor.addPass(createEmitDebugFunctionPass());
+    pmAdaptor.addPass(createEmitDebugFunctionPass(GetEmitDebugFunctionOptions(accera::value::GetTargetDevice(options.target), options.numThreads)));
 
     auto valueFuncOpPM = pmAdaptor.nestPassManager([&]() -> OpPassManager& { return pm.nest<v::ValueModuleOp>().nest<v::ValueFuncOp>(); });
 
     // Can't use ValueSimplify here because ExecToAffine doesn't know how to handle "simplified" ops (memref::SubView, etc.)
     // valueFuncOpPM.addPass(value::createValueSimplifyPass());
     valueFuncOpPM.addPass(createCanonicalizerPass());
+    valueFuncOpPM.addPass(rc::createGemmToLoopNestPass(rc::GetGemmToLoopNestOptions(accera::value::GetTargetDevice(options.target), options.numThreads)));
+    valueFuncOpPM.addPass(argo::createArgoToLoopNestPass(argo::GetArgoToLoopNestOptions(accera::value::GetTargetDevice(options.target), options.numThreads)));
     valueFuncOpPM.addPass(loopnest::createLoopNestToValueFuncPass({ { options.dumpIntraPassIR.getValue(), options.basename + "LoopNestToValueFuncPass_Subpasses" }, options.printLoops.getValue(), options.printVecOpDetails.getValue() }));
 
     pmAdaptor.addPass(value::createValueFuncToTargetPass({ options.dumpIntraPassIR.getValue(), options.basename + "ValueFuncToTargetPass_Subpasses" }));
@@ -186,12 +188,19 @@ void addAcceraToLLVMPassPipeline(OpPassManager& pm, const AcceraPassPipelineOpti
     funcOpPM.addPass(createCanonicalizerPass());
     funcOpPM.addPass(createLoopInvariantCodeMotionPass());
     funcOpPM.addPass(createCSEPass());
+    // Turn contended scatter-reductions in parallel loops into private partial results before they're lowered to atomics
+    funcOpPM.addPass(affine::createAtomicPrivatizationPass());
+    // Keep vectorized accumulators and invariant operands in registers, then hoist the broadcasts that used them
+    funcOpPM.addPass(affine::createAccumulatorPromotionPass());
+    funcOpPM.addPass(createLoopInvariantCodeMotionPass());
+    funcOpPM.addPass(createCSEPass());
 
     pmAdaptor.addPass(value::createValueToStdPass(options.enableProfile));
     pmAdaptor.addPass(value::createRangeValueOptimizePass());
     pmAdaptor.addPass(createCanonicalizerPass());
     pmAdaptor.addPass(createCSEPass());
 
+    bool isGPU = false;
     if (execRuntime == accera::value::ExecutionRuntime::VULKAN)
     {
         // The spirv lowering doesn't generate affine dialect ops, and the SPIRV dialect doesn't play nicely with them, so lower the affine ops before running the GPU lowering
@@ -202,7 +211,7 @@ void addAcceraToLLVMPassPipeline(OpPassManager& pm, const AcceraPassPipelineOpti
     else
     {
         pmAdaptor.addPass(createGpuKernelOutliningPass());
-        const auto isGPU = addGPUPasses(pmAdaptor, execRuntime, options);
+        isGPU = addGPUPasses(pmAdaptor, execRuntime, options);
 
         // lowering to runtimes other than SPIRV generates affine dialect ops so optimize and lower those now
         simplifyAndLowerAffine(pmAdaptor);
@@ -214,9 +223,10 @@ void addAcceraToLLVMPassPipeline(OpPassManager& pm, const AcceraPassPipelineOpti
                 pmAdaptor.addPass(createGPUToROCDLPass());
             }
         }
-        else
+        else if (!options.cppSource)
         {
             // Convert to OMP when in non-GPU scenarios
+            // (C++ source emission prints scf.parallel as an OpenMP pragma instead)
             pmAdaptor.addPass(createConvertSCFToOpenMPPass());
         }
     }
@@ -227,6 +237,14 @@ void addAcceraToLLVMPassPipeline(OpPassManager& pm, const AcceraPassPipelineOpti
     pmAdaptor.addPass(createCanonicalizerPass());
     pmAdaptor.addPass(createCSEPass());
 
+    if (!isGPU && execRuntime != accera::value::ExecutionRuntime::VULKAN)
+    {
+        // Carry flattened cache indices across loop iterations now that the loop-invariant parts are hoisted
+        pmAdaptor.addPass(affine::createIndexStrengthReductionPass());
+        pmAdaptor.addPass(createCanonicalizerPass());
+        pmAdaptor.addPass(createCSEPass());
+    }
+
     if (execRuntime == accera::value::ExecutionRuntime::VULKAN)
     {
         OpPassManager& spirvModulePM = pm.nest<spirv::ModuleOp>();
@@ -248,6 +266,8 @@ void addAcceraToLLVMPassPipeline(OpPassManager& pm, const AcceraPassPipelineOpti
         if (options.gpuOnly) return;
     }
 
+    if (options.cppSource) return;
+
     funcOpPM.addPass(createConvertVectorToSCFPass(
         VectorTransferToSCFOptions{} /*.setLowerPermutationMaps(true) .setLowerTensors(true).setUnroll(true) */));
     pmAdaptor.addPass(createConvertSCFToCFPass());
@@ -273,7 +293,9 @@ void addAcceraToLLVMPassPipeline(OpPassManager& pm, const AcceraPassPipelineOpti
         /* useAlignedAlloc = */ true,
         /* dataLayout = */ llvm::DataLayout(accera::value::GetTargetDevice(options.target).dataLayout),
         /* deviceInfo = */ accera::value::GetTargetDevice(options.target),
-        { options.dumpIntraPassIR.getValue(), options.basename + "ValueToLLVM_Subpasses" }));
+        { options.dumpIntraPassIR.getValue(), options.basename + "ValueToLLVM_Subpasses" },
+        /* useWorkspaceAllocator = */ options.workspaceAllocator,
+        /* hugePageThreshold = */ options.hugePageThreshold));
     pmAdaptor.addPass(createCanonicalizerPass());
     pmAdaptor.addPass(LLVM::createLegalizeForExportPass());
     pmAdaptor.addPass(value::createFunctionPointerResolutionPass());
@@ -0,0 +1,401 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) Microsoft Corporation. All rights reserved.
+//  Licensed under the MIT License. See LICENSE in the project root for license information.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "accera/GemmToLoopNest.h"
+
+#include "AcceraPasses.h"
+#include "util/LoopNestTemplates.h"
+
+#include <ir/include/accera/AcceraOps.h>
+#include <ir/include/exec/VectorizationInfo.h>
+#include <ir/include/nest/LoopNestOps.h>
+#include <ir/include/value/ValueDialect.h>
+
+#include <value/include/TargetDevice.h>
+
+#include <mlir/Dialect/Arithmetic/IR/Arithmetic.h>
+#include <mlir/IR/BuiltinTypes.h>
+#include <mlir/IR/PatternMatch.h>
+#include <mlir/Pass/Pass.h>
+#include <mlir/Transforms/GreedyPatternRewriteDriver.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace mlir;
+
+namespace lnir = accera::ir::loopnest;
+namespace rcir = accera::ir::rc;
+namespace vir = accera::ir::value;
+namespace xpir = accera::ir::executionPlan;
+namespace rctr = accera::transforms::rc;
+
+using accera::transforms::AddActiveBlockCache;
+using accera::transforms::GetElementBytes;
+using accera::transforms::LoopNestTemplate;
+using accera::transforms::MakeLoopNestTemplate;
+using accera::transforms::ParallelizeLoop;
+using accera::transforms::PlanElementwiseLoopNest;
+using accera::transforms::VectorizeLoop;
+
+namespace
+{
+enum class GemmShapeClass
+{
+    Small = 0,
+    SkinnyN, // C is a few vectors wide, e.g. matrix-vector products
+    SkinnyM, // C is a few rows tall, e.g. small-batch inference
+    Large,
+};
+
+enum class GemmParallelLoop
+{
+    None,
+    Rows,
+    Columns,
+};
+
+// A tuned schedule for a class of GEMM shapes. Sizes along N are in vectors, so that one table serves
+// every vector width, and 0 means the whole dimension.
+struct GemmSchedule
+{
+    int64_t kernelRows; // rows of C computed in registers by the micro-kernel
+    int64_t kernelVectors; // columns of C computed in registers by the micro-kernel
+    int64_t panelVectors; // columns of the panel of B
+    int64_t panelDepth; // rows of the panel of B
+    bool cachePanel; // pack the panel of B into a cache
+    GemmParallelLoop parallelLoop;
+};
+
+// Indexed by GemmShapeClass
+constexpr GemmSchedule kTunedGemmSchedules[] = {
+    /* Small   */ { 4, 2, 0, 0, false, GemmParallelLoop::None },
+    /* SkinnyN */ { 8, 1, 0, 0, false, GemmParallelLoop::Rows },
+    /* SkinnyM */ { 0, 2, 64, 256, false, GemmParallelLoop::Columns },
+    /* Large   */ { 6, 2, 32, 128, true, GemmParallelLoop::Columns },
+};
+
+// Problems that fit in L1 or that are too small to amortize starting threads
+constexpr int64_t kSmallGemmVolume = 64 * 64 * 64;
+constexpr int64_t kMinParallelGemmVolume = 1 << 18;
+constexpr int64_t kSkinnyRows = 8;
+
+GemmShapeClass ClassifyGemm(int64_t M, int64_t N, int64_t K, int64_t vectorSize)
+{
+    if (M * N * K <= kSmallGemmVolume)
+    {
+        return GemmShapeClass::Small;
+    }
+    if (N <= 2 * vectorSize)
+    {
+        return GemmShapeClass::SkinnyN;
+    }
+    if (M <= kSkinnyRows)
+    {
+        return GemmShapeClass::SkinnyM;
+    }
+    return GemmShapeClass::Large;
+}
+
+bool IsStaticMatrix(MemRefType type)
+{
+    return type && type.hasStaticShape() && type.getRank() == 2;
+}
+
+// alpha and beta are f32 attributes, converted here to the element type of the GEMM
+std::optional<Attribute> GetScalarAttr(Type elementType, double value)
+{
+    if (elementType.isa<FloatType>())
+    {
+        return FloatAttr::get(elementType, value);
+    }
+    if (elementType.isa<IntegerType>() && value == std::trunc(value))
+    {
+        return IntegerAttr::get(elementType, static_cast<int64_t>(value));
+    }
+    return std::nullopt;
+}
+
+// C is broadcast to the shape of Y as in numpy, e.g. a bias row of shape (N) or (1, N)
+bool IsBroadcastableTo(MemRefType type, int64_t M, int64_t N)
+{
+    if (!type || !type.hasStaticShape() || type.getRank() > 2)
+    {
+        return false;
+    }
+    std::vector<int64_t> shape = { M, N };
+    auto offset = 2 - type.getRank();
+    for (int64_t r = 0; r < type.getRank(); ++r)
+    {
+        auto size = type.getShape()[r];
+        if (size != 1 && size != shape[offset + r])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<Value> GetBroadcastIndices(OpBuilder& builder, Location loc, MemRefType type, ArrayRef<Value> indices)
+{
+    std::vector<Value> result;
+    auto offset = static_cast<int64_t>(indices.size()) - type.getRank();
+    for (int64_t r = 0; r < type.getRank(); ++r)
+    {
+        if (type.getShape()[r] == 1)
+        {
+            result.push_back(builder.create<arith::ConstantIndexOp>(loc, 0));
+        }
+        else
+        {
+            result.push_back(indices[offset + r]);
+        }
+    }
+    return result;
+}
+
+struct GemmOpLowering : public OpRewritePattern<rcir::GemmOp>
+{
+    GemmOpLowering(MLIRContext* context, const rctr::GemmToLoopNestOptions& options) :
+        OpRewritePattern(context),
+        _options(options)
+    {}
+
+    // Y = alpha * op(A) @ op(B) + beta * C
+    LogicalResult matchAndRewrite(rcir::GemmOp op, PatternRewriter& rewriter) const final
+    {
+        auto loc = op.getLoc();
+        auto A = op.A();
+        auto B = op.B();
+        auto C = op.C();
+        auto aType = A.getType().dyn_cast<MemRefType>();
+        auto bType = B.getType().dyn_cast<MemRefType>();
+        auto yType = op.Y().getType().dyn_cast<MemRefType>();
+
+        // Tensor operands are expected to have been bufferized by the front end
+        if (!IsStaticMatrix(aType) || !IsStaticMatrix(bType) || !IsStaticMatrix(yType))
+        {
+            return failure();
+        }
+
+        auto elementType = yType.getElementType();
+        if (aType.getElementType() != elementType || bType.getElementType() != elementType)
+        {
+            return failure();
+        }
+
+        auto transA = op.transA() != 0;
+        auto transB = op.transB() != 0;
+        auto M = aType.getShape()[transA ? 1 : 0];
+        auto K = aType.getShape()[transA ? 0 : 1];
+        auto N = bType.getShape()[transB ? 0 : 1];
+        if (bType.getShape()[transB ? 1 : 0] != K || yType.getShape()[0] != M || yType.getShape()[1] != N)
+        {
+            return failure();
+        }
+
+        auto alpha = op.alphaAttr().getValueAsDouble();
+        auto beta = op.betaAttr().getValueAsDouble();
+        auto alphaAttr = GetScalarAttr(elementType, alpha);
+        auto betaAttr = GetScalarAttr(elementType, beta);
+        if (!alphaAttr || !betaAttr)
+        {
+            return failure();
+        }
+
+        auto hasC = !C.getType().isa<NoneType>() && beta != 0.0;
+        auto cType = C.getType().dyn_cast<MemRefType>();
+        if (hasC && (!IsBroadcastableTo(cType, M, N) || cType.getElementType() != elementType))
+        {
+            return failure();
+        }
+
+        Value Y = rewriter.create<vir::AllocOp>(loc, yType);
+
+        // beta is folded into the fill of Y that the GEMM accumulates into
+        if (hasC)
+        {
+            auto fill = MakeLoopNestTemplate(rewriter, { M, N }, [&](OpBuilder& builder, Location loc, ArrayRef<Value> indices) {
+                Value value = builder.create<vir::LoadOp>(loc, elementType, C, GetBroadcastIndices(builder, loc, cType, indices));
+                if (beta != 1.0)
+                {
+                    auto scale = builder.create<arith::ConstantOp>(loc, *betaAttr);
+                    value = builder.create<vir::BinOp>(loc, vir::BinaryOpPredicate::MUL, scale, value);
+                }
+                (void)builder.create<vir::StoreOp>(loc, value, Y, indices);
+            });
+            PlanElementwiseNest(fill, { M, N }, elementType);
+        }
+        else
+        {
+            auto fill = MakeLoopNestTemplate(rewriter, { M, N }, [&](OpBuilder& builder, Location loc, ArrayRef<Value> indices) {
+                auto zero = builder.create<arith::ConstantOp>(loc, rewriter.getZeroAttr(elementType));
+                (void)builder.create<vir::StoreOp>(loc, zero, Y, indices);
+            });
+            PlanElementwiseNest(fill, { M, N }, elementType);
+        }
+
+        // Transposed operands are packed into row-major order, and alpha is folded into the packing of B
+        auto packedA = transA ? Pack(rewriter, loc, A, M, K, true, std::nullopt) : A;
+        auto packedB = (transB || alpha != 1.0) ? Pack(rewriter, loc, B, K, N, transB, alphaAttr) : B;
+
+        auto gemm = MakeLoopNestTemplate(rewriter, { M, N, K }, [&](OpBuilder& builder, Location loc, ArrayRef<Value> indices) {
+            auto i = indices[0], j = indices[1], k = indices[2];
+            auto a = builder.create<vir::LoadOp>(loc, elementType, packedA, ValueRange{ i, k });
+            auto b = builder.create<vir::LoadOp>(loc, elementType, packedB, ValueRange{ k, j });
+            auto y = builder.create<vir::LoadOp>(loc, elementType, Y, ValueRange{ i, j });
+            auto product = builder.create<vir::BinOp>(loc, vir::BinaryOpPredicate::MUL, a, b);
+            auto sum = builder.create<vir::BinOp>(loc, vir::BinaryOpPredicate::ADD, y, product);
+            (void)builder.create<vir::StoreOp>(loc, sum, Y, ValueRange{ i, j });
+        });
+        PlanGemmNest(gemm, packedB, M, N, K, GetElementBytes(elementType));
+
+        rewriter.replaceOp(op, Y);
+        return success();
+    }
+
+    // Copies `source`, or its transpose, into a new rows x cols row-major buffer, optionally scaled
+    Value Pack(PatternRewriter& rewriter, Location loc, Value source, int64_t rows, int64_t cols, bool transpose, std::optional<Attribute> scale) const
+    {
+        auto elementType = source.getType().cast<MemRefType>().getElementType();
+        Value packed = rewriter.create<vir::AllocOp>(loc, MemRefType::get({ rows, cols }, elementType));
+
+        auto pack = MakeLoopNestTemplate(rewriter, { rows, cols }, [&](OpBuilder& builder, Location loc, ArrayRef<Value> indices) {
+            auto r = indices[0], c = indices[1];
+            std::vector<Value> sourceIndices = transpose ? std::vector<Value>{ c, r } : std::vector<Value>{ r, c };
+            Value value = builder.create<vir::LoadOp>(loc, elementType, source, sourceIndices);
+            if (scale)
+            {
+                auto scaleValue = builder.create<arith::ConstantOp>(loc, *scale);
+                value = builder.create<vir::BinOp>(loc, vir::BinaryOpPredicate::MUL, scaleValue, value);
+            }
+            (void)builder.create<vir::StoreOp>(loc, value, packed, ValueRange{ r, c });
+        });
+        PlanElementwiseNest(pack, { rows, cols }, elementType);
+        return packed;
+    }
+
+    void PlanElementwiseNest(LoopNestTemplate& loopNest, ArrayRef<int64_t> shape, Type elementType) const
+    {
+        PlanElementwiseLoopNest(loopNest, shape, GetElementBytes(elementType), GetVectorizationInfo(), _options.numThreads);
+    }
+
+    // The GEMM schedule of the samples, with tile sizes from the tuned table: a panel of B is optionally
+    // packed into a cache, and each micro-kernel computes a block of C in registers
+    void PlanGemmNest(LoopNestTemplate& loopNest, Value B, int64_t M, int64_t N, int64_t K, int64_t elementBytes) const
+    {
+        auto schedule = loopNest.schedule;
+        auto i = loopNest.indices[0];
+        auto j = loopNest.indices[1];
+        auto k = loopNest.indices[2];
+
+        auto vectorSize = std::max<int64_t>(_options.vectorBytes / elementBytes, 1);
+        const auto& tuned = kTunedGemmSchedules[static_cast<int>(ClassifyGemm(M, N, K, vectorSize))];
+
+        auto clamp = [](int64_t size, int64_t dimSize) { return size > 0 ? std::min(size, dimSize) : dimSize; };
+        auto kernelN = clamp(tuned.kernelVectors * vectorSize, N);
+        auto tileN = clamp(tuned.panelVectors * vectorSize, N);
+        tileN = std::max(tileN - tileN % kernelN, kernelN);
+        auto tileK = clamp(tuned.panelDepth, K);
+        auto tileM = clamp(tuned.kernelRows, M);
+        vectorSize = std::min(vectorSize, kernelN);
+
+        auto [jOuter, jj] = schedule.split(j, static_cast<int>(tileN));
+        auto [kOuter, kk] = schedule.split(k, static_cast<int>(tileK));
+        auto [iOuter, ii] = schedule.split(i, static_cast<int>(tileM));
+        auto [jjOuter, jjj] = schedule.split(jj, static_cast<int>(kernelN));
+        auto [jjjOuter, jjjj] = schedule.split(jjj, static_cast<int>(vectorSize));
+        schedule.setOrder(std::vector<lnir::Index>{ jOuter, kOuter, iOuter, jjOuter, kk, ii, jjjOuter, jjjj });
+
+        if (tuned.cachePanel)
+        {
+            AddActiveBlockCache(schedule, B, jjOuter, GetVectorizationInfo());
+        }
+
+        schedule.unroll(ii);
+        schedule.unroll(jjjOuter);
+        if (vectorSize > 1)
+        {
+            VectorizeLoop(schedule, jjjj, GetVectorizationInfo());
+        }
+
+        if (_options.numThreads > 1 && M * N * K >= kMinParallelGemmVolume)
+        {
+            if (tuned.parallelLoop == GemmParallelLoop::Columns && N > tileN)
+            {
+                ParallelizeLoop(schedule, jOuter, _options.numThreads);
+            }
+            else if (tuned.parallelLoop == GemmParallelLoop::Rows && M > tileM)
+            {
+                ParallelizeLoop(schedule, iOuter, _options.numThreads);
+            }
+        }
+    }
+
+    xpir::VectorizationInfo GetVectorizationInfo() const
+    {
+        return { _options.vectorBytes, _options.vectorUnits, false };
+    }
+
+    rctr::GemmToLoopNestOptions _options;
+};
+
+struct GemmToLoopNestPass : public accera::transforms::GemmToLoopNestBase<GemmToLoopNestPass>
+{
+    GemmToLoopNestPass(const rctr::GemmToLoopNestOptions& options = {})
+    {
+        vectorBytes = options.vectorBytes;
+        vectorUnits = options.vectorUnits;
+        numThreads = options.numThreads;
+    }
+
+    void runOnOperation() final
+    {
+        rctr::GemmToLoopNestOptions options;
+        options.vectorBytes = vectorBytes;
+        options.vectorUnits = vectorUnits;
+        options.numThreads = numThreads;
+
+        RewritePatternSet patterns(&getContext());
+        rctr::populateGemmToLoopNestPatterns(patterns, options);
+        (void)applyPatternsAndFoldGreedily(getOperation(), std::move(patterns));
+    }
+};
+
+} // namespace
+
+namespace accera::transforms::rc
+{
+
+GemmToLoopNestOptions GetGemmToLoopNestOptions(const accera::value::TargetDevice& target, int64_t numThreads)
+{
+    auto targetInfo = GetLoopNestTargetInfo(target, numThreads);
+
+    GemmToLoopNestOptions options;
+    options.vectorBytes = targetInfo.vectorBytes;
+    options.vectorUnits = targetInfo.vectorUnits;
+    options.numThreads = targetInfo.numThreads;
+    return options;
+}
+
+void populateGemmToLoopNestPatterns(mlir::RewritePatternSet& patterns, const GemmToLoopNestOptions& options)
+{
+    patterns.insert<GemmOpLowering>(patterns.getContext(), options);
+}
+
+std::unique_ptr<mlir::OperationPass<accera::ir::value::ValueFuncOp>> createGemmToLoopNestPass(const GemmToLoopNestOptions& options)
+{
+    return std::make_unique<GemmToLoopNestPass>(options);
+}
+
+std::unique_ptr<mlir::OperationPass<accera::ir::value::ValueFuncOp>> createGemmToLoopNestPass()
+{
+    return std::make_unique<GemmToLoopNestPass>();
+}
+
+} // namespace accera::transforms::rc
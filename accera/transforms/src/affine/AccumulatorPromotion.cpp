@@ -0,0 +1,558 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) Microsoft Corporation. All rights reserved.
+//  Licensed under the MIT License. See LICENSE in the project root for license information.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "affine/AccumulatorPromotion.h"
+
+#include "AcceraPasses.h"
+
+#include <ir/include/value/ValueDialect.h>
+
+#include <mlir/Dialect/Affine/Analysis/LoopAnalysis.h>
+#include <mlir/Dialect/Affine/IR/AffineOps.h>
+#include <mlir/Dialect/Affine/IR/AffineValueMap.h>
+#include <mlir/Dialect/MemRef/IR/MemRef.h>
+#include <mlir/Dialect/Vector/IR/VectorOps.h>
+#include <mlir/IR/Builders.h>
+#include <mlir/IR/Matchers.h>
+#include <mlir/IR/Operation.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
+#include <mlir/Interfaces/ViewLikeInterface.h>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/TypeSwitch.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace mlir;
+
+namespace v = accera::ir::value;
+
+namespace
+{
+
+// One index of a memory access, as an affine map of its operands when it can be expressed as one
+struct AccessIndex
+{
+    std::optional<AffineValueMap> map;
+    Value value;
+};
+
+// A load or store of a single address, which covers `width` contiguous elements in the innermost dimension
+struct MemoryAccess
+{
+    Operation* op = nullptr;
+    Value memref;
+    std::vector<AccessIndex> indices;
+    std::vector<Value> indexOperands;
+    Type type;
+    int64_t width = 1;
+    bool isStore = false;
+};
+
+AccessIndex MakeAccessIndex(Value index)
+{
+    AccessIndex result;
+    result.value = index;
+    APInt constantValue;
+    if (index.getType().isIndex())
+    {
+        if (matchPattern(index, m_ConstantInt(&constantValue)))
+        {
+            result.map = AffineValueMap(AffineMap::getConstantMap(constantValue.getSExtValue(), index.getContext()), ValueRange{});
+        }
+        else if (auto applyOp = index.getDefiningOp<AffineApplyOp>())
+        {
+            result.map = AffineValueMap(applyOp.getAffineMap(), applyOp.getMapOperands());
+        }
+        else
+        {
+            result.map = AffineValueMap(AffineMap::getMultiDimIdentityMap(1, index.getContext()), index);
+        }
+    }
+    return result;
+}
+
+template <typename AffineOpTy>
+MemoryAccess MakeAffineAccess(AffineOpTy op, Type type, bool isStore)
+{
+    MemoryAccess access;
+    access.op = op;
+    access.memref = op.getMemRef();
+    access.type = type;
+    access.isStore = isStore;
+    auto map = op.getAffineMap();
+    auto operands = op.getMapOperands();
+    access.indexOperands.assign(operands.begin(), operands.end());
+    for (unsigned dim = 0; dim < map.getNumResults(); ++dim)
+    {
+        AccessIndex index;
+        index.map = AffineValueMap(map.getSubMap({ dim }), operands);
+        access.indices.push_back(index);
+    }
+    return access;
+}
+
+MemoryAccess MakeIndexedAccess(Operation* op, Value memref, ValueRange indices, Type type, bool isStore)
+{
+    MemoryAccess access;
+    access.op = op;
+    access.memref = memref;
+    access.type = type;
+    access.isStore = isStore;
+    access.indexOperands.assign(indices.begin(), indices.end());
+    for (auto index : indices)
+    {
+        access.indices.push_back(MakeAccessIndex(index));
+    }
+    return access;
+}
+
+std::optional<MemoryAccess> GetMemoryAccess(Operation* op)
+{
+    auto access = mlir::TypeSwitch<Operation*, std::optional<MemoryAccess>>(op)
+                      .Case([](AffineLoadOp op) { return MakeAffineAccess(op, op.getResult().getType(), false); })
+                      .Case([](AffineStoreOp op) { return MakeAffineAccess(op, op.getValueToStore().getType(), true); })
+                      .Case([](AffineVectorLoadOp op) { return MakeAffineAccess(op, op.getResult().getType(), false); })
+                      .Case([](AffineVectorStoreOp op) { return MakeAffineAccess(op, op.getValueToStore().getType(), true); })
+                      .Case([](memref::LoadOp op) { return MakeIndexedAccess(op, op.getMemRef(), op.getIndices(), op.getResult().getType(), false); })
+                      .Case([](memref::StoreOp op) { return MakeIndexedAccess(op, op.getMemRef(), op.getIndices(), op.getValueToStore().getType(), true); })
+                      .Case([](vector::LoadOp op) { return MakeIndexedAccess(op, op.base(), op.indices(), op.getResult().getType(), false); })
+                      .Case([](vector::StoreOp op) { return MakeIndexedAccess(op, op.base(), op.indices(), op.valueToStore().getType(), true); })
+                      .Case([](v::LoadOp op) { return MakeIndexedAccess(op, op.getMemRef(), op.indices(), op.getResult().getType(), false); })
+                      .Case([](v::StoreOp op) { return MakeIndexedAccess(op, op.memref(), op.indices(), op.value().getType(), true); })
+                      .Default([](Operation*) { return std::nullopt; });
+
+    if (access)
+    {
+        if (auto vectorType = access->type.dyn_cast<VectorType>())
+        {
+            // Multi-dimensional vectors don't cover a contiguous range of the innermost dimension
+            access->width = vectorType.getRank() == 1 ? vectorType.getNumElements() : -1;
+        }
+    }
+    return access;
+}
+
+std::optional<int64_t> GetConstantDifference(const AccessIndex& lhs, const AccessIndex& rhs)
+{
+    if (lhs.value && lhs.value == rhs.value)
+    {
+        return 0;
+    }
+
+    if (lhs.map && rhs.map)
+    {
+        AffineValueMap difference;
+        AffineValueMap::difference(*lhs.map, *rhs.map, &difference);
+        auto map = difference.getAffineMap();
+        SmallVector<Value, 4> operands(difference.getOperands().begin(), difference.getOperands().end());
+        fullyComposeAffineMapAndOperands(&map, &operands);
+        canonicalizeMapAndOperands(&map, &operands);
+        map = simplifyAffineMap(map);
+        if (auto constantExpr = map.getResult(0).dyn_cast<AffineConstantExpr>())
+        {
+            return constantExpr.getValue();
+        }
+        return std::nullopt;
+    }
+
+    APInt lhsConstant, rhsConstant;
+    if (lhs.value && rhs.value && matchPattern(lhs.value, m_ConstantInt(&lhsConstant)) && matchPattern(rhs.value, m_ConstantInt(&rhsConstant)))
+    {
+        return lhsConstant.getSExtValue() - rhsConstant.getSExtValue();
+    }
+    return std::nullopt;
+}
+
+bool IsSameAddress(const MemoryAccess& lhs, const MemoryAccess& rhs)
+{
+    if (lhs.memref != rhs.memref || lhs.type != rhs.type || lhs.indices.size() != rhs.indices.size())
+    {
+        return false;
+    }
+    for (unsigned idx = 0; idx < lhs.indices.size(); ++idx)
+    {
+        auto difference = GetConstantDifference(lhs.indices[idx], rhs.indices[idx]);
+        if (!difference || *difference != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IsDisjoint(const MemoryAccess& lhs, const MemoryAccess& rhs)
+{
+    if (lhs.memref != rhs.memref || lhs.indices.size() != rhs.indices.size() || lhs.width < 0 || rhs.width < 0)
+    {
+        return false;
+    }
+
+    // Two accesses are disjoint if they are a constant distance apart in some dimension, and in
+    // the innermost dimension that distance must be at least the width of the lower access
+    auto innermost = lhs.indices.size() - 1;
+    for (unsigned idx = 0; idx < lhs.indices.size(); ++idx)
+    {
+        auto difference = GetConstantDifference(lhs.indices[idx], rhs.indices[idx]);
+        if (!difference)
+        {
+            continue;
+        }
+        if (idx != innermost && *difference != 0)
+        {
+            return true;
+        }
+        if (idx == innermost && (*difference >= rhs.width || -*difference >= lhs.width))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+Value GetUnderlyingBuffer(Value memref)
+{
+    while (auto viewOp = memref.getDefiningOp<ViewLikeOpInterface>())
+    {
+        memref = viewOp.getViewSource();
+    }
+    return memref;
+}
+
+// Returns the symbol of a global buffer, or an empty string if the buffer isn't a global
+StringRef GetGlobalName(Value buffer)
+{
+    if (auto getGlobalOp = buffer.getDefiningOp<memref::GetGlobalOp>())
+    {
+        return getGlobalOp.name();
+    }
+    if (auto refGlobalOp = buffer.getDefiningOp<v::ReferenceGlobalOp>())
+    {
+        return refGlobalOp.global_name();
+    }
+    return {};
+}
+
+bool IsLocalAllocation(Value buffer)
+{
+    auto definingOp = buffer.getDefiningOp();
+    return definingOp && isa<memref::AllocOp, memref::AllocaOp, v::AllocOp>(definingOp);
+}
+
+bool IsFunctionArgument(Value buffer)
+{
+    auto arg = buffer.dyn_cast<BlockArgument>();
+    return arg && arg.getOwner()->isEntryBlock() && isa<FuncOp, v::ValueFuncOp>(arg.getOwner()->getParentOp());
+}
+
+bool MayAlias(Value lhs, Value rhs)
+{
+    if (lhs == rhs)
+    {
+        return true;
+    }
+
+    auto lhsBuffer = GetUnderlyingBuffer(lhs);
+    auto rhsBuffer = GetUnderlyingBuffer(rhs);
+    if (lhsBuffer == rhsBuffer)
+    {
+        return true;
+    }
+
+    // Distinct allocations and globals never alias each other, and a local allocation can't alias a function argument
+    auto lhsGlobal = GetGlobalName(lhsBuffer);
+    auto rhsGlobal = GetGlobalName(rhsBuffer);
+    auto lhsKnown = IsLocalAllocation(lhsBuffer) || !lhsGlobal.empty();
+    auto rhsKnown = IsLocalAllocation(rhsBuffer) || !rhsGlobal.empty();
+    if (lhsKnown && rhsKnown)
+    {
+        return !lhsGlobal.empty() && lhsGlobal == rhsGlobal;
+    }
+    if ((IsLocalAllocation(lhsBuffer) && IsFunctionArgument(rhsBuffer)) || (IsLocalAllocation(rhsBuffer) && IsFunctionArgument(lhsBuffer)))
+    {
+        return false;
+    }
+    return true;
+}
+
+// The memory behavior of everything nested in a loop
+struct LoopMemoryEffects
+{
+    std::vector<MemoryAccess> accesses;
+    std::vector<Value> otherReads;
+    std::vector<Value> otherWrites;
+    bool hasUnknownRead = false;
+    bool hasUnknownWrite = false;
+
+    LoopMemoryEffects(AffineForOp loop)
+    {
+        loop.getBody()->walk([&](Operation* op) {
+            if (auto access = GetMemoryAccess(op))
+            {
+                accesses.push_back(*access);
+                return;
+            }
+
+            if (auto effectInterface = dyn_cast<MemoryEffectOpInterface>(op))
+            {
+                SmallVector<MemoryEffects::EffectInstance, 4> effects;
+                effectInterface.getEffects(effects);
+                for (auto& effect : effects)
+                {
+                    auto value = effect.getValue();
+                    if (isa<MemoryEffects::Read>(effect.getEffect()))
+                    {
+                        if (value)
+                            otherReads.push_back(value);
+                        else
+                            hasUnknownRead = true;
+                    }
+                    else if (isa<MemoryEffects::Write, MemoryEffects::Free>(effect.getEffect()))
+                    {
+                        if (value)
+                            otherWrites.push_back(value);
+                        else
+                            hasUnknownWrite = true;
+                    }
+                }
+                return;
+            }
+
+            if (!op->hasTrait<OpTrait::HasRecursiveSideEffects>() && !op->hasTrait<OpTrait::IsTerminator>())
+            {
+                hasUnknownRead = true;
+                hasUnknownWrite = true;
+            }
+        });
+    }
+};
+
+// The loads and stores of one address in the body of a loop, in program order
+struct AccessGroup
+{
+    std::vector<MemoryAccess> accesses;
+
+    bool HasStore() const
+    {
+        return llvm::any_of(accesses, [](const MemoryAccess& access) { return access.isStore; });
+    }
+
+    bool Contains(Operation* op) const
+    {
+        return llvm::any_of(accesses, [&](const MemoryAccess& access) { return access.op == op; });
+    }
+};
+
+bool IsLoopInvariant(AffineForOp loop, Value value)
+{
+    return !loop.getLoopBody().isAncestor(value.getParentRegion());
+}
+
+// Returns true if no other memory operation in the loop can observe or modify the group's address
+bool IsIsolated(const AccessGroup& group, const LoopMemoryEffects& effects)
+{
+    const auto& representative = group.accesses.front();
+    auto hasStore = group.HasStore();
+    if (effects.hasUnknownWrite || (hasStore && effects.hasUnknownRead))
+    {
+        return false;
+    }
+
+    for (const auto& access : effects.accesses)
+    {
+        if (group.Contains(access.op) || (!hasStore && !access.isStore) || !MayAlias(access.memref, representative.memref))
+        {
+            continue;
+        }
+        if (!IsDisjoint(access, representative))
+        {
+            return false;
+        }
+    }
+
+    auto aliases = [&](Value value) { return MayAlias(value, representative.memref); };
+    if (llvm::any_of(effects.otherWrites, aliases))
+    {
+        return false;
+    }
+    return !hasStore || llvm::none_of(effects.otherReads, aliases);
+}
+
+std::vector<AccessGroup> FindInvariantAccessGroups(AffineForOp loop)
+{
+    std::vector<AccessGroup> groups;
+    for (auto& op : loop.getBody()->without_terminator())
+    {
+        auto access = GetMemoryAccess(&op);
+        if (!access || !IsLoopInvariant(loop, access->memref) ||
+            !llvm::all_of(access->indexOperands, [&](Value index) { return IsLoopInvariant(loop, index); }))
+        {
+            continue;
+        }
+
+        auto it = llvm::find_if(groups, [&](const AccessGroup& group) { return IsSameAddress(group.accesses.front(), *access); });
+        if (it == groups.end())
+        {
+            groups.push_back({});
+            it = std::prev(groups.end());
+        }
+        it->accesses.push_back(*access);
+    }
+    return groups;
+}
+
+// Loads of an address that the loop never writes are replaced by a single load before the loop
+void HoistLoads(AffineForOp loop, const AccessGroup& group)
+{
+    auto hoistedLoad = group.accesses.front().op;
+    hoistedLoad->moveBefore(loop);
+    for (const auto& access : llvm::drop_begin(group.accesses))
+    {
+        access.op->replaceAllUsesWith(hoistedLoad);
+        access.op->erase();
+    }
+}
+
+// Addresses that the loop reads and writes (such as accumulators) are carried in registers through loop
+// iteration arguments, loaded once before the loop and stored once after it
+void PromoteToIterArgs(AffineForOp loop, const std::vector<AccessGroup>& groups)
+{
+    auto loc = loop.getLoc();
+    OpBuilder builder(loop);
+
+    SmallVector<Value, 4> inits(loop.getIterOperands().begin(), loop.getIterOperands().end());
+    for (const auto& group : groups)
+    {
+        inits.push_back(builder.clone(*group.accesses.front().op)->getResult(0));
+    }
+
+    auto newLoop = builder.create<AffineForOp>(loc, loop.getLowerBoundOperands(), loop.getLowerBoundMap(), loop.getUpperBoundOperands(), loop.getUpperBoundMap(), loop.getStep(), inits);
+    newLoop->setAttrs(loop->getAttrs());
+
+    auto oldBody = loop.getBody();
+    auto newBody = newLoop.getBody();
+    newBody->getOperations().splice(newBody->end(), oldBody->getOperations());
+    for (unsigned argIdx = 0; argIdx < oldBody->getNumArguments(); ++argIdx)
+    {
+        oldBody->getArgument(argIdx).replaceAllUsesWith(newBody->getArgument(argIdx));
+    }
+
+    // Forward each stored value to the loads after it, and carry the last one into the next iteration.
+    // Walk the body in program order so a value stored to one address and loaded from another is already forwarded.
+    auto numOldIterArgs = loop.getNumIterOperands();
+    SmallVector<Value, 4> currentValues(newLoop.getRegionIterArgs().begin() + numOldIterArgs, newLoop.getRegionIterArgs().end());
+    for (auto& op : newBody->without_terminator())
+    {
+        for (unsigned groupIdx = 0; groupIdx < groups.size(); ++groupIdx)
+        {
+            if (!groups[groupIdx].Contains(&op))
+            {
+                continue;
+            }
+            if (op.getNumResults() == 0)
+            {
+                currentValues[groupIdx] = op.getOperand(0);
+            }
+            else
+            {
+                op.getResult(0).replaceAllUsesWith(currentValues[groupIdx]);
+            }
+        }
+    }
+    auto yieldOp = newBody->getTerminator();
+    yieldOp->insertOperands(yieldOp->getNumOperands(), currentValues);
+
+    // Write the final values back after the loop
+    builder.setInsertionPointAfter(newLoop);
+    for (unsigned groupIdx = 0; groupIdx < groups.size(); ++groupIdx)
+    {
+        const auto& lastStore = *llvm::find_if(llvm::reverse(groups[groupIdx].accesses), [](const MemoryAccess& access) { return access.isStore; });
+        auto finalStore = builder.clone(*lastStore.op);
+        finalStore->setOperand(0, newLoop.getResult(numOldIterArgs + groupIdx));
+    }
+
+    for (const auto& group : groups)
+    {
+        for (const auto& access : group.accesses)
+        {
+            access.op->erase();
+        }
+    }
+
+    loop.replaceAllUsesWith(newLoop.getResults().take_front(loop.getNumResults()));
+    loop.erase();
+}
+
+void PromoteLoopAccesses(AffineForOp loop)
+{
+    auto groups = FindInvariantAccessGroups(loop);
+    if (groups.empty())
+    {
+        return;
+    }
+
+    LoopMemoryEffects effects(loop);
+    auto tripCount = getConstantTripCount(loop);
+    std::vector<AccessGroup> loadGroups;
+    std::vector<AccessGroup> promotedGroups;
+    for (auto& group : groups)
+    {
+        if (!IsIsolated(group, effects))
+        {
+            continue;
+        }
+
+        // The loop must run at least once, otherwise a hoisted load would read memory the loop never touched (which may
+        // be out of bounds), and the store after the loop would write to it
+        if (!tripCount || *tripCount == 0)
+        {
+            continue;
+        }
+
+        if (!group.HasStore())
+        {
+            loadGroups.push_back(group);
+        }
+        else if (!group.accesses.front().isStore)
+        {
+            promotedGroups.push_back(group);
+        }
+    }
+
+    for (const auto& group : loadGroups)
+    {
+        HoistLoads(loop, group);
+    }
+    if (!promotedGroups.empty())
+    {
+        PromoteToIterArgs(loop, promotedGroups);
+    }
+}
+
+struct AccumulatorPromotionPass : public accera::transforms::AcceraAccumulatorPromotionBase<AccumulatorPromotionPass>
+{
+    void runOnOperation() final
+    {
+        // Visit inner loops first so promoted loads and stores can be promoted again through the enclosing loops
+        std::vector<AffineForOp> loops;
+        getOperation()->walk([&](AffineForOp loop) { loops.push_back(loop); });
+        for (auto loop : loops)
+        {
+            PromoteLoopAccesses(loop);
+        }
+    }
+};
+
+} // namespace
+
+namespace accera::transforms::affine
+{
+std::unique_ptr<mlir::Pass> createAccumulatorPromotionPass()
+{
+    return std::make_unique<AccumulatorPromotionPass>();
+}
+} // namespace accera::transforms::affine
@@ -0,0 +1,353 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) Microsoft Corporation. All rights reserved.
+//  Licensed under the MIT License. See LICENSE in the project root for license information.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "affine/AtomicPrivatization.h"
+
+#include "AcceraPasses.h"
+
+#include <ir/include/value/ValueDialect.h>
+
+#include <mlir/Dialect/Affine/Analysis/LoopAnalysis.h>
+#include <mlir/Dialect/Affine/IR/AffineOps.h>
+#include <mlir/Dialect/Arithmetic/IR/Arithmetic.h>
+#include <mlir/Dialect/MemRef/IR/MemRef.h>
+#include <mlir/IR/Builders.h>
+#include <mlir/IR/BuiltinTypes.h>
+#include <mlir/Interfaces/LoopLikeInterface.h>
+#include <mlir/Interfaces/ViewLikeInterface.h>
+
+#include <llvm/ADT/APFloat.h>
+#include <llvm/ADT/MapVector.h>
+#include <llvm/ADT/SmallVector.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace mlir;
+
+namespace v = accera::ir::value;
+
+namespace
+{
+
+// Private copies are allocated on the stack of every parallel iteration, so only small buffers are privatized
+constexpr int64_t kMaxPrivateElements = 1024;
+
+Value GetUnderlyingBuffer(Value memref)
+{
+    while (true)
+    {
+        if (auto viewOp = memref.getDefiningOp<ViewLikeOpInterface>())
+        {
+            memref = viewOp.getViewSource();
+        }
+        else if (auto sliceOp = memref.getDefiningOp<v::SliceOp>())
+        {
+            memref = sliceOp.source();
+        }
+        else
+        {
+            return memref;
+        }
+    }
+}
+
+// The buffer and element indices updated by an atomic. Atomics on Array elements written in the DSL update a
+// single-element slice of the array, so the slice offsets are folded into the indices of the sliced buffer
+std::pair<Value, SmallVector<Value, 4>> ResolveAtomicTarget(v::AtomicRMWOp op)
+{
+    Value memref = op.memref();
+    SmallVector<Value, 4> indices(op.indices().begin(), op.indices().end());
+    while (auto sliceOp = memref.getDefiningOp<v::SliceOp>())
+    {
+        // The offsets are the indices of the sliced dimensions, and the remaining dimensions keep their order
+        SmallVector<Value, 4> sourceIndices(sliceOp.getSourceMemRefType().getRank());
+        for (auto [dimAttr, offset] : llvm::zip(sliceOp.sliceDimensions(), sliceOp.offsets()))
+        {
+            sourceIndices[dimAttr.cast<IntegerAttr>().getInt()] = offset;
+        }
+        auto it = indices.begin();
+        for (auto& index : sourceIndices)
+        {
+            if (!index)
+            {
+                index = *it++;
+            }
+        }
+        memref = sliceOp.source();
+        indices = std::move(sourceIndices);
+    }
+    return { memref, indices };
+}
+
+bool IsDefinedOutside(AffineParallelOp parallelOp, Value value)
+{
+    return !parallelOp.region().isAncestor(value.getParentRegion());
+}
+
+// The number of times `op` runs in one iteration of `parallelOp`, if every loop in between is a sequential loop with a
+// constant trip count. Iterations of a parallel loop in between would race on the private copy, so those aren't counted
+std::optional<int64_t> GetExecutionCount(Operation* op, AffineParallelOp parallelOp)
+{
+    int64_t count = 1;
+    for (auto parent = op->getParentOp(); parent != parallelOp.getOperation(); parent = parent->getParentOp())
+    {
+        if (auto forOp = dyn_cast<AffineForOp>(parent))
+        {
+            auto tripCount = getConstantTripCount(forOp);
+            if (!tripCount)
+            {
+                return std::nullopt;
+            }
+            count *= static_cast<int64_t>(*tripCount);
+        }
+        else if (isa<AffineParallelOp, LoopLikeOpInterface>(parent))
+        {
+            return std::nullopt;
+        }
+    }
+    return count;
+}
+
+// The value that leaves an element unchanged when combined with it
+Value GetIdentity(OpBuilder& builder, Location loc, v::AtomicRMWKind kind, Type elementType)
+{
+    if (auto floatType = elementType.dyn_cast<FloatType>())
+    {
+        auto& semantics = floatType.getFloatSemantics();
+        auto identity = kind == v::AtomicRMWKind::ADD ? APFloat::getZero(semantics) : APFloat::getInf(semantics, /*Negative=*/kind == v::AtomicRMWKind::MAX);
+        return builder.create<arith::ConstantFloatOp>(loc, identity, floatType);
+    }
+
+    auto width = elementType.getIntOrFloatBitWidth();
+    auto isUnsigned = elementType.isUnsignedInteger();
+    auto identity = [&]() {
+        switch (kind)
+        {
+        case v::AtomicRMWKind::MAX:
+            return isUnsigned ? APInt::getMinValue(width) : APInt::getSignedMinValue(width);
+        case v::AtomicRMWKind::MIN:
+            return isUnsigned ? APInt::getMaxValue(width) : APInt::getSignedMaxValue(width);
+        default:
+            return APInt::getZero(width);
+        }
+    }();
+
+    auto signlessType = builder.getIntegerType(width);
+    Value result = builder.create<arith::ConstantOp>(loc, builder.getIntegerAttr(signlessType, identity));
+    if (isUnsigned)
+    {
+        result = builder.create<UnrealizedConversionCastOp>(loc, elementType, result).getResult(0);
+    }
+    return result;
+}
+
+v::BinaryOpPredicate GetCombiningPredicate(v::AtomicRMWKind kind)
+{
+    switch (kind)
+    {
+    case v::AtomicRMWKind::MAX:
+        return v::BinaryOpPredicate::MAX;
+    case v::AtomicRMWKind::MIN:
+        return v::BinaryOpPredicate::MIN;
+    default:
+        return v::BinaryOpPredicate::ADD;
+    }
+}
+
+// Builds a nest of affine.for loops over `shape` and calls `body` with the induction variables of the nest
+void BuildLoopNest(OpBuilder& builder, Location loc, ArrayRef<int64_t> shape, function_ref<void(OpBuilder&, ValueRange)> body)
+{
+    SmallVector<Value, 4> ivs;
+    OpBuilder::InsertionGuard guard(builder);
+    for (auto size : shape)
+    {
+        auto loop = builder.create<AffineForOp>(loc, 0, size);
+        builder.setInsertionPointToStart(loop.getBody());
+        ivs.push_back(loop.getInductionVar());
+    }
+    body(builder, ivs);
+}
+
+// Atomic updates of one buffer in the body of a parallel loop, with the indices of the elements they update
+struct AtomicGroup
+{
+    Value memref;
+    std::vector<v::AtomicRMWOp> ops;
+    std::vector<SmallVector<Value, 4>> indices;
+};
+
+bool CanPrivatize(AffineParallelOp parallelOp, const AtomicGroup& group)
+{
+    auto memrefType = group.memref.getType().cast<MemRefType>();
+    if (!memrefType.hasStaticShape() || memrefType.getNumElements() > kMaxPrivateElements)
+    {
+        return false;
+    }
+
+    // All updates must be reductions of the same kind whose previous values are never used
+    auto kind = group.ops.front().kind();
+    if (kind == v::AtomicRMWKind::XCHG)
+    {
+        return false;
+    }
+    for (auto op : group.ops)
+    {
+        if (op.kind() != kind || !op.getResult().use_empty())
+        {
+            return false;
+        }
+    }
+
+    // Nothing else in the loop may read or write the buffer, or the partial results would be observable
+    auto buffer = GetUnderlyingBuffer(group.memref);
+    auto result = parallelOp.getBody()->walk([&](Operation* op) {
+        if (auto atomicOp = dyn_cast<v::AtomicRMWOp>(op); atomicOp && llvm::is_contained(group.ops, atomicOp))
+        {
+            return WalkResult::advance();
+        }
+        // Views don't access memory, their users are checked instead
+        if (isa<ViewLikeOpInterface, v::SliceOp>(op))
+        {
+            return WalkResult::advance();
+        }
+        for (auto operand : op->getOperands())
+        {
+            if (operand.getType().isa<MemRefType>() && GetUnderlyingBuffer(operand) == buffer)
+            {
+                return WalkResult::interrupt();
+            }
+        }
+        return WalkResult::advance();
+    });
+    if (result.wasInterrupted())
+    {
+        return false;
+    }
+
+    // Privatizing costs a fill and an atomic merge of the whole buffer per parallel iteration, which only pays off
+    // when the iteration performs at least as many updates as there are elements
+    int64_t numUpdates = 0;
+    for (auto op : group.ops)
+    {
+        auto count = GetExecutionCount(op, parallelOp);
+        if (!count)
+        {
+            return false;
+        }
+        numUpdates += *count;
+    }
+    return numUpdates >= memrefType.getNumElements();
+}
+
+void Privatize(AffineParallelOp parallelOp, const AtomicGroup& group)
+{
+    auto loc = parallelOp.getLoc();
+    auto memrefType = group.memref.getType().cast<MemRefType>();
+    auto elementType = memrefType.getElementType();
+    auto shape = memrefType.getShape();
+    auto kind = group.ops.front().kind();
+
+    // Allocate a private copy of the buffer for each iteration, and fill it with the identity of the reduction
+    auto body = parallelOp.getBody();
+    OpBuilder builder(body, body->begin());
+    auto privateType = MemRefType::get(shape, elementType);
+    Value privateBuffer = builder.create<memref::AllocaOp>(loc, privateType);
+    auto identity = GetIdentity(builder, loc, kind, elementType);
+    BuildLoopNest(builder, loc, shape, [&](OpBuilder& nestBuilder, ValueRange ivs) {
+        nestBuilder.create<AffineStoreOp>(loc, identity, privateBuffer, ivs);
+    });
+
+    // Replace the atomic updates with plain read-modify-writes of the private copy
+    auto predicate = GetCombiningPredicate(kind);
+    for (auto [op, opIndices] : llvm::zip(group.ops, group.indices))
+    {
+        OpBuilder opBuilder(op);
+        auto opLoc = op.getLoc();
+        SmallVector<Value, 4> indices;
+        for (auto index : opIndices)
+        {
+            if (index.getType().isIndex())
+            {
+                indices.push_back(index);
+            }
+            else
+            {
+                indices.push_back(opBuilder.create<arith::IndexCastOp>(opLoc, opBuilder.getIndexType(), opBuilder.create<v::GetElementOp>(opLoc, index)));
+            }
+        }
+        auto current = opBuilder.create<memref::LoadOp>(opLoc, privateBuffer, indices);
+        auto updated = opBuilder.create<v::BinOp>(opLoc, predicate, current, opBuilder.create<v::GetElementOp>(opLoc, op.value()));
+        opBuilder.create<memref::StoreOp>(opLoc, updated, privateBuffer, indices);
+
+        // The slices of the shared buffer the atomic updated are dead now
+        auto target = op.memref();
+        op.erase();
+        while (auto sliceOp = target.getDefiningOp<v::SliceOp>())
+        {
+            if (!sliceOp->use_empty())
+            {
+                break;
+            }
+            target = sliceOp.source();
+            sliceOp.erase();
+        }
+    }
+
+    // Merge the private copy into the shared buffer once, at the end of the iteration
+    builder.setInsertionPoint(body->getTerminator());
+    BuildLoopNest(builder, loc, shape, [&](OpBuilder& nestBuilder, ValueRange ivs) {
+        auto partial = nestBuilder.create<AffineLoadOp>(loc, privateBuffer, ivs);
+        nestBuilder.create<v::AtomicRMWOp>(loc, kind, partial, group.memref, ivs);
+    });
+}
+
+void PrivatizeAtomics(AffineParallelOp parallelOp)
+{
+    llvm::MapVector<Value, AtomicGroup> groups;
+    parallelOp.getBody()->walk([&](v::AtomicRMWOp op) {
+        auto [memref, indices] = ResolveAtomicTarget(op);
+        if (IsDefinedOutside(parallelOp, memref))
+        {
+            auto& group = groups[memref];
+            group.memref = memref;
+            group.ops.push_back(op);
+            group.indices.push_back(indices);
+        }
+    });
+
+    for (auto& [memref, group] : groups)
+    {
+        if (CanPrivatize(parallelOp, group))
+        {
+            Privatize(parallelOp, group);
+        }
+    }
+}
+
+struct AtomicPrivatizationPass : public accera::transforms::AcceraAtomicPrivatizationBase<AtomicPrivatizationPass>
+{
+    void runOnOperation() final
+    {
+        // Atomics in nested parallel loops are only privatized by the innermost parallel loop around them
+        std::vector<AffineParallelOp> parallelOps;
+        getOperation()->walk([&](AffineParallelOp op) { parallelOps.push_back(op); });
+        for (auto op : parallelOps)
+        {
+            PrivatizeAtomics(op);
+        }
+    }
+};
+
+} // namespace
+
+namespace accera::transforms::affine
+{
+std::unique_ptr<mlir::Pass> createAtomicPrivatizationPass()
+{
+    return std::make_unique<AtomicPrivatizationPass>();
+}
+} // namespace accera::transforms::affine
@@ -0,0 +1,380 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) Microsoft Corporation. All rights reserved.
+//  Licensed under the MIT License. See LICENSE in the project root for license information.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "affine/IndexStrengthReduction.h"
+
+#include "AcceraPasses.h"
+
+#include <mlir/Dialect/Arithmetic/IR/Arithmetic.h>
+#include <mlir/Dialect/MemRef/IR/MemRef.h>
+#include <mlir/Dialect/SCF/SCF.h>
+#include <mlir/Dialect/Vector/IR/VectorOps.h>
+#include <mlir/IR/Builders.h>
+#include <mlir/IR/Matchers.h>
+#include <mlir/IR/Operation.h>
+
+#include <llvm/ADT/SetVector.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/TypeSwitch.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace mlir;
+
+namespace
+{
+
+// Integer multiplies cost more issue slots and latency than adds, so weight them accordingly
+// when deciding whether a rewrite pays for its loop-carried increment
+constexpr int64_t MultiplyCost = 3;
+constexpr int64_t AddCost = 1;
+
+// An index value expressed as ivCoefficient * iv + sum(coefficient * invariant) + constant
+struct LinearIndex
+{
+    int64_t ivCoefficient = 0;
+    llvm::SmallVector<std::pair<Value, int64_t>, 4> invariantTerms;
+    int64_t constant = 0;
+
+    bool IsConstant() const { return ivCoefficient == 0 && invariantTerms.empty(); }
+
+    void AddTerm(Value value, int64_t coefficient)
+    {
+        for (auto& term : invariantTerms)
+        {
+            if (term.first == value)
+            {
+                term.second += coefficient;
+                return;
+            }
+        }
+        invariantTerms.emplace_back(value, coefficient);
+    }
+
+    void Accumulate(const LinearIndex& other, int64_t scale)
+    {
+        ivCoefficient += scale * other.ivCoefficient;
+        for (const auto& [value, coefficient] : other.invariantTerms)
+        {
+            AddTerm(value, scale * coefficient);
+        }
+        constant += scale * other.constant;
+    }
+
+    // Two indices belong to the same group if they only differ by their constant offset
+    bool HasSameBase(const LinearIndex& other) const
+    {
+        if (ivCoefficient != other.ivCoefficient)
+        {
+            return false;
+        }
+        auto nonZeroTerms = [](const LinearIndex& index) {
+            return llvm::count_if(index.invariantTerms, [](const auto& term) { return term.second != 0; });
+        };
+        if (nonZeroTerms(*this) != nonZeroTerms(other))
+        {
+            return false;
+        }
+        return llvm::all_of(invariantTerms, [&](const auto& term) {
+            return term.second == 0 || llvm::any_of(other.invariantTerms, [&](const auto& otherTerm) { return otherTerm == term; });
+        });
+    }
+};
+
+// Decomposes index arithmetic computed inside a loop into a LinearIndex, recording the ops in the loop
+// that the computation uses. Returns nullopt if the value isn't a linear function of the induction
+// variable and loop-invariant values.
+class LinearIndexBuilder
+{
+public:
+    LinearIndexBuilder(scf::ForOp loop) :
+        _loop(loop) {}
+
+    std::optional<LinearIndex> Decompose(Value value, llvm::SetVector<Operation*>& loopOps)
+    {
+        LinearIndex result;
+        if (value == _loop.getInductionVar())
+        {
+            result.ivCoefficient = 1;
+            return result;
+        }
+
+        APInt constantValue;
+        if (matchPattern(value, m_ConstantInt(&constantValue)))
+        {
+            result.constant = constantValue.getSExtValue();
+            return result;
+        }
+
+        if (!_loop.getLoopBody().isAncestor(value.getParentRegion()))
+        {
+            result.AddTerm(value, 1);
+            return result;
+        }
+
+        auto op = value.getDefiningOp();
+        if (!op || op->getNumOperands() != 2 || !value.getType().isIndex())
+        {
+            return std::nullopt;
+        }
+
+        auto lhs = Decompose(op->getOperand(0), loopOps);
+        auto rhs = lhs ? Decompose(op->getOperand(1), loopOps) : std::nullopt;
+        if (!lhs || !rhs)
+        {
+            return std::nullopt;
+        }
+
+        auto success = mlir::TypeSwitch<Operation*, bool>(op)
+                           .Case([&](arith::AddIOp) {
+                               result.Accumulate(*lhs, 1);
+                               result.Accumulate(*rhs, 1);
+                               return true;
+                           })
+                           .Case([&](arith::SubIOp) {
+                               result.Accumulate(*lhs, 1);
+                               result.Accumulate(*rhs, -1);
+                               return true;
+                           })
+                           .Case([&](arith::MulIOp) {
+                               // Only multiplication by a constant keeps the index linear
+                               if (rhs->IsConstant())
+                               {
+                                   result.Accumulate(*lhs, rhs->constant);
+                                   return true;
+                               }
+                               if (lhs->IsConstant())
+                               {
+                                   result.Accumulate(*rhs, lhs->constant);
+                                   return true;
+                               }
+                               return false;
+                           })
+                           .Default([](Operation*) { return false; });
+
+        if (!success)
+        {
+            return std::nullopt;
+        }
+        loopOps.insert(op);
+        return result;
+    }
+
+private:
+    scf::ForOp _loop;
+};
+
+struct IndexGroup
+{
+    LinearIndex base;
+    llvm::SmallVector<std::pair<Value, int64_t>, 4> members; // (index value, constant offset from the base)
+    llvm::SetVector<Operation*> loopOps;
+
+    int64_t SavedCost() const
+    {
+        int64_t removedCost = 0;
+        for (auto op : loopOps)
+        {
+            removedCost += isa<arith::MulIOp>(op) ? MultiplyCost : AddCost;
+        }
+
+        // Each member with a non-zero offset still needs an add, plus one add per iteration for the increment
+        auto addedCost = AddCost * (1 + llvm::count_if(members, [](const auto& member) { return member.second != 0; }));
+        return removedCost - addedCost;
+    }
+};
+
+std::vector<Value> GetAccessIndices(Operation* op)
+{
+    return mlir::TypeSwitch<Operation*, std::vector<Value>>(op)
+        .Case([](memref::LoadOp op) { return std::vector<Value>(op.getIndices().begin(), op.getIndices().end()); })
+        .Case([](memref::StoreOp op) { return std::vector<Value>(op.getIndices().begin(), op.getIndices().end()); })
+        .Case([](vector::LoadOp op) { return std::vector<Value>(op.indices().begin(), op.indices().end()); })
+        .Case([](vector::StoreOp op) { return std::vector<Value>(op.indices().begin(), op.indices().end()); })
+        .Case([](vector::TransferReadOp op) { return std::vector<Value>(op.indices().begin(), op.indices().end()); })
+        .Case([](vector::TransferWriteOp op) { return std::vector<Value>(op.indices().begin(), op.indices().end()); })
+        .Case([](scf::ForOp op) { return std::vector<Value>(op.getIterOperands().begin(), op.getIterOperands().end()); })
+        .Default([](Operation*) { return std::vector<Value>{}; });
+}
+
+Value EmitLinearIndex(OpBuilder& builder, Location loc, const LinearIndex& index, Value iv)
+{
+    Value result;
+    auto accumulate = [&](Value value, int64_t coefficient) {
+        if (coefficient == 0)
+        {
+            return;
+        }
+        if (coefficient != 1)
+        {
+            value = builder.create<arith::MulIOp>(loc, value, builder.create<arith::ConstantIndexOp>(loc, coefficient));
+        }
+        result = result ? builder.create<arith::AddIOp>(loc, result, value).getResult() : value;
+    };
+
+    accumulate(iv, index.ivCoefficient);
+    for (const auto& [value, coefficient] : index.invariantTerms)
+    {
+        accumulate(value, coefficient);
+    }
+    if (index.constant != 0 || !result)
+    {
+        accumulate(builder.create<arith::ConstantIndexOp>(loc, index.constant), 1);
+    }
+    return result;
+}
+
+// Finds groups of index computations in the body of the given loop that are worth replacing
+std::vector<IndexGroup> FindIndexGroups(scf::ForOp loop)
+{
+    llvm::SetVector<Value> candidates;
+    loop.getBody()->walk([&](Operation* op) {
+        for (auto index : GetAccessIndices(op))
+        {
+            auto definingOp = index.getDefiningOp();
+            if (definingOp && definingOp->getParentOp() == loop && index.getType().isIndex())
+            {
+                candidates.insert(index);
+            }
+        }
+    });
+
+    LinearIndexBuilder builder(loop);
+    std::vector<IndexGroup> groups;
+    for (auto candidate : candidates)
+    {
+        llvm::SetVector<Operation*> loopOps;
+        auto linearIndex = builder.Decompose(candidate, loopOps);
+        if (!linearIndex || linearIndex->ivCoefficient == 0)
+        {
+            continue;
+        }
+
+        auto it = llvm::find_if(groups, [&](const IndexGroup& group) { return group.base.HasSameBase(*linearIndex); });
+        if (it == groups.end())
+        {
+            IndexGroup group;
+            group.base = *linearIndex;
+            group.base.constant = 0;
+            groups.push_back(group);
+            it = std::prev(groups.end());
+        }
+        it->members.emplace_back(candidate, linearIndex->constant);
+        it->loopOps.insert(loopOps.begin(), loopOps.end());
+    }
+
+    groups.erase(std::remove_if(groups.begin(), groups.end(), [](const IndexGroup& group) { return group.SavedCost() <= 0; }), groups.end());
+    return groups;
+}
+
+void ReduceLoopIndices(scf::ForOp loop)
+{
+    auto groups = FindIndexGroups(loop);
+    if (groups.empty())
+    {
+        return;
+    }
+
+    auto loc = loop.getLoc();
+    OpBuilder builder(loop);
+
+    // The initial value of each loop-carried index is its base evaluated at the lower bound
+    llvm::SmallVector<Value, 4> newInits(loop.getIterOperands().begin(), loop.getIterOperands().end());
+    llvm::SmallVector<Value, 4> increments;
+    for (const auto& group : groups)
+    {
+        newInits.push_back(EmitLinearIndex(builder, loc, group.base, loop.getLowerBound()));
+
+        LinearIndex increment;
+        increment.ivCoefficient = group.base.ivCoefficient;
+        increments.push_back(EmitLinearIndex(builder, loc, increment, loop.getStep()));
+    }
+
+    auto newLoop = builder.create<scf::ForOp>(loc, loop.getLowerBound(), loop.getUpperBound(), loop.getStep(), newInits);
+    newLoop->setAttrs(loop->getAttrs());
+
+    // Move the body over to the new loop
+    auto oldBody = loop.getBody();
+    auto newBody = newLoop.getBody();
+    newBody->getOperations().splice(newBody->end(), oldBody->getOperations());
+    for (unsigned argIdx = 0; argIdx < oldBody->getNumArguments(); ++argIdx)
+    {
+        oldBody->getArgument(argIdx).replaceAllUsesWith(newBody->getArgument(argIdx));
+    }
+
+    // Replace the grouped indices with offsets from the loop-carried index
+    auto numOldIterArgs = loop.getNumIterOperands();
+    auto yieldOp = cast<scf::YieldOp>(newBody->getTerminator());
+    OpBuilder bodyBuilder = OpBuilder::atBlockBegin(newBody);
+    OpBuilder constantBuilder(newLoop);
+    llvm::SetVector<Operation*> replacedOps;
+    llvm::SmallVector<Value, 4> nextIndices;
+    for (unsigned groupIdx = 0; groupIdx < groups.size(); ++groupIdx)
+    {
+        auto& group = groups[groupIdx];
+        auto carriedIndex = newLoop.getRegionIterArgs()[numOldIterArgs + groupIdx];
+        for (const auto& [value, offset] : group.members)
+        {
+            Value replacement = carriedIndex;
+            if (offset != 0)
+            {
+                replacement = bodyBuilder.create<arith::AddIOp>(loc, carriedIndex, constantBuilder.create<arith::ConstantIndexOp>(loc, offset));
+            }
+            value.replaceAllUsesWith(replacement);
+        }
+        replacedOps.insert(group.loopOps.begin(), group.loopOps.end());
+
+        OpBuilder yieldBuilder(yieldOp);
+        nextIndices.push_back(yieldBuilder.create<arith::AddIOp>(loc, carriedIndex, increments[groupIdx]));
+    }
+    yieldOp->insertOperands(yieldOp->getNumOperands(), nextIndices);
+
+    loop.replaceAllUsesWith(newLoop.getResults().take_front(loop.getNumResults()));
+    loop.erase();
+
+    // Clean up the index computations that are no longer used
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (auto op : replacedOps)
+        {
+            if (op->use_empty())
+            {
+                replacedOps.remove(op);
+                op->erase();
+                changed = true;
+                break;
+            }
+        }
+    }
+}
+
+struct IndexStrengthReductionPass : public accera::transforms::AcceraIndexStrengthReductionBase<IndexStrengthReductionPass>
+{
+    void runOnOperation() final
+    {
+        // Visit inner loops first so the initial values they need in an outer loop's body can be
+        // reduced in turn by the outer loop
+        std::vector<scf::ForOp> loops;
+        getOperation()->walk([&](scf::ForOp loop) { loops.push_back(loop); });
+        for (auto loop : loops)
+        {
+            ReduceLoopIndices(loop);
+        }
+    }
+};
+
+} // namespace
+
+namespace accera::transforms::affine
+{
+std::unique_ptr<mlir::Pass> createIndexStrengthReductionPass()
+{
+    return std::make_unique<IndexStrengthReductionPass>();
+}
+} // namespace accera::transforms::affine
@@ -0,0 +1,346 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) Microsoft Corporation. All rights reserved.
+//  Licensed under the MIT License. See LICENSE in the project root for license information.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "argo/ArgoToLoopNest.h"
+
+#include "AcceraPasses.h"
+#include "util/LoopNestTemplates.h"
+
+#include <ir/include/argo/ArgoOps.h>
+#include <ir/include/exec/VectorizationInfo.h>
+#include <ir/include/nest/LoopNestOps.h>
+#include <ir/include/value/ValueDialect.h>
+
+#include <value/include/TargetDevice.h>
+
+#include <mlir/Dialect/Arithmetic/IR/Arithmetic.h>
+#include <mlir/IR/BuiltinTypes.h>
+#include <mlir/IR/PatternMatch.h>
+#include <mlir/Pass/Pass.h>
+#include <mlir/Transforms/GreedyPatternRewriteDriver.h>
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+using namespace mlir;
+
+namespace lnir = accera::ir::loopnest;
+namespace vir = accera::ir::value;
+namespace xpir = accera::ir::executionPlan;
+namespace argotr = accera::transforms::argo;
+
+using accera::transforms::AddActiveBlockCache;
+using accera::transforms::GetElementBytes;
+using accera::transforms::LoopNestTemplate;
+using accera::transforms::MakeLoopNestTemplate;
+using accera::transforms::ParallelizeLoop;
+using accera::transforms::PlanElementwiseLoopNest;
+using accera::transforms::ShouldParallelizeLoopNest;
+using accera::transforms::VectorizeLoop;
+
+namespace
+{
+xpir::VectorizationInfo GetVectorizationInfo(const argotr::ArgoToLoopNestOptions& options)
+{
+    return { options.vectorBytes, options.vectorUnits, false };
+}
+
+// Fill the output with a constant
+LoopNestTemplate MakeFillNest(PatternRewriter& rewriter, Value output, Attribute value, const argotr::ArgoToLoopNestOptions& options)
+{
+    auto outputType = output.getType().cast<MemRefType>();
+    auto loopNest = MakeLoopNestTemplate(rewriter, outputType.getShape(), [&](OpBuilder& builder, Location loc, ArrayRef<Value> indices) {
+        auto constant = builder.create<arith::ConstantOp>(loc, value);
+        (void)builder.create<vir::StoreOp>(loc, constant, output, indices);
+    });
+    PlanElementwiseLoopNest(loopNest, outputType.getShape(), GetElementBytes(outputType.getElementType()), GetVectorizationInfo(options), options.numThreads);
+    return loopNest;
+}
+
+bool CanLowerToNest(MemRefType type)
+{
+    return type && type.hasStaticShape() && type.getRank() > 0;
+}
+
+struct FillOpLowering : public OpRewritePattern<argo::FillOp>
+{
+    FillOpLowering(MLIRContext* context, const argotr::ArgoToLoopNestOptions& options) :
+        OpRewritePattern(context),
+        _options(options)
+    {}
+
+    LogicalResult matchAndRewrite(argo::FillOp op, PatternRewriter& rewriter) const final
+    {
+        auto outputType = op.output().getType().dyn_cast<MemRefType>();
+        auto value = op.value();
+        if (!CanLowerToNest(outputType) || value.getType() != outputType.getElementType())
+        {
+            return failure();
+        }
+
+        (void)MakeFillNest(rewriter, op.output(), value, _options);
+        rewriter.eraseOp(op);
+        return success();
+    }
+
+    argotr::ArgoToLoopNestOptions _options;
+};
+
+struct CopyOpLowering : public OpRewritePattern<argo::CopyOp>
+{
+    CopyOpLowering(MLIRContext* context, const argotr::ArgoToLoopNestOptions& options) :
+        OpRewritePattern(context),
+        _options(options)
+    {}
+
+    LogicalResult matchAndRewrite(argo::CopyOp op, PatternRewriter& rewriter) const final
+    {
+        auto input = op.input();
+        auto output = op.output();
+        auto inputType = input.getType().dyn_cast<MemRefType>();
+        auto outputType = output.getType().dyn_cast<MemRefType>();
+        if (!CanLowerToNest(inputType) || !CanLowerToNest(outputType) || inputType.getRank() != outputType.getRank())
+        {
+            return failure();
+        }
+
+        // I(input_perm(ivs)) -> O(output_perm(ivs)), where both maps must be permutations
+        auto context = op.getContext();
+        auto rank = inputType.getRank();
+        auto inputMap = argo::extractOrIdentityMap(op.inputPermutation(), rank, context);
+        auto outputMap = argo::extractOrIdentityMap(op.outputPermutation(), rank, context);
+        if (!inputMap.isPermutation() || !outputMap.isPermutation())
+        {
+            return failure();
+        }
+
+        std::vector<int64_t> sizes(rank);
+        for (unsigned r = 0; r < rank; ++r)
+        {
+            sizes[inputMap.getDimPosition(r)] = inputType.getShape()[r];
+        }
+        for (unsigned r = 0; r < rank; ++r)
+        {
+            if (outputType.getShape()[r] != sizes[outputMap.getDimPosition(r)])
+            {
+                return failure();
+            }
+        }
+
+        auto permute = [](AffineMap map, ArrayRef<Value> indices) {
+            std::vector<Value> result;
+            for (unsigned r = 0; r < map.getNumResults(); ++r)
+            {
+                result.push_back(indices[map.getDimPosition(r)]);
+            }
+            return result;
+        };
+
+        auto loopNest = MakeLoopNestTemplate(rewriter, sizes, [&](OpBuilder& builder, Location loc, ArrayRef<Value> indices) {
+            auto value = builder.create<vir::LoadOp>(loc, inputType.getElementType(), input, permute(inputMap, indices));
+            (void)builder.create<vir::StoreOp>(loc, value, output, permute(outputMap, indices));
+        });
+        PlanElementwiseLoopNest(loopNest, sizes, GetElementBytes(outputType.getElementType()), GetVectorizationInfo(_options), _options.numThreads);
+
+        rewriter.eraseOp(op);
+        return success();
+    }
+
+    argotr::ArgoToLoopNestOptions _options;
+};
+
+struct AccOpLowering : public OpRewritePattern<argo::AccOp>
+{
+    AccOpLowering(MLIRContext* context, const argotr::ArgoToLoopNestOptions& options) :
+        OpRewritePattern(context),
+        _options(options)
+    {}
+
+    LogicalResult matchAndRewrite(argo::AccOp op, PatternRewriter& rewriter) const final
+    {
+        auto input = op.getInput(0);
+        auto output = op.getOutputBuffer(0);
+        auto inputType = input.getType().dyn_cast<MemRefType>();
+        auto outputType = output.getType().dyn_cast<MemRefType>();
+        if (!CanLowerToNest(inputType) || !CanLowerToNest(outputType) || inputType.getShape() != outputType.getShape())
+        {
+            return failure();
+        }
+
+        // B(i, j) += A(i, j)
+        auto loopNest = MakeLoopNestTemplate(rewriter, outputType.getShape(), [&](OpBuilder& builder, Location loc, ArrayRef<Value> indices) {
+            auto a = builder.create<vir::LoadOp>(loc, inputType.getElementType(), input, indices);
+            auto b = builder.create<vir::LoadOp>(loc, outputType.getElementType(), output, indices);
+            auto sum = builder.create<vir::BinOp>(loc, vir::BinaryOpPredicate::ADD, b, a);
+            (void)builder.create<vir::StoreOp>(loc, sum, output, indices);
+        });
+        PlanElementwiseLoopNest(loopNest, outputType.getShape(), GetElementBytes(outputType.getElementType()), GetVectorizationInfo(_options), _options.numThreads);
+
+        rewriter.eraseOp(op);
+        return success();
+    }
+
+    argotr::ArgoToLoopNestOptions _options;
+};
+
+struct MatmulOpLowering : public OpRewritePattern<argo::MatmulOp>
+{
+    MatmulOpLowering(MLIRContext* context, const argotr::ArgoToLoopNestOptions& options) :
+        OpRewritePattern(context),
+        _options(options)
+    {}
+
+    LogicalResult matchAndRewrite(argo::MatmulOp op, PatternRewriter& rewriter) const final
+    {
+        auto A = op.getInput(0);
+        auto B = op.getInput(1);
+        auto C = op.getOutputBuffer(0);
+        auto aType = A.getType().dyn_cast<MemRefType>();
+        auto bType = B.getType().dyn_cast<MemRefType>();
+        auto cType = C.getType().dyn_cast<MemRefType>();
+        if (!CanLowerToNest(aType) || !CanLowerToNest(bType) || !CanLowerToNest(cType))
+        {
+            return failure();
+        }
+
+        // The kernel multiplies and accumulates without conversions
+        auto elementType = cType.getElementType();
+        if (aType.getElementType() != elementType || bType.getElementType() != elementType)
+        {
+            return failure();
+        }
+
+        auto M = cType.getShape()[0];
+        auto N = cType.getShape()[1];
+        auto K = aType.getShape()[1];
+        if (aType.getShape()[0] != M || bType.getShape()[0] != K || bType.getShape()[1] != N)
+        {
+            return failure();
+        }
+
+        // C = A @ B starts from zero, C += A @ B accumulates into C
+        if (!op.acc())
+        {
+            (void)MakeFillNest(rewriter, C, rewriter.getZeroAttr(cType.getElementType()), _options);
+        }
+
+        // C(i, j) += A(i, k) * B(k, j)
+        auto loopNest = MakeLoopNestTemplate(rewriter, { M, N, K }, [&](OpBuilder& builder, Location loc, ArrayRef<Value> indices) {
+            auto i = indices[0], j = indices[1], k = indices[2];
+            auto a = builder.create<vir::LoadOp>(loc, aType.getElementType(), A, ValueRange{ i, k });
+            auto b = builder.create<vir::LoadOp>(loc, bType.getElementType(), B, ValueRange{ k, j });
+            auto c = builder.create<vir::LoadOp>(loc, cType.getElementType(), C, ValueRange{ i, j });
+            auto product = builder.create<vir::BinOp>(loc, vir::BinaryOpPredicate::MUL, a, b);
+            auto sum = builder.create<vir::BinOp>(loc, vir::BinaryOpPredicate::ADD, c, product);
+            (void)builder.create<vir::StoreOp>(loc, sum, C, ValueRange{ i, j });
+        });
+        PlanMatmulNest(loopNest, B, M, N, K, GetElementBytes(elementType));
+
+        rewriter.eraseOp(op);
+        return success();
+    }
+
+    // The plan of the GEMM samples: a panel of B is packed into a cache, and each micro-kernel computes a
+    // tileM x (2 vectors) block of C in registers
+    void PlanMatmulNest(LoopNestTemplate& loopNest, Value B, int64_t M, int64_t N, int64_t K, int64_t elementBytes) const
+    {
+        auto schedule = loopNest.schedule;
+        auto [i, j, k] = std::make_tuple(loopNest.indices[0], loopNest.indices[1], loopNest.indices[2]);
+
+        auto vectorSize = std::max<int64_t>(_options.vectorBytes / elementBytes, 1);
+        auto tileN = std::min(_options.matmulTileN, N);
+        auto tileK = std::min(_options.matmulTileK, K);
+        auto tileM = std::min(_options.matmulTileM, M);
+        auto kernelN = std::min(2 * vectorSize, tileN);
+        vectorSize = std::min(vectorSize, kernelN);
+
+        auto [jOuter, jj] = schedule.split(j, static_cast<int>(tileN));
+        auto [kOuter, kk] = schedule.split(k, static_cast<int>(tileK));
+        auto [iOuter, ii] = schedule.split(i, static_cast<int>(tileM));
+        auto [jjOuter, jjj] = schedule.split(jj, static_cast<int>(kernelN));
+        auto [jjjOuter, jjjj] = schedule.split(jjj, static_cast<int>(vectorSize));
+        schedule.setOrder(std::vector<lnir::Index>{ jOuter, kOuter, iOuter, jjOuter, kk, ii, jjjOuter, jjjj });
+
+        AddActiveBlockCache(schedule, B, jjOuter, GetVectorizationInfo(_options));
+
+        schedule.unroll(ii);
+        schedule.unroll(jjjOuter);
+        if (vectorSize > 1)
+        {
+            VectorizeLoop(schedule, jjjj, GetVectorizationInfo(_options));
+        }
+        // Each thread computes whole panels of C, so there must be more than one
+        if (N > tileN && ShouldParallelizeLoopNest({ N, M, K }, _options.numThreads))
+        {
+            ParallelizeLoop(schedule, jOuter, _options.numThreads);
+        }
+    }
+
+    argotr::ArgoToLoopNestOptions _options;
+};
+
+struct ArgoToLoopNestPass : public accera::transforms::ArgoToLoopNestBase<ArgoToLoopNestPass>
+{
+    ArgoToLoopNestPass(const argotr::ArgoToLoopNestOptions& options = {})
+    {
+        vectorBytes = options.vectorBytes;
+        vectorUnits = options.vectorUnits;
+        numThreads = options.numThreads;
+        matmulTileM = options.matmulTileM;
+        matmulTileN = options.matmulTileN;
+        matmulTileK = options.matmulTileK;
+    }
+
+    void runOnOperation() final
+    {
+        argotr::ArgoToLoopNestOptions options;
+        options.vectorBytes = vectorBytes;
+        options.vectorUnits = vectorUnits;
+        options.numThreads = numThreads;
+        options.matmulTileM = matmulTileM;
+        options.matmulTileN = matmulTileN;
+        options.matmulTileK = matmulTileK;
+
+        RewritePatternSet patterns(&getContext());
+        argotr::populateArgoToLoopNestPatterns(patterns, options);
+        (void)applyPatternsAndFoldGreedily(getOperation(), std::move(patterns));
+    }
+};
+
+} // namespace
+
+namespace accera::transforms::argo
+{
+
+ArgoToLoopNestOptions GetArgoToLoopNestOptions(const accera::value::TargetDevice& target, int64_t numThreads)
+{
+    auto targetInfo = GetLoopNestTargetInfo(target, numThreads);
+
+    ArgoToLoopNestOptions options;
+    options.vectorBytes = targetInfo.vectorBytes;
+    options.vectorUnits = targetInfo.vectorUnits;
+    options.numThreads = targetInfo.numThreads;
+    return options;
+}
+
+void populateArgoToLoopNestPatterns(mlir::RewritePatternSet& patterns, const ArgoToLoopNestOptions& options)
+{
+    auto context = patterns.getContext();
+    patterns.insert<FillOpLowering, CopyOpLowering, AccOpLowering, MatmulOpLowering>(context, options);
+}
+
+std::unique_ptr<mlir::OperationPass<accera::ir::value::ValueFuncOp>> createArgoToLoopNestPass(const ArgoToLoopNestOptions& options)
+{
+    return std::make_unique<ArgoToLoopNestPass>(options);
+}
+
+std::unique_ptr<mlir::OperationPass<accera::ir::value::ValueFuncOp>> createArgoToLoopNestPass()
+{
+    return std::make_unique<ArgoToLoopNestPass>();
+}
+
+} // namespace accera::transforms::argo
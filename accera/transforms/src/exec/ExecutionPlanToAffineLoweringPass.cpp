@@ -1537,7 +1537,9 @@ MakeCacheOp UpdateActiveBlockCacheShape(PatternRewriter& rewriter,
     else
     {
         assert(cacheShape.size() == 1 && "Affine coefficient caches must be rank 1 buffers");
-        int64_t volumePlusOffset = activeBlockInfo.activeBlockVolume + cacheAccessContext.accessMaps.coefficients.offset;
+        // Padded and blocked layouts can need more room than the active block volume
+        int64_t volumePlusOffset = std::max(activeBlockInfo.activeBlockVolume + cacheAccessContext.accessMaps.coefficients.offset,
+                                            GetAffineLayoutBufferSize(cacheAccessContext.accessMaps.coefficients, activeBlockInfo.shape));
         if (cacheShape[0] == util::DynamicSizeSentinelValue)
         {
             cacheShape[0] = volumePlusOffset;
@@ -1560,7 +1562,8 @@ MakeCacheOp UpdateActiveBlockCacheShape(PatternRewriter& rewriter,
 }
 
 mlir::AffineMap CreateActiveBlockToCacheMap(PatternRewriter& rewriter,
-                                            CacheAccessContext& cacheAccessContext)
+                                            CacheAccessContext& cacheAccessContext,
+                                            const ActiveBlockInfo& activeBlockInfo)
 {
     mlir::AffineMap activeBlockToCacheMap;
     if (cacheAccessContext.dimReorderCache)
@@ -1571,7 +1574,7 @@ mlir::AffineMap CreateActiveBlockToCacheMap(PatternRewriter& rewriter,
     }
     else
     {
-        activeBlockToCacheMap = ComputeFlatAffineMapFromAffineCoefficients(rewriter, cacheAccessContext.accessMaps.coefficients);
+        activeBlockToCacheMap = ComputeFlatAffineMapFromAffineCoefficients(rewriter, cacheAccessContext.accessMaps.coefficients, activeBlockInfo.shape);
     }
     return activeBlockToCacheMap;
 }
@@ -5194,7 +5197,7 @@ LogicalResult BeginCreateCacheOpRewrite::matchAndRewrite(BeginCreateCacheOp begi
                                                                  currentMultiCacheInfo.activeBlockInfo,
                                                                  currentMultiCacheInfo.multiCacheIterationCounts);
 
-            currentMultiCacheInfo.activeBlockToCacheMap = CreateActiveBlockToCacheMap(rewriter, tempActiveBlockRegionInfo.cacheAccessContext);
+            currentMultiCacheInfo.activeBlockToCacheMap = CreateActiveBlockToCacheMap(rewriter, tempActiveBlockRegionInfo.cacheAccessContext, currentMultiCacheInfo.activeBlockInfo);
 
             size_t activeBlockRank = currentMultiCacheInfo.activeBlockInfo.shape.size();
             std::vector<mlir::Value> multiCacheIVs;
@@ -4,17 +4,27 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "AcceraPasses.h"
+#include "util/LoopNestTemplates.h"
 
+#include <ir/include/IRUtil.h>
+#include <ir/include/exec/ExecutionPlanAttributes.h>
 #include <ir/include/nest/LoopNestOps.h>
 #include <ir/include/value/ValueFuncOp.h>
 #include <value/include/Debugging.h>
+#include <value/include/FunctionDeclaration.h>
 
 #include <llvm/ADT/TypeSwitch.h>
+#include <mlir/Dialect/Arithmetic/IR/Arithmetic.h>
 #include <mlir/IR/Builders.h>
 #include <mlir/IR/BuiltinTypes.h>
 #include <mlir/IR/MLIRContext.h>
 #include <mlir/Transforms/GreedyPatternRewriteDriver.h>
 
+#include <cmath>
+#include <map>
+#include <optional>
+#include <random>
+
 using namespace mlir;
 namespace ir = accera::ir;
 
@@ -89,7 +99,358 @@ void MapArguments(PatternRewriter& rewriter, ir::value::ValueFuncOp& targetFnOp,
     });
 }
 
-void CreateReferenceSchedules(PatternRewriter& rewriter, ir::loopnest::ScheduleOp& scheduleOp, BlockAndValueMapping& valueMap)
+// Check functions are specified per input/output arguments and empty strings for input arguments
+std::vector<std::string> GetCheckFunctions(ir::value::ValueFuncOp& targetFnOp)
+{
+    std::vector<std::string> result;
+    if (targetFnOp->hasAttr(ir::GetOutputVerifiersAttrName()))
+    {
+        auto checkFunctionAttrs = targetFnOp->getAttrOfType<ArrayAttr>(ir::GetOutputVerifiersAttrName()).getValue();
+
+        std::transform(checkFunctionAttrs.begin(), checkFunctionAttrs.end(), std::back_inserter(result), [](auto attr) {
+            return attr.template cast<StringAttr>().getValue().str();
+        });
+    }
+
+    return result;
+}
+
+// Output arg number -> the nest index that addresses each dimension of the output arg
+using OutputAccessIndices = std::map<unsigned, std::vector<ir::loopnest::Index>>;
+
+// Finds the nest indices addressing the output args, if every output element is accessed at the position
+// given by the nest indices directly (e.g. C[i, j]). Returns std::nullopt for any other access pattern.
+std::optional<OutputAccessIndices> GetOutputAccessIndices(ir::value::ValueFuncOp& targetFnOp, ir::loopnest::NestOp& targetNestOp)
+{
+    OutputAccessIndices result;
+    for (auto [arg, checkFunction] : llvm::zip(targetFnOp.getArguments(), GetCheckFunctions(targetFnOp)))
+    {
+        if (checkFunction.empty())
+        {
+            continue;
+        }
+
+        auto memrefType = arg.getType().dyn_cast<MemRefType>();
+        if (!memrefType)
+        {
+            return std::nullopt;
+        }
+
+        std::optional<std::vector<ir::loopnest::Index>> outputIndices;
+        for (auto user : arg.getUsers())
+        {
+            if (!targetNestOp->isAncestor(user))
+            {
+                continue;
+            }
+
+            auto sliceOp = mlir::dyn_cast<ir::value::SliceOp>(user);
+            if (!sliceOp || sliceOp.source() != arg || static_cast<int64_t>(sliceOp.offsets().size()) != memrefType.getRank())
+            {
+                return std::nullopt;
+            }
+
+            std::vector<ir::loopnest::Index> indices;
+            for (auto offset : sliceOp.offsets())
+            {
+                auto indexOp = offset.getDefiningOp<ir::loopnest::SymbolicIndexOp>();
+                if (!indexOp || std::find(indices.begin(), indices.end(), indexOp.getValue()) != indices.end())
+                {
+                    return std::nullopt;
+                }
+                indices.push_back(indexOp.getValue());
+            }
+
+            if (outputIndices && *outputIndices != indices)
+            {
+                return std::nullopt;
+            }
+            outputIndices = indices;
+        }
+
+        if (!outputIndices)
+        {
+            return std::nullopt;
+        }
+        result[arg.getArgNumber()] = *outputIndices;
+    }
+
+    if (result.empty())
+    {
+        return std::nullopt;
+    }
+    return result;
+}
+
+// A sampled output index of the reference schedule: the reference iterates over `range` and evaluates
+// the kernels at `index * scale + offset`, which visits a strided subset of the original index range
+struct SampledIndex
+{
+    ir::loopnest::Range range;
+    int64_t scale;
+    int64_t offset;
+};
+
+struct ReferenceSampling
+{
+    std::map<ir::loopnest::Index, SampledIndex> indices;
+    OutputAccessIndices outputIndices;
+};
+
+// Determines how to sample the reference schedule so that it computes roughly `samples` output elements.
+// Sampling is only possible when the output indices can be remapped without changing the computed
+// values (see GetOutputAccessIndices). Returns std::nullopt if the reference must compute the full output.
+std::optional<ReferenceSampling> GetReferenceSampling(ir::value::ValueFuncOp& targetFnOp, ir::loopnest::ScheduleOp& scheduleOp)
+{
+    auto samplesAttr = targetFnOp->getAttrOfType<IntegerAttr>(ir::GetVerificationSamplesAttrName());
+    if (!samplesAttr || samplesAttr.getInt() <= 0 || !scheduleOp.getFusedDomains().empty())
+    {
+        return std::nullopt;
+    }
+
+    auto targetNestOp = scheduleOp.getNest();
+    auto outputIndices = GetOutputAccessIndices(targetFnOp, targetNestOp);
+    if (!outputIndices)
+    {
+        return std::nullopt;
+    }
+
+    for (const auto& [argNumber, indices] : *outputIndices)
+    {
+        if (!targetFnOp.getArgument(argNumber).getType().cast<MemRefType>().hasStaticShape())
+        {
+            return std::nullopt;
+        }
+    }
+
+    ReferenceSampling result;
+    result.outputIndices = *outputIndices;
+
+    std::vector<ir::loopnest::IndexRange> outputRanges;
+    for (const auto& indexRange : targetNestOp.getDomain().getValue().GetRanges())
+    {
+        bool isOutputIndex = llvm::any_of(result.outputIndices, [&](const auto& entry) {
+            return llvm::is_contained(entry.second, indexRange.GetIndex());
+        });
+        if (isOutputIndex)
+        {
+            const auto& range = indexRange.GetRange();
+            if (!range.HasConstantBegin() || !range.HasConstantEnd())
+            {
+                return std::nullopt;
+            }
+            outputRanges.push_back(indexRange);
+        }
+    }
+
+    // Spread the samples evenly over the output dimensions, at a pseudo-random phase within each dimension
+    auto samplesPerIndex = static_cast<int64_t>(std::ceil(std::pow(static_cast<double>(samplesAttr.getInt()), 1.0 / outputRanges.size())));
+    std::mt19937_64 generator(std::hash<std::string>{}(targetFnOp.sym_name().str()));
+    bool sampled = false;
+    for (const auto& indexRange : outputRanges)
+    {
+        const auto& range = indexRange.GetRange();
+        auto numIterations = range.NumIterations();
+        auto count = std::min(numIterations, samplesPerIndex);
+        auto stride = numIterations / count;
+        auto maxPhase = numIterations - 1 - (count - 1) * stride;
+        auto phase = maxPhase > 0 ? static_cast<int64_t>(generator() % (maxPhase + 1)) : 0;
+
+        result.indices.emplace(indexRange.GetIndex(), SampledIndex{ ir::loopnest::Range(0, count), stride * range.Increment(), range.Begin() + phase * range.Increment() });
+        sampled |= count < numIterations;
+    }
+
+    if (!sampled)
+    {
+        return std::nullopt;
+    }
+    return result;
+}
+
+// A generic plan for the (non-fused) reference schedule: the outermost index that addresses every output runs in
+// parallel on the target's threads and the innermost index that addresses the contiguous dimension of every output
+// is vectorized with the target's vector width. Iterations of these indices write distinct output elements, so the
+// plan does not change the order in which any single output element is updated.
+struct ReferencePlan
+{
+    std::optional<ir::loopnest::Index> parallelIndex;
+    std::optional<ir::loopnest::Index> vectorIndex;
+    int64_t vectorSize = 0;
+    accera::transforms::EmitDebugFunctionOptions options;
+};
+
+std::optional<ReferencePlan> GetReferencePlan(ir::value::ValueFuncOp& targetFnOp, ir::loopnest::ScheduleOp& scheduleOp, const accera::transforms::EmitDebugFunctionOptions& options)
+{
+    if (!scheduleOp.getFusedDomains().empty())
+    {
+        return std::nullopt;
+    }
+
+    auto targetNestOp = scheduleOp.getNest();
+    auto outputIndices = GetOutputAccessIndices(targetFnOp, targetNestOp);
+    if (!outputIndices)
+    {
+        return std::nullopt;
+    }
+
+    // Every array the nest can write to must be one of the indexed outputs
+    auto usagesAttr = targetFnOp->getAttrOfType<ArrayAttr>(ir::UsagesAttrName);
+    if (!usagesAttr)
+    {
+        return std::nullopt;
+    }
+    auto usages = ir::util::ConvertArrayAttrToIntVector(usagesAttr);
+    for (auto arg : targetFnOp.getArguments())
+    {
+        auto argNumber = arg.getArgNumber();
+        if (arg.getType().isa<MemRefType>() && argNumber < usages.size() &&
+            usages[argNumber] != static_cast<int64_t>(accera::value::FunctionParameterUsage::input) &&
+            outputIndices->count(argNumber) == 0)
+        {
+            return std::nullopt;
+        }
+    }
+
+    // Temporary arrays and function calls may carry state between iterations
+    auto result = targetNestOp.walk([](Operation* op) {
+        if (mlir::isa<ir::value::CallOp, ir::value::LaunchFuncOp>(op) ||
+            llvm::any_of(op->getOperands(), [](mlir::Value operand) { return operand.getDefiningOp<ir::value::AllocOp>() != nullptr; }))
+        {
+            return WalkResult::interrupt();
+        }
+        return WalkResult::advance();
+    });
+    if (result.wasInterrupted())
+    {
+        return std::nullopt;
+    }
+
+    ReferencePlan plan;
+    plan.options = options;
+    if (options.numThreads > 1)
+    {
+        for (const auto& indexRange : targetNestOp.getDomain().getValue().GetRanges())
+        {
+            auto index = indexRange.GetIndex();
+            if (llvm::all_of(*outputIndices, [&](const auto& entry) { return llvm::is_contained(entry.second, index); }))
+            {
+                plan.parallelIndex = index;
+                break;
+            }
+        }
+    }
+
+    int64_t elementBytes = 0;
+    auto contiguousIndex = outputIndices->begin()->second.back();
+    bool isContiguous = llvm::all_of(*outputIndices, [&](const auto& entry) {
+        auto memrefType = mlir::canonicalizeStridedLayout(targetFnOp.getArgument(entry.first).getType().template cast<MemRefType>());
+        auto elementType = memrefType.getElementType();
+        if (!memrefType.getLayout().isIdentity() || !elementType.isIntOrFloat() || elementType.getIntOrFloatBitWidth() % 8 != 0)
+        {
+            return false;
+        }
+
+        auto bytes = static_cast<int64_t>(elementType.getIntOrFloatBitWidth() / 8);
+        if (elementBytes != 0 && elementBytes != bytes)
+        {
+            return false;
+        }
+        elementBytes = bytes;
+        return entry.second.back() == contiguousIndex;
+    });
+    if (isContiguous && elementBytes < options.vectorBytes)
+    {
+        plan.vectorIndex = contiguousIndex;
+        plan.vectorSize = options.vectorBytes / elementBytes;
+    }
+
+    return plan;
+}
+
+void ApplyReferencePlan(ir::loopnest::ScheduleOp& schedule, const ir::loopnest::IterationDomain& domain, const ReferencePlan& plan, const std::optional<ReferenceSampling>& sampling)
+{
+    auto parallelIndex = plan.parallelIndex;
+    std::optional<ir::loopnest::Index> vectorIndex;
+
+    // Sampled indices are strided, so they are not contiguous in the reference
+    if (plan.vectorIndex && !(sampling && sampling->indices.count(*plan.vectorIndex)))
+    {
+        auto ranges = domain.GetRanges();
+        auto it = std::find_if(ranges.begin(), ranges.end(), [&](const auto& indexRange) { return indexRange.GetIndex() == *plan.vectorIndex; });
+        if (it != ranges.end() && it->GetRange().HasConstantBegin() && it->GetRange().HasConstantEnd() && it->GetRange().Increment() == 1)
+        {
+            vectorIndex = plan.vectorIndex;
+            if (it->GetRange().NumIterations() > plan.vectorSize)
+            {
+                auto splitIndex = schedule.split(*vectorIndex, static_cast<int>(plan.vectorSize));
+                if (parallelIndex == vectorIndex)
+                {
+                    parallelIndex = splitIndex.outer;
+                }
+                vectorIndex = splitIndex.inner;
+            }
+            else if (parallelIndex == vectorIndex)
+            {
+                parallelIndex.reset();
+            }
+        }
+    }
+
+    if (!parallelIndex && !vectorIndex)
+    {
+        return;
+    }
+
+    std::vector<ir::loopnest::Index> order;
+    if (parallelIndex)
+    {
+        order.push_back(*parallelIndex);
+    }
+    for (const auto& index : schedule.getOrder())
+    {
+        if (index != parallelIndex && index != vectorIndex)
+        {
+            order.push_back(index);
+        }
+    }
+    if (vectorIndex)
+    {
+        order.push_back(*vectorIndex);
+    }
+    schedule.setOrder(order);
+
+    OpBuilder builder(schedule);
+    if (parallelIndex)
+    {
+        ir::executionPlan::ParallelizationInfo parallelizationInfo{ plan.options.numThreads, /*isDynamicPolicy=*/false };
+        schedule.addLoopAttribute(*parallelIndex, builder.getStringAttr(ir::executionPlan::ParallelizationInfoAttr::getKeyName()), ir::executionPlan::ParallelizationInfoAttr::get(parallelizationInfo, builder.getContext()));
+    }
+    if (vectorIndex)
+    {
+        ir::executionPlan::VectorizationInfo vectorizationInfo{ plan.options.vectorBytes, plan.options.vectorUnits, /*unrollOnly=*/false };
+        schedule.addLoopAttribute(*vectorIndex, builder.getStringAttr(ir::executionPlan::VectorizationInfoAttr::getKeyName()), ir::executionPlan::VectorizationInfoAttr::get(vectorizationInfo, builder.getContext()));
+    }
+}
+
+mlir::Value GetSampledIndexValue(OpBuilder& builder, Location loc, mlir::Value index, const SampledIndex& sampledIndex)
+{
+    auto scale = builder.create<arith::ConstantIndexOp>(loc, sampledIndex.scale);
+    auto offset = builder.create<arith::ConstantIndexOp>(loc, sampledIndex.offset);
+    return builder.create<arith::AddIOp>(loc, builder.create<arith::MulIOp>(loc, index, scale), offset);
+}
+
+// Rewrites the uses of a sampled symbolic index within a kernel to address the sampled position
+void RemapSampledIndex(ir::loopnest::KernelOp& kernel, mlir::Value index, const SampledIndex& sampledIndex)
+{
+    auto builder = OpBuilder::atBlockBegin(kernel.getBody());
+    auto sampledValue = GetSampledIndexValue(builder, kernel.getLoc(), index, sampledIndex);
+    auto scaleOp = sampledValue.getDefiningOp()->getOperand(0).getDefiningOp();
+    index.replaceUsesWithIf(sampledValue, [&](OpOperand& use) {
+        return use.getOwner() != scaleOp && kernel->isProperAncestor(use.getOwner());
+    });
+}
+
+void CreateReferenceSchedules(PatternRewriter& rewriter, ir::loopnest::ScheduleOp& scheduleOp, BlockAndValueMapping& valueMap, const std::optional<ReferenceSampling>& sampling, const std::optional<ReferencePlan>& plan)
 {
     auto targetNestOp = scheduleOp.getNest();
     if (auto fusedDomains = scheduleOp.getFusedDomains(); !fusedDomains.empty())
@@ -140,6 +501,17 @@ void CreateReferenceSchedules(PatternRewriter& rewriter, ir::loopnest::ScheduleO
     {
         // Non-fusing case: duplicate the nest with its kernel(s)
         auto domain = targetNestOp.getDomain().getValue();
+        if (sampling)
+        {
+            // Only iterate over the sampled output positions
+            std::vector<ir::loopnest::IndexRange> ranges;
+            for (const auto& indexRange : domain.GetRanges())
+            {
+                auto it = sampling->indices.find(indexRange.GetIndex());
+                ranges.emplace_back(indexRange.GetIndex(), it != sampling->indices.end() ? it->second.range : indexRange.GetRange());
+            }
+            domain = ir::loopnest::IterationDomain(ranges);
+        }
         auto nest = ir::loopnest::MakeNest(rewriter, domain);
         auto nestBuilder = nest.getBodyBuilder();
 
@@ -159,29 +531,29 @@ void CreateReferenceSchedules(PatternRewriter& rewriter, ir::loopnest::ScheduleO
             return mlir::cast<ir::loopnest::KernelOp>(nestBuilder.clone(*knl.getOperation(), valueMap));
         });
 
+        if (sampling)
+        {
+            for (auto& kernel : kernels)
+            {
+                for (const auto& [index, sampledIndex] : sampling->indices)
+                {
+                    RemapSampledIndex(kernel, nest.getOrCreateSymbolicIndex(nestBuilder, index), sampledIndex);
+                }
+            }
+        }
+
         // Create the schedule and add the kernels (after the symbolic indices have been inserted into the IR)
         auto defaultSchedule = nest.getOrCreateSchedule();
         for (auto& kernel : kernels)
         {
             defaultSchedule.addKernel(kernel);
         }
-    }
-}
 
-// Check functions are specified per input/output arguments and empty strings for input arguments
-std::vector<std::string> GetCheckFunctions(ir::value::ValueFuncOp& targetFnOp)
-{
-    std::vector<std::string> result;
-    if (targetFnOp->hasAttr(ir::GetOutputVerifiersAttrName()))
-    {
-        auto checkFunctionAttrs = targetFnOp->getAttrOfType<ArrayAttr>(ir::GetOutputVerifiersAttrName()).getValue();
-
-        std::transform(checkFunctionAttrs.begin(), checkFunctionAttrs.end(), std::back_inserter(result), [](auto attr) {
-            return attr.template cast<StringAttr>().getValue().str();
-        });
+        if (plan)
+        {
+            ApplyReferencePlan(defaultSchedule, domain, *plan, sampling);
+        }
     }
-
-    return result;
 }
 
 std::vector<mlir::Value> GetTargetFunctionArgs(PatternRewriter& rewriter, Location loc, ir::value::ValueModuleOp& moduleOp, ir::value::ValueFuncOp& targetFnOp, ir::value::ValueFuncOp& dbgFnOp)
@@ -256,13 +628,57 @@ std::vector<mlir::Value> GetTargetFunctionArgs(PatternRewriter& rewriter, Locati
     return result;
 }
 
-LogicalResult EmitNestDebugFunction(ir::value::ValueFuncOp& targetFnOp, PatternRewriter& rewriter)
+// Overlays the sampled reference results onto a copy of the target results so that the check function
+// compares the target against the reference at the sampled positions only
+mlir::Value CreateSampledComparisonBuffer(PatternRewriter& rewriter, Location loc, ir::value::ValueModuleOp& moduleOp, ir::value::ValueFuncOp& dbgFnOp, mlir::Value targetArg, mlir::Value debugArg, const std::vector<ir::loopnest::Index>& outputIndices, const ReferenceSampling& sampling)
+{
+    auto memrefType = targetArg.getType().cast<MemRefType>();
+    std::string name = moduleOp.getName().str() + "_" + dbgFnOp.getName().str() + "_sampled_output_arg";
+    auto buffer = ir::util::CreateGlobalBuffer(rewriter, dbgFnOp, memrefType, name);
+
+    // Replace the global-scoped ReferenceGlobalOp with one within the function context
+    auto globalScopeGlobalRef = mlir::dyn_cast_or_null<ir::value::ReferenceGlobalOp>(buffer.getDefiningOp());
+    mlir::Value localScopeGlobalRef = rewriter.create<ir::value::ReferenceGlobalOp>(loc, globalScopeGlobalRef.getGlobal());
+    rewriter.eraseOp(globalScopeGlobalRef);
+
+    (void)rewriter.create<ir::value::CopyOp>(loc, targetArg, localScopeGlobalRef);
+
+    std::vector<ir::loopnest::IndexRange> ranges;
+    for (const auto& index : outputIndices)
+    {
+        ranges.emplace_back(ir::loopnest::Index(index.GetName() + "_sample"), sampling.indices.at(index).range);
+    }
+
+    auto nest = ir::loopnest::MakeNest(rewriter, ir::loopnest::IterationDomain(ranges));
+    auto nestBuilder = nest.getBodyBuilder();
+    std::vector<mlir::Value> symbolicIndices;
+    for (const auto& indexRange : ranges)
+    {
+        symbolicIndices.push_back(nest.getOrCreateSymbolicIndex(nestBuilder, indexRange.GetIndex()));
+    }
+
+    auto kernel = ir::loopnest::MakeKernel(nestBuilder, "sampled_output", [&](OpBuilder& builder, Location kernelLoc) {
+        std::vector<mlir::Value> offsets;
+        for (unsigned i = 0; i < outputIndices.size(); ++i)
+        {
+            offsets.push_back(GetSampledIndexValue(builder, kernelLoc, symbolicIndices[i], sampling.indices.at(outputIndices[i])));
+        }
+        auto value = builder.create<ir::value::LoadOp>(kernelLoc, memrefType.getElementType(), debugArg, offsets);
+        (void)builder.create<ir::value::StoreOp>(kernelLoc, value, localScopeGlobalRef, offsets);
+    });
+    nest.getOrCreateSchedule().addKernel(kernel);
+
+    return localScopeGlobalRef;
+}
+
+LogicalResult EmitNestDebugFunction(ir::value::ValueFuncOp& targetFnOp, PatternRewriter& rewriter, const accera::transforms::EmitDebugFunctionOptions& options)
 {
     // Find the ScheduleOp
     auto scheduleOp = GetScheduleOp(targetFnOp);
     if (!scheduleOp)
     {
         targetFnOp->removeAttr(ir::GetOutputVerifiersAttrName());
+        targetFnOp->removeAttr(ir::GetVerificationSamplesAttrName());
         return failure(); // no match
     }
 
@@ -276,6 +692,8 @@ LogicalResult EmitNestDebugFunction(ir::value::ValueFuncOp& targetFnOp, PatternR
     auto targetLaunchFnOp = GetLaunchFunctionOp(moduleOp, targetFnOp);
     auto namePrefix = targetLaunchFnOp ? targetLaunchFnOp.sym_name().str() : targetFnOp.sym_name().str();
     auto dbgFnName = std::string("_debug_") + namePrefix;
+    auto sampling = GetReferenceSampling(targetFnOp, scheduleOp);
+    auto referencePlan = GetReferencePlan(targetFnOp, scheduleOp, options);
 
     // Create a new function op with the same arguments and return value as the target function
     //      void dbgFnOp(args, ...)
@@ -287,7 +705,7 @@ LogicalResult EmitNestDebugFunction(ir::value::ValueFuncOp& targetFnOp, PatternR
     //          Copy output targetFnArgs to output args
     //      }
     // TODO: The last copy can be avoided if we wrap the default schedule impl within its own ValueFuncOp
-    auto dbgFnOp = [&rewriter, loc, &moduleOp, &targetFnOp, &scheduleOp, dbgFnName]() -> ir::value::ValueFuncOp {
+    auto dbgFnOp = [&rewriter, loc, &moduleOp, &targetFnOp, &scheduleOp, &sampling, &referencePlan, dbgFnName]() -> ir::value::ValueFuncOp {
         OpBuilder::InsertionGuard guard(rewriter);
 
         auto funcInsertPt = ir::util::GetTerminalInsertPoint<ir::value::ValueModuleOp,
@@ -303,12 +721,16 @@ LogicalResult EmitNestDebugFunction(ir::value::ValueFuncOp& targetFnOp, PatternR
         {
             wrapperFnOp->setAttr(ir::DynamicArgSizeReferencesAttrName, dynamicArgSizeRefs);
         }
+        if (auto argConstraints = targetFnOp->getAttrOfType<mlir::ArrayAttr>(ir::ArgConstraintsAttrName))
+        {
+            wrapperFnOp->setAttr(ir::ArgConstraintsAttrName, argConstraints);
+        }
 
         rewriter.setInsertionPointToStart(&wrapperFnOp.body().front());
 
         BlockAndValueMapping valueMap;
         MapArguments(rewriter, targetFnOp, wrapperFnOp, valueMap);
-        CreateReferenceSchedules(rewriter, scheduleOp, valueMap);
+        CreateReferenceSchedules(rewriter, scheduleOp, valueMap, sampling, referencePlan);
 
         return wrapperFnOp;
     }();
@@ -338,12 +760,20 @@ LogicalResult EmitNestDebugFunction(ir::value::ValueFuncOp& targetFnOp, PatternR
             {
                 if (!checkFunction.empty())
                 {
+                    // When sampling, the reference only holds valid results at the sampled positions
+                    mlir::Value expectedArg = debugArg;
+                    if (sampling)
+                    {
+                        auto argNumber = debugArg.cast<BlockArgument>().getArgNumber();
+                        expectedArg = CreateSampledComparisonBuffer(rewriter, loc, moduleOp, dbgFnOp, targetArg, debugArg, sampling->outputIndices.at(argNumber), *sampling);
+                    }
+
                     if (auto utilityFnOp = FindValueFunctionOp(moduleOp, checkFunction))
                     {
                         auto memRefType = targetArg.getType().cast<MemRefType>();
                         if (memRefType.getNumDynamicDims() > 0)
                         {
-                            std::vector<mlir::Value> operands = {targetArg, debugArg};
+                            std::vector<mlir::Value> operands = {targetArg, expectedArg};
                             auto utilityFnOpArgs = utilityFnOp.getArguments();
                             int countOfArgsToBeCopied = utilityFnOpArgs.size() - operands.size();
                             for (int i = countOfArgsToBeCopied - 1; i >= 0; i--)
@@ -354,7 +784,7 @@ LogicalResult EmitNestDebugFunction(ir::value::ValueFuncOp& targetFnOp, PatternR
                         }
                         else
                         {
-                            (void)rewriter.create<ir::value::LaunchFuncOp>(loc, utilityFnOp, mlir::ValueRange{ targetArg, debugArg });
+                            (void)rewriter.create<ir::value::LaunchFuncOp>(loc, utilityFnOp, mlir::ValueRange{ targetArg, expectedArg });
                         }
                     }
 
@@ -385,19 +815,27 @@ LogicalResult EmitNestDebugFunction(ir::value::ValueFuncOp& targetFnOp, PatternR
         {
             newLaunchFnOp->setAttr(ir::DynamicArgSizeReferencesAttrName, dynamicArgSizeRefs);
         }
+        if (auto argConstraints = targetLaunchFnOp->getAttrOfType<mlir::ArrayAttr>(ir::ArgConstraintsAttrName))
+        {
+            newLaunchFnOp->setAttr(ir::ArgConstraintsAttrName, argConstraints);
+        }
         // TODO : Clone more attributes?
 
         rewriter.eraseOp(targetLaunchFnOp);
     }
 
     targetFnOp->removeAttr(ir::GetOutputVerifiersAttrName());
+    targetFnOp->removeAttr(ir::GetVerificationSamplesAttrName());
 
     return success();
 }
 
 struct EmitDebugFunctionPattern final : public OpRewritePattern<ir::value::ValueFuncOp>
 {
-    using OpRewritePattern<ir::value::ValueFuncOp>::OpRewritePattern;
+    EmitDebugFunctionPattern(MLIRContext* context, const accera::transforms::EmitDebugFunctionOptions& options) :
+        OpRewritePattern(context),
+        _options(options)
+    {}
 
     LogicalResult matchAndRewrite(ir::value::ValueFuncOp op, PatternRewriter& rewriter) const final
     {
@@ -406,24 +844,38 @@ struct EmitDebugFunctionPattern final : public OpRewritePattern<ir::value::Value
             return failure(); // no match
         }
 
-        return EmitNestDebugFunction(op, rewriter);
+        return EmitNestDebugFunction(op, rewriter, _options);
     }
+
+    accera::transforms::EmitDebugFunctionOptions _options;
 };
 
-void populateEmitDebugFunctionPatterns(OwningRewritePatternList& patterns)
+void populateEmitDebugFunctionPatterns(OwningRewritePatternList& patterns, const accera::transforms::EmitDebugFunctionOptions& options)
 {
-    patterns.insert<EmitDebugFunctionPattern>(patterns.getContext());
+    patterns.insert<EmitDebugFunctionPattern>(patterns.getContext(), options);
 }
 
 struct EmitDebugFunctionPass : public accera::transforms::EmitDebugFunctionBase<EmitDebugFunctionPass>
 {
+    EmitDebugFunctionPass(const accera::transforms::EmitDebugFunctionOptions& options = {})
+    {
+        vectorBytes = options.vectorBytes;
+        vectorUnits = options.vectorUnits;
+        numThreads = options.numThreads;
+    }
+
     void runOnModule() override
     {
         MLIRContext* context = &getContext();
         auto moduleOp = getOperation();
 
+        accera::transforms::EmitDebugFunctionOptions options;
+        options.vectorBytes = vectorBytes;
+        options.vectorUnits = vectorUnits;
+        options.numThreads = numThreads;
+
         RewritePatternSet patterns(context);
-        populateEmitDebugFunctionPatterns(patterns);
+        populateEmitDebugFunctionPatterns(patterns, options);
 
         (void)applyPatternsAndFoldGreedily(moduleOp, std::move(patterns));
     }
@@ -432,6 +884,22 @@ struct EmitDebugFunctionPass : public accera::transforms::EmitDebugFunctionBase<
 
 namespace accera::transforms
 {
+EmitDebugFunctionOptions GetEmitDebugFunctionOptions(const accera::value::TargetDevice& target, int64_t numThreads)
+{
+    auto targetInfo = GetLoopNestTargetInfo(target, numThreads);
+
+    EmitDebugFunctionOptions options;
+    options.vectorBytes = targetInfo.vectorBytes;
+    options.vectorUnits = targetInfo.vectorUnits;
+    options.numThreads = targetInfo.numThreads;
+    return options;
+}
+
+std::unique_ptr<OperationPass<ModuleOp>> createEmitDebugFunctionPass(const EmitDebugFunctionOptions& options)
+{
+    return std::make_unique<EmitDebugFunctionPass>(options);
+}
+
 std::unique_ptr<OperationPass<ModuleOp>> createEmitDebugFunctionPass()
 {
     return std::make_unique<EmitDebugFunctionPass>();
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) Microsoft Corporation. All rights reserved.
+//  Licensed under the MIT License. See LICENSE in the project root for license information.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "util/LoopNestTemplates.h"
+
+#include <ir/include/IRUtil.h>
+#include <ir/include/exec/ExecutionPlanAttributes.h>
+#include <ir/include/exec/ExecutionPlanOps.h>
+#include <ir/include/exec/ParallelizationInfo.h>
+#include <ir/include/value/ValueDialect.h>
+
+#include <utilities/include/MemoryLayout.h>
+
+#include <value/include/TargetDevice.h>
+
+#include <mlir/IR/BuiltinTypes.h>
+
+#include <algorithm>
+#include <numeric>
+#include <optional>
+
+using namespace mlir;
+
+namespace lnir = accera::ir::loopnest;
+namespace vir = accera::ir::value;
+namespace xpir = accera::ir::executionPlan;
+
+namespace
+{
+// Nests with fewer elements than this aren't worth the cost of starting threads
+constexpr int64_t kMinParallelElements = 1 << 16;
+} // namespace
+
+namespace accera::transforms
+{
+
+LoopNestTargetInfo GetLoopNestTargetInfo(const accera::value::TargetDevice& target, int64_t numThreads)
+{
+    LoopNestTargetInfo info;
+    if (target.HasFeature("avx512f"))
+    {
+        info.vectorBytes = 64;
+        info.vectorUnits = 32;
+    }
+    else if (target.HasFeature("avx"))
+    {
+        info.vectorBytes = 32;
+        info.vectorUnits = 16;
+    }
+    else if (target.HasFeature("neon"))
+    {
+        info.vectorBytes = 16;
+        info.vectorUnits = 32;
+    }
+    else if (target.HasFeature("sse"))
+    {
+        info.vectorBytes = 16;
+        info.vectorUnits = 16;
+    }
+
+    info.numThreads = numThreads;
+    return info;
+}
+
+int64_t GetElementBytes(Type elementType)
+{
+    return std::max<int64_t>(elementType.getIntOrFloatBitWidth() / 8, 1);
+}
+
+bool ShouldParallelizeLoopNest(ArrayRef<int64_t> shape, int64_t numThreads)
+{
+    auto volume = std::accumulate(shape.begin(), shape.end(), int64_t{ 1 }, std::multiplies<int64_t>());
+    return numThreads > 1 && !shape.empty() && shape[0] > 1 && volume >= kMinParallelElements;
+}
+
+LoopNestTemplate MakeLoopNestTemplate(PatternRewriter& rewriter, ArrayRef<int64_t> sizes, function_ref<void(OpBuilder&, Location, ArrayRef<Value>)> body)
+{
+    auto nest = lnir::MakeNest(rewriter, sizes);
+    auto nestBuilder = nest.getBodyBuilder();
+    auto symbolicIndices = nest.getIndices(nestBuilder);
+    std::vector<Value> indexValues(symbolicIndices.begin(), symbolicIndices.end());
+    auto kernel = lnir::MakeKernel(nestBuilder, [&](OpBuilder& builder, Location loc) {
+        body(builder, loc, indexValues);
+    });
+
+    auto schedule = nest.getOrCreateSchedule();
+    schedule.addKernel(kernel);
+
+    std::vector<lnir::Index> indices;
+    std::transform(symbolicIndices.begin(), symbolicIndices.end(), std::back_inserter(indices), [](lnir::SymbolicIndexOp index) { return index.getValue(); });
+    return { nest, schedule, indices };
+}
+
+void VectorizeLoop(lnir::ScheduleOp schedule, lnir::Index index, const xpir::VectorizationInfo& vectorizationInfo)
+{
+    OpBuilder builder(schedule);
+    auto vectorizationInfoIdentifier = builder.getStringAttr(xpir::VectorizationInfoAttr::getKeyName());
+    auto vectorizationInfoAttr = xpir::VectorizationInfoAttr::get(vectorizationInfo, builder.getContext());
+    schedule.addLoopAttribute(index, vectorizationInfoIdentifier, vectorizationInfoAttr);
+
+    // As with plan.vectorize(), tag the exec plan so that cache ops can find the vectorization info
+    schedule.getOrCreateExecPlan()->setAttr(vectorizationInfoIdentifier, vectorizationInfoAttr);
+}
+
+void ParallelizeLoop(lnir::ScheduleOp schedule, lnir::Index index, int64_t numThreads)
+{
+    OpBuilder builder(schedule);
+    xpir::ParallelizationInfo parallelizationInfo{ numThreads, false };
+    schedule.addLoopAttribute(index,
+                              builder.getStringAttr(xpir::ParallelizationInfoAttr::getKeyName()),
+                              xpir::ParallelizationInfoAttr::get(parallelizationInfo, builder.getContext()));
+}
+
+void AddActiveBlockCache(lnir::ScheduleOp schedule, Value input, lnir::Index index, const xpir::VectorizationInfo& vectorizationInfo)
+{
+    OpBuilder builder(schedule);
+    auto loc = builder.getUnknownLoc();
+
+    auto rank = input.getType().cast<MemRefType>().getRank();
+    std::vector<int64_t> dimOrder(rank);
+    std::iota(dimOrder.begin(), dimOrder.end(), 0);
+
+    auto cacheInfo = xpir::MakeManualCacheInfo(builder,
+                                               input,
+                                               xpir::CacheAllocation::Automatic,
+                                               schedule,
+                                               std::nullopt, // elementType
+                                               index,
+                                               index,
+                                               std::nullopt, // maxElements
+                                               utilities::DimensionOrder(dimOrder),
+                                               vir::MemorySpace::None);
+
+    auto makeCache = builder.create<xpir::MakeCacheOp>(loc, cacheInfo.cacheType, vir::MemorySpace::None, llvm::Optional<uint64_t>{});
+    makeCache->moveBefore(schedule.getOperation());
+
+    auto cacheAccessContext = xpir::MakeCacheAccessContext(makeCache.getResult(), cacheInfo);
+    cacheAccessContext.cacheRegionRelevantScheduleIndexRanges = cacheInfo.cacheRegionRelevantScheduleIndexRanges;
+    cacheAccessContext.cacheRegionBaseIndices = cacheInfo.cacheRegionBaseIndices;
+
+    auto regionOp = builder.create<xpir::BeginCreateCacheOp>(loc,
+                                                             input,
+                                                             cacheAccessContext,
+                                                             input,
+                                                             *cacheInfo.cacheIndex,
+                                                             *cacheInfo.triggerIndex,
+                                                             ir::util::GetUniqueId(schedule),
+                                                             0, // cacheHierarchyLevel
+                                                             true, // activeBlockCache
+                                                             cacheInfo.dimReorderCache,
+                                                             false, // thrifty
+                                                             vir::CacheStrategyType::Striped,
+                                                             false, // doubleBufferCache
+                                                             vir::MemorySpace::None,
+                                                             vectorizationInfo);
+    (void)builder.create<xpir::EndCacheRegionOp>(loc, regionOp->getResult(0));
+    schedule.injectMapping(regionOp);
+}
+
+void PlanElementwiseLoopNest(LoopNestTemplate& loopNest, ArrayRef<int64_t> shape, int64_t elementBytes, const xpir::VectorizationInfo& vectorizationInfo, int64_t numThreads)
+{
+    auto schedule = loopNest.schedule;
+    std::vector<lnir::Index> order = loopNest.indices;
+
+    auto vectorSize = std::max<int64_t>(vectorizationInfo.vectorBytes / elementBytes, 1);
+    if (!shape.empty() && shape.back() >= vectorSize && vectorSize > 1)
+    {
+        auto [outer, inner] = schedule.split(loopNest.indices.back(), static_cast<int>(vectorSize));
+        order.back() = outer;
+        order.push_back(inner);
+        schedule.setOrder(order);
+        VectorizeLoop(schedule, inner, vectorizationInfo);
+    }
+
+    if (ShouldParallelizeLoopNest(shape, numThreads))
+    {
+        ParallelizeLoop(schedule, order.front(), numThreads);
+    }
+}
+
+} // namespace accera::transforms
@@ -10,6 +10,7 @@
 
 #include <ir/include/IRUtil.h>
 
+#include <mlir/IR/Matchers.h>
 #include <mlir/Pass/Pass.h>
 #include <mlir/Pass/PassManager.h>
 #include <mlir/Support/LogicalResult.h>
@@ -21,6 +22,7 @@
 #include <llvm/Support/Debug.h>
 
 #include <algorithm>
+#include <numeric>
 
 #define DEBUG_TYPE "value-optimize"
 
@@ -87,6 +89,66 @@ RangeValue resolveConstantForLoopRange(int64_t lb, int64_t ub, int64_t step)
     return resolveConstantForLoopRange(toAPInt(lb), toAPInt(ub), toAPInt(step));
 }
 
+// A loop with non-constant bounds runs its induction variable from at least the smallest lower bound
+// to less than the largest upper bound
+RangeValue resolveVariableForLoopRange(mlir::APInt minLowerBound, mlir::APInt maxUpperBound)
+{
+    if (maxUpperBound.sle(minLowerBound))
+    {
+        return RangeValue();
+    }
+    return RangeValue(minLowerBound, maxUpperBound - 1);
+}
+
+// Returns the user-declared constraints on a function argument (see ArgConstraintsAttrName), if any
+DictionaryAttr getArgumentConstraints(BlockArgument arg)
+{
+    auto block = arg.getOwner();
+    if (!block || !block->isEntryBlock() || !block->getParentOp())
+    {
+        return nullptr;
+    }
+
+    auto constraintsAttr = block->getParentOp()->getAttrOfType<ArrayAttr>(ArgConstraintsAttrName);
+    if (!constraintsAttr || arg.getArgNumber() >= constraintsAttr.size())
+    {
+        return nullptr;
+    }
+    return constraintsAttr[arg.getArgNumber()].dyn_cast<DictionaryAttr>();
+}
+
+std::optional<int64_t> getConstraint(DictionaryAttr constraints, StringRef name)
+{
+    if (constraints)
+    {
+        if (auto attr = constraints.getAs<IntegerAttr>(name))
+        {
+            return attr.getInt();
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<int64_t> combineMultiples(std::optional<int64_t> lhs, std::optional<int64_t> rhs, bool isProduct)
+{
+    if (isProduct)
+    {
+        // a * b is a multiple of whichever factors are known
+        if (lhs && rhs)
+        {
+            return *lhs * *rhs;
+        }
+        return lhs ? lhs : rhs;
+    }
+
+    // a + b is only known to be a multiple of a common divisor
+    if (lhs && rhs)
+    {
+        return std::gcd(*lhs, *rhs);
+    }
+    return std::nullopt;
+}
+
 } // namespace
 
 namespace accera::ir::util
@@ -298,15 +360,7 @@ RangeValue RangeValueAnalysis::addOperation(mlir::Operation* op)
     // Ensure this op's operands are part of this analysis before resolving this op range
     for (auto operand : op->getOperands())
     {
-        if (auto definingOp = GetDefiningOpOrForLoop(operand))
-        {
-            addOperation(definingOp);
-        }
-        else
-        {
-            // Keep track of this value but it has arbitrary range
-            _rangeMap.insert({ operand, RangeValue() });
-        }
+        addValue(operand);
     }
 
     auto range = resolveRangeValue(op);
@@ -322,6 +376,83 @@ RangeValue RangeValueAnalysis::addOperation(mlir::Operation* op)
     return range;
 }
 
+void RangeValueAnalysis::addValue(Value value)
+{
+    if (hasRange(value))
+    {
+        return;
+    }
+
+    if (auto definingOp = GetDefiningOpOrForLoop(value))
+    {
+        addOperation(definingOp);
+    }
+    else if (auto arg = value.dyn_cast<BlockArgument>())
+    {
+        // Function arguments may have user-declared ranges, otherwise they have arbitrary range
+        _rangeMap.insert({ value, resolveRangeValue(arg) });
+    }
+    else
+    {
+        // Keep track of this value but it has arbitrary range
+        _rangeMap.insert({ value, RangeValue() });
+    }
+}
+
+std::optional<int64_t> RangeValueAnalysis::getKnownMultiple(Value value) const
+{
+    if (auto arg = value.dyn_cast<BlockArgument>())
+    {
+        return getConstraint(getArgumentConstraints(arg), "multiple_of");
+    }
+
+    APInt constantValue;
+    if (matchPattern(value, m_ConstantInt(&constantValue)))
+    {
+        auto constant = constantValue.getSExtValue();
+        return constant != 0 ? std::optional<int64_t>{ std::abs(constant) } : std::nullopt;
+    }
+
+    return mlir::TypeSwitch<Operation*, std::optional<int64_t>>(value.getDefiningOp())
+        .Case([&](arith::IndexCastOp op) { return getKnownMultiple(op.getIn()); })
+        .Case([&](arith::MulIOp op) { return combineMultiples(getKnownMultiple(op.getLhs()), getKnownMultiple(op.getRhs()), /*isProduct=*/true); })
+        .Case([&](arith::AddIOp op) { return combineMultiples(getKnownMultiple(op.getLhs()), getKnownMultiple(op.getRhs()), /*isProduct=*/false); })
+        .Case([&](arith::SubIOp op) { return combineMultiples(getKnownMultiple(op.getLhs()), getKnownMultiple(op.getRhs()), /*isProduct=*/false); })
+        .Default([](Operation*) { return std::nullopt; });
+}
+
+std::optional<int64_t> RangeValueAnalysis::getKnownMultiple(AffineExpr expr, unsigned numDims, ValueRange operands) const
+{
+    if (auto dimExpr = expr.dyn_cast<AffineDimExpr>())
+    {
+        return getKnownMultiple(operands[dimExpr.getPosition()]);
+    }
+    if (auto symExpr = expr.dyn_cast<AffineSymbolExpr>())
+    {
+        return getKnownMultiple(operands[numDims + symExpr.getPosition()]);
+    }
+    if (auto constExpr = expr.dyn_cast<AffineConstantExpr>())
+    {
+        auto constant = constExpr.getValue();
+        return constant != 0 ? std::optional<int64_t>{ std::abs(constant) } : std::nullopt;
+    }
+    if (auto binOpExpr = expr.dyn_cast<AffineBinaryOpExpr>())
+    {
+        auto lhs = getKnownMultiple(binOpExpr.getLHS(), numDims, operands);
+        auto rhs = getKnownMultiple(binOpExpr.getRHS(), numDims, operands);
+        switch (binOpExpr.getKind())
+        {
+        case AffineExprKind::Mul:
+            return combineMultiples(lhs, rhs, /*isProduct=*/true);
+        case AffineExprKind::Add:
+            return combineMultiples(lhs, rhs, /*isProduct=*/false);
+        default:
+            break;
+        }
+    }
+    return std::nullopt;
+}
+
 bool RangeValueAnalysis::allOperandsHaveRanges(Operation* op)
 {
     return llvm::all_of(op->getOperands(), [&, this](Value operand) {
@@ -372,8 +503,36 @@ RangeValue RangeValueAnalysis::resolveRangeValue(arith::IndexCastOp op)
     {
         return resolveRangeValue(defOp);
     }
-    // otherwise this is a BlockArgument which conservatively we assume has no range
-    return RangeValue();
+    // otherwise this is a BlockArgument, which only has a range if one was declared for it
+    return resolveRangeValue(val.cast<BlockArgument>());
+}
+
+RangeValue RangeValueAnalysis::resolveRangeValue(BlockArgument arg)
+{
+    auto constraints = getArgumentConstraints(arg);
+    if (!constraints)
+    {
+        return RangeValue();
+    }
+
+    // Declared constraints describe dimension sizes, which are never negative
+    auto multiple = getConstraint(constraints, "multiple_of").value_or(1);
+    auto min = std::max<int64_t>(getConstraint(constraints, "min").value_or(0), 0);
+    min = ((min + multiple - 1) / multiple) * multiple;
+
+    auto max = getConstraint(constraints, "max");
+    if (!max)
+    {
+        // [min, INT64_MAX]
+        return RangeValue(ConstantRange::getNonEmpty(toAPInt(min), APInt::getSignedMinValue(RangeValue::maxBitWidth)));
+    }
+
+    auto roundedMax = (*max / multiple) * multiple;
+    if (roundedMax < min)
+    {
+        return RangeValue();
+    }
+    return RangeValue(min, roundedMax);
 }
 
 RangeValue RangeValueAnalysis::resolveRangeValue(gpu::ThreadIdOp op)
@@ -426,20 +585,17 @@ RangeValue RangeValueAnalysis::resolveRangeValue(AffineApplyOp op)
     auto simplified = util::SimplifyAffineValueMap(affineValueMap);
     auto map = simplified.getAffineMap();
     assert(map.getNumResults() == 1 && "Affine apply can't have multiple expressions");
-    auto expr = map.getResult(0);
-    auto operands = simplified.getOperands();
+    return resolveAffineExprRange(map.getResult(0), map.getNumDims(), simplified.getOperands());
+}
+
+RangeValue RangeValueAnalysis::resolveAffineExprRange(AffineExpr expr, unsigned numDims, ValueRange operands)
+{
     for (auto operand : operands)
     {
-        if (!hasRange(operand))
-        {
-            if (auto defOp = GetDefiningOpOrForLoop(operand))
-            {
-                addOperation(defOp);
-            }
-        }
+        addValue(operand);
     }
-    std::vector<mlir::Value> dimOperands(operands.begin(), operands.begin() + map.getNumDims());
-    std::vector<mlir::Value> symbolOperands(operands.begin() + map.getNumDims(), operands.end());
+    std::vector<mlir::Value> dimOperands(operands.begin(), operands.begin() + numDims);
+    std::vector<mlir::Value> symbolOperands(operands.begin() + numDims, operands.end());
     mlir::DenseMap<mlir::AffineExpr, RangeValue> subExprRanges;
     // Post-order traversal of the expression tree
     expr.walk([&](mlir::AffineExpr subExpr) {
@@ -492,6 +648,17 @@ RangeValue RangeValueAnalysis::resolveRangeValue(AffineApplyOp op)
             default:
                 throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "Unsupported binary op expression");
             }
+
+            // x mod d is 0 when x is known to be a multiple of d
+            if (auto divisor = rhs.dyn_cast<mlir::AffineConstantExpr>(); divisor && binOpExpr.getKind() == mlir::AffineExprKind::Mod && divisor.getValue() != 0)
+            {
+                if (auto multiple = getKnownMultiple(lhs, numDims, operands); multiple && *multiple % divisor.getValue() == 0)
+                {
+                    subExprRanges.insert({ subExpr, RangeValue(0, 0) });
+                    return;
+                }
+            }
+
             llvm::SmallVector<RangeValue, 2> operandRanges{ lhsRv, rhsRv };
             auto rv = resolveRangeValue(llvmBinOp, operandRanges);
             subExprRanges.insert({ subExpr, rv });
@@ -514,20 +681,48 @@ RangeValue RangeValueAnalysis::resolveRangeValue(AffineForOp op)
 
         return resolveConstantForLoopRange(lb, ub, step);
     }
+
+    // The lower bound is the max of its map results and the upper bound is the min of its map results,
+    // so any bounded result limits the induction variable
+    std::optional<APInt> minLowerBound;
+    auto lbMap = op.getLowerBoundMap();
+    for (auto expr : lbMap.getResults())
+    {
+        auto rv = resolveAffineExprRange(expr, lbMap.getNumDims(), op.getLowerBoundOperands());
+        if (!rv.isFullSet() && (!minLowerBound || rv.range.getSignedMin().sgt(*minLowerBound)))
+        {
+            minLowerBound = rv.range.getSignedMin();
+        }
+    }
+
+    std::optional<APInt> maxUpperBound;
+    auto ubMap = op.getUpperBoundMap();
+    for (auto expr : ubMap.getResults())
+    {
+        auto rv = resolveAffineExprRange(expr, ubMap.getNumDims(), op.getUpperBoundOperands());
+        if (!rv.isFullSet() && (!maxUpperBound || rv.range.getSignedMax().slt(*maxUpperBound)))
+        {
+            maxUpperBound = rv.range.getSignedMax();
+        }
+    }
+
+    if (minLowerBound && maxUpperBound)
+    {
+        return resolveVariableForLoopRange(*minLowerBound, *maxUpperBound);
+    }
     return RangeValue();
 }
 
 RangeValue RangeValueAnalysis::resolveRangeValue(scf::ForOp op)
 {
     assert(op.getNumInductionVars() == 1);
-    if (op.getUpperBound().isa<mlir::BlockArgument>()) // variable upper bound
-    {
-        return RangeValue();
-    }
+    addValue(op.getLowerBound());
+    addValue(op.getUpperBound());
+    addValue(op.getStep());
 
-    RangeValue lowerBound = resolveRangeValue(op.getLowerBound().getDefiningOp());
-    RangeValue upperBound = resolveRangeValue(op.getUpperBound().getDefiningOp());
-    RangeValue stepSize = resolveRangeValue(op.getStep().getDefiningOp());
+    RangeValue lowerBound = getRange(op.getLowerBound());
+    RangeValue upperBound = getRange(op.getUpperBound());
+    RangeValue stepSize = getRange(op.getStep());
 
     bool isConstantRangeStep = lowerBound.isConstant() && upperBound.isConstant() && stepSize.isConstant();
     if (isConstantRangeStep)
@@ -538,9 +733,27 @@ RangeValue RangeValueAnalysis::resolveRangeValue(scf::ForOp op)
 
         return resolveConstantForLoopRange(lb, ub, step);
     }
+    if (!lowerBound.isFullSet() && !upperBound.isFullSet())
+    {
+        return resolveVariableForLoopRange(lowerBound.range.getSignedMin(), upperBound.range.getSignedMax());
+    }
     return RangeValue();
 }
 
+RangeValue RangeValueAnalysis::resolveRemainderRange(Instruction::BinaryOps binOp, Operation* op)
+{
+    // x % d is 0 when x is known to be a multiple of the constant d
+    APInt divisor;
+    if (matchPattern(op->getOperand(1), m_ConstantInt(&divisor)) && !divisor.isZero())
+    {
+        if (auto multiple = getKnownMultiple(op->getOperand(0)); multiple && *multiple % divisor.getSExtValue() == 0)
+        {
+            return RangeValue(0, 0);
+        }
+    }
+    return resolveRangeValue(binOp, op);
+}
+
 RangeValue RangeValueAnalysis::resolveRangeValue(mlir::Operation* op)
 {
     return mlir::TypeSwitch<mlir::Operation*, RangeValue>(op)
@@ -554,8 +767,8 @@ RangeValue RangeValueAnalysis::resolveRangeValue(mlir::Operation* op)
         .Case([&](arith::AddIOp op) { return resolveRangeValue(Instruction::BinaryOps::Add, op); })
         .Case([&](arith::SubIOp op) { return resolveRangeValue(Instruction::BinaryOps::Sub, op); })
         .Case([&](arith::MulIOp op) { return resolveRangeValue(Instruction::BinaryOps::Mul, op); })
-        .Case([&](arith::RemSIOp op) { return resolveRangeValue(Instruction::BinaryOps::SRem, op); })
-        .Case([&](arith::RemUIOp op) { return resolveRangeValue(Instruction::BinaryOps::URem, op); })
+        .Case([&](arith::RemSIOp op) { return resolveRemainderRange(Instruction::BinaryOps::SRem, op); })
+        .Case([&](arith::RemUIOp op) { return resolveRemainderRange(Instruction::BinaryOps::URem, op); })
         .Case([&](arith::DivSIOp op) { return resolveRangeValue(Instruction::BinaryOps::SDiv, op); })
         .Case([&](arith::DivUIOp op) { return resolveRangeValue(Instruction::BinaryOps::UDiv, op); })
         .Case([&](scf::ForOp op) { return resolveRangeValue(op); })
@@ -10,11 +10,15 @@
 #include <ir/include/intrinsics/AcceraIntrinsicsDialect.h>
 #include <ir/include/value/ValueDialect.h>
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/StringSet.h>
 #include <llvm/IR/Constant.h>
 #include <mlir/Dialect/LLVMIR/LLVMTypes.h>
+#include <mlir/IR/BlockAndValueMapping.h>
 #include <mlir/IR/BuiltinOps.h>
 #include <mlir/IR/BuiltinTypes.h>
 #include <mlir/IR/Types.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
 #include <mlir/Support/LogicalResult.h>
 #include <transforms/include/util/SnapshotUtilities.h>
 #include <value/include/Debugging.h>
@@ -33,6 +37,7 @@
 #include <mlir/Conversion/StandardToLLVM/ConvertStandardToLLVMPass.h>
 #include <mlir/Conversion/VectorToLLVM/ConvertVectorToLLVM.h>
 
+#include <mlir/Dialect/Affine/Analysis/Utils.h>
 #include <mlir/Dialect/Affine/IR/AffineOps.h>
 #include <mlir/Dialect/LLVMIR/FunctionCallUtils.h>
 #include <mlir/Dialect/LLVMIR/LLVMDialect.h>
@@ -51,7 +56,10 @@
 #include <llvm/IR/DataLayout.h>
 #include <llvm/Support/raw_os_ostream.h>
 
+#include <functional>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifndef _MSC_VER
 #include <time.h>
@@ -75,6 +83,79 @@ enum class ClockID
     ACCERA_CLOCK_MONOTONIC = 1,
 };
 
+// Scratch workspace (arena) runtime emitted into modules lowered with use-workspace-allocator
+// The exported setter is named after the module (<module>_SetWorkspace) so that several packages can be
+// linked or loaded into one process, each with its own workspace
+const mlir::StringRef kSetWorkspaceFnSuffix = "_SetWorkspace";
+const mlir::StringRef kDefaultSetWorkspaceModuleName = "Accera";
+const mlir::StringRef kWorkspaceAllocFnName = "__accera_workspace_alloc";
+const mlir::StringRef kWorkspaceFreeFnName = "__accera_workspace_free";
+const mlir::StringRef kWorkspaceBaseGlobalName = "__accera_workspace_base";
+const mlir::StringRef kWorkspaceCapacityGlobalName = "__accera_workspace_capacity";
+const mlir::StringRef kWorkspaceOffsetGlobalName = "__accera_workspace_offset";
+
+// Huge page backing for allocations marked with accv.huge_pages. On Linux the allocations are aligned to
+// the huge page size and advised with madvise(MADV_HUGEPAGE), which is ignored (returns EINVAL) if
+// transparent huge pages aren't available, and heap allocations come from aligned_alloc rather than
+// padded malloc calls. Elsewhere the marks are dropped and the allocations are left as they are
+constexpr int64_t kHugePageSize = 2 * 1024 * 1024;
+constexpr int32_t kMadviseHugePage = 14; // MADV_HUGEPAGE in <sys/mman.h>
+const mlir::StringRef kMadviseFnName = "madvise";
+const mlir::StringRef kAdviseHugePagesFnName = "__accera_advise_huge_pages";
+const mlir::StringRef kHugePagesAdvisedGlobalName = "__accera_huge_pages_advised";
+
+// Suffix of the companion functions that report the workspace bytes a function needs
+const mlir::StringRef kWorkspaceSizeFnSuffix = "_workspace_size";
+
+// Every workspace block starts on this boundary and reserves this many bytes in front of the
+// returned pointer for a header that records the block size
+constexpr int64_t kWorkspaceBlockAlignment = 64;
+
+// Streaming drivers for functions marked with accv.streaming. On Linux the driver asks the kernel to read
+// the next tile ahead while the current one is computed, and marks the processed tiles as cold so that
+// they're reclaimed first. Unlike MADV_DONTNEED, MADV_COLD never discards data, and it's ignored (returns
+// EINVAL) on kernels that don't support it
+constexpr int64_t kStreamingPageSize = 4096;
+constexpr int32_t kMadviseWillNeed = 3; // MADV_WILLNEED in <sys/mman.h>
+constexpr int32_t kMadviseCold = 20; // MADV_COLD in <sys/mman.h>
+const mlir::StringRef kStreamFnSuffix = "_stream";
+
+// Asynchronous entry points for functions marked with accv.async_entry, which queue the function to a worker thread
+// that the module starts on first use and keeps for the lifetime of the process
+const mlir::StringRef kAsyncFnSuffix = "_async";
+const mlir::StringRef kAsyncRunSuffix = "_async_run";
+const mlir::StringRef kAsyncSubmitFnName = "__accera_async_submit";
+const mlir::StringRef kAsyncWorkerFnName = "__accera_async_worker";
+const mlir::StringRef kAsyncStateGlobalName = "__accera_async_state";
+const mlir::StringRef kAsyncQueueHeadGlobalName = "__accera_async_queue_head";
+const mlir::StringRef kAsyncQueueTailGlobalName = "__accera_async_queue_tail";
+const mlir::StringRef kAsyncMutexGlobalName = "__accera_async_mutex";
+const mlir::StringRef kAsyncCondGlobalName = "__accera_async_cond";
+const mlir::StringRef kPthreadCreateFnName = "pthread_create";
+const mlir::StringRef kPthreadDetachFnName = "pthread_detach";
+const mlir::StringRef kPthreadMutexInitFnName = "pthread_mutex_init";
+const mlir::StringRef kPthreadMutexLockFnName = "pthread_mutex_lock";
+const mlir::StringRef kPthreadMutexUnlockFnName = "pthread_mutex_unlock";
+const mlir::StringRef kPthreadCondInitFnName = "pthread_cond_init";
+const mlir::StringRef kPthreadCondWaitFnName = "pthread_cond_wait";
+const mlir::StringRef kPthreadCondSignalFnName = "pthread_cond_signal";
+const mlir::StringRef kCreateThreadFnName = "CreateThread";
+const mlir::StringRef kCloseHandleFnName = "CloseHandle";
+const mlir::StringRef kAcquireSRWLockFnName = "AcquireSRWLockExclusive";
+const mlir::StringRef kReleaseSRWLockFnName = "ReleaseSRWLockExclusive";
+const mlir::StringRef kSleepConditionVariableFnName = "SleepConditionVariableSRW";
+const mlir::StringRef kWakeConditionVariableFnName = "WakeConditionVariable";
+constexpr int32_t kAsyncOutOfMemory = 12; // ENOMEM in <errno.h>
+constexpr int32_t kWin32Infinite = -1; // INFINITE in <winbase.h>
+// Storage reserved for the queue's mutex and condition variable, which covers pthread_mutex_t and pthread_cond_t
+// on Linux and macOS (at most 64 bytes) as well as the pointer-sized SRWLOCK and CONDITION_VARIABLE on Windows
+constexpr int64_t kSyncObjectBytes = 64;
+constexpr int64_t kSyncObjectAlignment = 16;
+// Worker states: not started, being started by one of the submitting threads, running
+constexpr int32_t kAsyncWorkerIdle = 0;
+constexpr int32_t kAsyncWorkerStarting = 1;
+constexpr int32_t kAsyncWorkerRunning = 2;
+
 // TODO: Refactor this class and find a better place for this helper class
 class LLVMTypeConverterDynMem : public mlir::LLVMTypeConverter
 {
@@ -471,8 +552,9 @@ struct MemrefAllocOpLowering : public ConvertOpToLLVMPattern<memref::AllocOp>
     using ConvertToLLVMPattern::getIndexType;
     using ConvertToLLVMPattern::getVoidPtrType;
 
-    MemrefAllocOpLowering(LLVMTypeConverter& converter, mlir::MLIRContext* context) :
-        ConvertOpToLLVMPattern(converter)
+    MemrefAllocOpLowering(LLVMTypeConverter& converter, mlir::MLIRContext* context, bool useWorkspaceAllocator = false, PatternBenefit benefit = 1) :
+        ConvertOpToLLVMPattern(converter, benefit),
+        useWorkspaceAllocator(useWorkspaceAllocator)
     {}
 
     static Value createAligned(ConversionPatternRewriter& rewriter, Location loc, Value input, Value alignment)
@@ -489,6 +571,28 @@ struct MemrefAllocOpLowering : public ConvertOpToLLVMPattern<memref::AllocOp>
         // Heap allocations.
         memref::AllocOp allocOp = cast<memref::AllocOp>(op);
         MemRefType memRefType = allocOp.getType();
+        Type elementPtrType = this->getElementPtrType(memRefType);
+        auto parentModule = allocOp->getParentOfType<ModuleOp>();
+
+        if (allocOp->hasAttr(HugePagesAttrName))
+        {
+            // Huge page allocations come from aligned_alloc instead of being padded by the alignment, and bypass
+            // the workspace since it can't guarantee huge page alignment. The size is rounded up to whole huge
+            // pages, which aligned_alloc requires and which keeps the tail of the buffer off regular pages. The
+            // buffer is released with free like any other heap allocation. The madvise result is ignored,
+            // the allocation is simply backed by regular pages if huge pages aren't available
+            auto alignedAllocFn = LLVM::lookupOrCreateAlignedAllocFn(parentModule, getIndexType());
+            auto madviseFn = parentModule.lookupSymbol<LLVM::LLVMFuncOp>(kMadviseFnName);
+            assert(madviseFn && "madvise must be declared before lowering huge page allocations");
+            Value hugePageSize = createIndexConstant(rewriter, loc, kHugePageSize);
+            Value paddedSize = rewriter.create<LLVM::AddOp>(loc, sizeBytes, createIndexConstant(rewriter, loc, kHugePageSize - 1));
+            Value roundedSize = rewriter.create<LLVM::AndOp>(loc, paddedSize, createIndexConstant(rewriter, loc, -kHugePageSize));
+            auto results = createLLVMCall(rewriter, loc, alignedAllocFn, { hugePageSize, roundedSize }, getVoidPtrType());
+            Value advice = rewriter.create<LLVM::ConstantOp>(loc, rewriter.getI32Type(), rewriter.getI32IntegerAttr(kMadviseHugePage));
+            rewriter.create<LLVM::CallOp>(loc, madviseFn, ValueRange{ results[0], roundedSize, advice });
+            Value allocatedPtr = rewriter.create<LLVM::BitcastOp>(loc, elementPtrType, results[0]);
+            return std::make_tuple(allocatedPtr, allocatedPtr);
+        }
 
         Value alignment;
         if (auto alignmentAttr = allocOp.alignment())
@@ -507,9 +611,11 @@ struct MemrefAllocOpLowering : public ConvertOpToLLVMPattern<memref::AllocOp>
         }
 
         // Allocate the underlying buffer and store a pointer to it in the MemRef descriptor.
-        Type elementPtrType = this->getElementPtrType(memRefType);
-        auto allocFuncOp = LLVM::lookupOrCreateMallocFn(
-            allocOp->getParentOfType<ModuleOp>(), getIndexType());
+        // The workspace allocator has the same signature as malloc and falls back to it
+        // when no workspace has been provided or the workspace is exhausted
+        auto allocFuncOp = useWorkspaceAllocator ? parentModule.lookupSymbol<LLVM::LLVMFuncOp>(kWorkspaceAllocFnName)
+                                                 : LLVM::lookupOrCreateMallocFn(parentModule, getIndexType());
+        assert(allocFuncOp && "Workspace allocator functions must be emitted before lowering allocations");
         auto results = createLLVMCall(rewriter, loc, allocFuncOp, { sizeBytes }, getVoidPtrType());
         Value allocatedPtr = rewriter.create<LLVM::BitcastOp>(loc, elementPtrType, results[0]);
 
@@ -572,6 +678,33 @@ struct MemrefAllocOpLowering : public ConvertOpToLLVMPattern<memref::AllocOp>
         // Return the final value of the descriptor.
         rewriter.replaceOp(op, { memRefDescriptor });
     }
+
+    bool useWorkspaceAllocator;
+};
+
+// Pairs with MemrefAllocOpLowering when the workspace allocator is in use, handing the allocated
+// pointer back to the workspace instead of calling free directly
+struct MemrefDeallocOpLowering : public ConvertOpToLLVMPattern<memref::DeallocOp>
+{
+    using ConvertToLLVMPattern::getVoidPtrType;
+
+    MemrefDeallocOpLowering(LLVMTypeConverter& converter, mlir::MLIRContext* context, PatternBenefit benefit = 1) :
+        ConvertOpToLLVMPattern(converter, benefit)
+    {}
+
+    LogicalResult matchAndRewrite(memref::DeallocOp op, OpAdaptor adaptor, ConversionPatternRewriter& rewriter) const override
+    {
+        if (auto target = util::ResolveExecutionTarget(op); !target || *target != ExecutionTarget::CPU)
+        {
+            return failure();
+        }
+
+        auto loc = op.getLoc();
+        MemRefDescriptor memref(adaptor.memref());
+        Value allocatedPtr = rewriter.create<LLVM::BitcastOp>(loc, getVoidPtrType(), memref.allocatedPtr(rewriter, loc));
+        rewriter.replaceOpWithNewOp<LLVM::CallOp>(op, TypeRange{}, SymbolRefAttr::get(rewriter.getContext(), kWorkspaceFreeFnName), ValueRange{ allocatedPtr });
+        return success();
+    }
 };
 
 struct ValueMemRefCastOpLowering : public ValueLLVMOpConversionPattern<MemRefCastOp>
@@ -781,7 +914,7 @@ struct RoundOpLowering : public ValueLLVMOpConversionPattern<RoundOp>
 
 struct ValueToLLVMLoweringPass : public ConvertValueToLLVMBase<ValueToLLVMLoweringPass>
 {
-    ValueToLLVMLoweringPass(bool useBarePtrCallConv, bool emitCWrappers, unsigned indexBitwidth, bool useAlignedAlloc, llvm::DataLayout dataLayout, accera::value::TargetDevice deviceInfo = {}, const IntraPassSnapshotOptions& snapshotteroptions = {}) :
+    ValueToLLVMLoweringPass(bool useBarePtrCallConv, bool emitCWrappers, unsigned indexBitwidth, bool useAlignedAlloc, llvm::DataLayout dataLayout, accera::value::TargetDevice deviceInfo = {}, const IntraPassSnapshotOptions& snapshotteroptions = {}, bool useWorkspaceAllocator = false, int64_t hugePageThreshold = 0) :
         _intrapassSnapshotter(snapshotteroptions),
         deviceInfo(deviceInfo)
     {
@@ -791,6 +924,8 @@ struct ValueToLLVMLoweringPass : public ConvertValueToLLVMBase<ValueToLLVMLoweri
         // TODO: move to mlir::LowerToLLVMOptions::AllocLowering
         this->useAlignedAlloc = useAlignedAlloc;
         this->dataLayout = dataLayout.getStringRepresentation();
+        this->useWorkspaceAllocator = useWorkspaceAllocator;
+        this->hugePageThreshold = hugePageThreshold;
     }
 
     void runOnModule() final;
@@ -814,6 +949,1296 @@ Value createIndexAttrConstant(OpBuilder& builder, Location loc, Type resultType,
     return createIndexAttrConstant(builder, loc, converter.convertType(builder.getIndexType()), value);
 }
 
+std::string GetSetWorkspaceFnName(ModuleOp module)
+{
+    auto moduleName = module.getName().getValueOr(kDefaultSetWorkspaceModuleName);
+    return (moduleName + kSetWorkspaceFnSuffix).str();
+}
+
+// Emits the scratch workspace runtime used by the workspace allocator:
+//
+//   void <module>_SetWorkspace(void* buffer, uintptr_t size);
+//   void* __accera_workspace_alloc(uintptr_t size);
+//   void __accera_workspace_free(void* ptr);
+//
+// Allocations are bump-allocated from the buffer most recently passed to <module>_SetWorkspace
+// by advancing an offset. Each block records its size in a header in front of the returned
+// pointer so that frees made in LIFO order (which is how heap allocations are paired with their
+// deallocations) hand the space back to the workspace. Blocks freed out of order stay in use
+// until the next <module>_SetWorkspace call. Requests made without a workspace, or which don't fit
+// in the remaining space, fall back to malloc / free and leave the offset unchanged.
+//
+// The workspace state is thread-local: a workspace serves the thread that set it, and other
+// threads (OpenMP workers, the worker thread running <fn>_async calls) allocate from the heap unless
+// they set a workspace of their own. <module>_SetWorkspace is the only exported function, the
+// allocator and its state are private to the module, so every package has a workspace of its own.
+void EmitWorkspaceAllocatorFunctions(ModuleOp module, Type indexType)
+{
+    if (module.lookupSymbol(kWorkspaceAllocFnName))
+    {
+        return;
+    }
+
+    auto context = module.getContext();
+    auto loc = module.getLoc();
+    auto builder = OpBuilder::atBlockEnd(module.getBody());
+
+    auto i8PtrTy = LLVM::LLVMPointerType::get(IntegerType::get(context, 8));
+    auto voidTy = LLVM::LLVMVoidType::get(context);
+    auto indexPtrTy = LLVM::LLVMPointerType::get(indexType);
+    const int64_t indexBytes = indexType.getIntOrFloatBitWidth() / 8;
+
+    auto mallocFn = LLVM::lookupOrCreateMallocFn(module, indexType);
+    auto freeFn = LLVM::lookupOrCreateFreeFn(module);
+
+    auto createStateGlobal = [&](StringRef name) {
+        return builder.create<LLVM::GlobalOp>(loc, indexType, /*isConstant=*/false, LLVM::Linkage::Internal, name, builder.getIntegerAttr(indexType, 0), /*alignment=*/0, /*addrSpace=*/0, /*dsoLocal=*/false, /*threadLocal=*/true);
+    };
+    auto baseGlobal = createStateGlobal(kWorkspaceBaseGlobalName);
+    auto capacityGlobal = createStateGlobal(kWorkspaceCapacityGlobalName);
+    auto offsetGlobal = createStateGlobal(kWorkspaceOffsetGlobalName);
+
+    auto constant = [&](OpBuilder& b, int64_t value) -> Value {
+        return b.create<LLVM::ConstantOp>(loc, indexType, b.getIntegerAttr(indexType, value));
+    };
+    auto load = [&](OpBuilder& b, LLVM::GlobalOp global) -> Value {
+        return b.create<LLVM::LoadOp>(loc, b.create<LLVM::AddressOfOp>(loc, global));
+    };
+    auto store = [&](OpBuilder& b, Value value, LLVM::GlobalOp global) {
+        b.create<LLVM::StoreOp>(loc, value, b.create<LLVM::AddressOfOp>(loc, global));
+    };
+    auto addBlock = [](LLVM::LLVMFuncOp fn) {
+        auto block = new Block();
+        fn.getBody().push_back(block);
+        return block;
+    };
+
+    // void <module>_SetWorkspace(void* buffer, uintptr_t size)
+    {
+        auto fn = builder.create<LLVM::LLVMFuncOp>(loc, GetSetWorkspaceFnName(module), LLVM::LLVMFunctionType::get(voidTy, { i8PtrTy, indexType }), LLVM::Linkage::External);
+        auto b = OpBuilder::atBlockEnd(fn.addEntryBlock());
+        store(b, b.create<LLVM::PtrToIntOp>(loc, indexType, fn.getArgument(0)), baseGlobal);
+        store(b, fn.getArgument(1), capacityGlobal);
+        store(b, constant(b, 0), offsetGlobal);
+        b.create<LLVM::ReturnOp>(loc, ValueRange{});
+    }
+
+    // void* __accera_workspace_alloc(uintptr_t size)
+    {
+        auto fn = builder.create<LLVM::LLVMFuncOp>(loc, kWorkspaceAllocFnName, LLVM::LLVMFunctionType::get(i8PtrTy, { indexType }), LLVM::Linkage::Internal);
+        auto entryBlock = fn.addEntryBlock();
+        auto bumpBlock = addBlock(fn);
+        auto arenaBlock = addBlock(fn);
+        auto fallbackBlock = addBlock(fn);
+        Value size = fn.getArgument(0);
+
+        auto b = OpBuilder::atBlockEnd(entryBlock);
+        Value base = load(b, baseGlobal);
+        Value hasWorkspace = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::ne, base, constant(b, 0));
+        b.create<LLVM::CondBrOp>(loc, hasWorkspace, bumpBlock, fallbackBlock);
+
+        // Round up to whole blocks, leaving room for the header. The offset never exceeds the
+        // capacity, so comparing against the remaining space can't overflow
+        b.setInsertionPointToEnd(bumpBlock);
+        Value paddedSize = b.create<LLVM::AddOp>(loc, size, constant(b, 2 * kWorkspaceBlockAlignment - 1));
+        Value blockSize = b.create<LLVM::AndOp>(loc, paddedSize, constant(b, -kWorkspaceBlockAlignment));
+        Value blockOffset = load(b, offsetGlobal);
+        Value remaining = b.create<LLVM::SubOp>(loc, load(b, capacityGlobal), blockOffset);
+        Value fits = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::ule, blockSize, remaining);
+        b.create<LLVM::CondBrOp>(loc, fits, arenaBlock, fallbackBlock);
+
+        b.setInsertionPointToEnd(arenaBlock);
+        store(b, b.create<LLVM::AddOp>(loc, blockOffset, blockSize), offsetGlobal);
+        Value blockStart = b.create<LLVM::AddOp>(loc, base, blockOffset);
+        Value result = b.create<LLVM::AddOp>(loc, blockStart, constant(b, kWorkspaceBlockAlignment));
+        Value header = b.create<LLVM::SubOp>(loc, result, constant(b, indexBytes));
+        b.create<LLVM::StoreOp>(loc, blockSize, b.create<LLVM::IntToPtrOp>(loc, indexPtrTy, header));
+        b.create<LLVM::ReturnOp>(loc, ValueRange{ b.create<LLVM::IntToPtrOp>(loc, i8PtrTy, result) });
+
+
+        b.setInsertionPointToEnd(fallbackBlock);
+        auto mallocCall = b.create<LLVM::CallOp>(loc, TypeRange{ i8PtrTy }, SymbolRefAttr::get(context, mallocFn.getName()), ValueRange{ size });
+        b.create<LLVM::ReturnOp>(loc, mallocCall.getResults());
+    }
+
+    // void __accera_workspace_free(void* ptr)
+    {
+        auto fn = builder.create<LLVM::LLVMFuncOp>(loc, kWorkspaceFreeFnName, LLVM::LLVMFunctionType::get(voidTy, { i8PtrTy }), LLVM::Linkage::Internal);
+        auto entryBlock = fn.addEntryBlock();
+        auto releaseBlock = addBlock(fn);
+        auto heapBlock = addBlock(fn);
+        Value ptr = fn.getArgument(0);
+
+        // Pointers below the workspace wrap around to large unsigned values, so a single
+        // unsigned comparison against the capacity tells whether ptr is inside the workspace
+        auto b = OpBuilder::atBlockEnd(entryBlock);
+        Value ptrInt = b.create<LLVM::PtrToIntOp>(loc, indexType, ptr);
+        Value relativeOffset = b.create<LLVM::SubOp>(loc, ptrInt, load(b, baseGlobal));
+        Value inWorkspace = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::ult, relativeOffset, load(b, capacityGlobal));
+        b.create<LLVM::CondBrOp>(loc, inWorkspace, releaseBlock, heapBlock);
+
+        // Only the most recent block can be released, which is a no-op for out of order frees
+        b.setInsertionPointToEnd(releaseBlock);
+        Value header = b.create<LLVM::SubOp>(loc, ptrInt, constant(b, indexBytes));
+        Value blockSize = b.create<LLVM::LoadOp>(loc, b.create<LLVM::IntToPtrOp>(loc, indexPtrTy, header));
+        Value blockOffset = b.create<LLVM::SubOp>(loc, relativeOffset, constant(b, kWorkspaceBlockAlignment));
+        Value blockEnd = b.create<LLVM::AddOp>(loc, blockOffset, blockSize);
+        Value offset = load(b, offsetGlobal);
+        Value isLast = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::eq, offset, blockEnd);
+        store(b, b.create<LLVM::SelectOp>(loc, isLast, blockOffset, offset), offsetGlobal);
+        b.create<LLVM::ReturnOp>(loc, ValueRange{});
+
+        b.setInsertionPointToEnd(heapBlock);
+        b.create<LLVM::CallOp>(loc, TypeRange{}, SymbolRefAttr::get(context, freeFn.getName()), ValueRange{ ptr });
+        b.create<LLVM::ReturnOp>(loc, ValueRange{});
+    }
+}
+
+// Returns the number of workspace bytes a heap allocation of the given type consumes, or
+// llvm::None if it is runtime-sized. Mirrors the block rounding in __accera_workspace_alloc
+// and the alignment padding added by MemrefAllocOpLowering
+llvm::Optional<int64_t> GetWorkspaceBlockSize(memref::AllocOp allocOp)
+{
+    auto sizeInBytes = mlir::getMemRefSizeInBytes(allocOp.getType());
+    if (!sizeInBytes)
+    {
+        return llvm::None;
+    }
+    int64_t requestSize = static_cast<int64_t>(*sizeInBytes) + static_cast<int64_t>(allocOp.alignment().getValueOr(0));
+    return (requestSize + 2 * kWorkspaceBlockAlignment - 1) & -kWorkspaceBlockAlignment;
+}
+
+// Returns true if `op` may run more than once per call of `fn`: its block lies on a cycle of the control
+// flow graph, or it is nested in a region (e.g. an OpenMP loop) whose repetition isn't visible here
+bool MayRepeat(Operation* op, FunctionOpInterface fn)
+{
+    auto block = op->getBlock();
+    if (block->getParentOp() != fn.getOperation())
+    {
+        return true;
+    }
+
+    llvm::SmallPtrSet<Block*, 8> visited;
+    llvm::SmallVector<Block*> worklist(block->getSuccessors().begin(), block->getSuccessors().end());
+    while (!worklist.empty())
+    {
+        auto current = worklist.pop_back_val();
+        if (current == block)
+        {
+            return true;
+        }
+        if (visited.insert(current).second)
+        {
+            worklist.append(current->getSuccessors().begin(), current->getSuccessors().end());
+        }
+    }
+    return false;
+}
+
+// Returns true if `allocOp` is freed later in its own block, after the allocations made between the two
+// have been freed in reverse order. __accera_workspace_free only releases the most recent block, so this
+// is what gives the block back before control can reach the allocation again
+bool IsReleasedInLIFOOrder(memref::AllocOp allocOp)
+{
+    llvm::SmallVector<Value> laterAllocs;
+    for (auto it = std::next(allocOp->getIterator()), end = allocOp->getBlock()->end(); it != end; ++it)
+    {
+        if (auto laterAlloc = dyn_cast<memref::AllocOp>(*it))
+        {
+            if (!laterAlloc->hasAttr(HugePagesAttrName))
+            {
+                laterAllocs.push_back(laterAlloc.getResult());
+            }
+        }
+        else if (auto deallocOp = dyn_cast<memref::DeallocOp>(*it))
+        {
+            if (deallocOp.memref() == allocOp.getResult())
+            {
+                return laterAllocs.empty();
+            }
+            if (llvm::is_contained(laterAllocs, deallocOp.memref()))
+            {
+                if (laterAllocs.back() != deallocOp.memref())
+                {
+                    return false;
+                }
+                laterAllocs.pop_back();
+            }
+        }
+    }
+    return false;
+}
+
+// Annotates each function with the workspace bytes consumed by its statically-sized heap
+// allocations plus those of the functions it calls, and flags functions where some of the
+// allocations (including in callees) are runtime-sized
+void AnnotateWorkspaceSizes(ModuleOp module)
+{
+    struct WorkspaceInfo
+    {
+        int64_t size = 0;
+        bool dynamic = false;
+    };
+    std::unordered_map<Operation*, WorkspaceInfo> infos;
+
+    std::function<WorkspaceInfo(FunctionOpInterface)> computeWorkspace = [&](FunctionOpInterface fn) -> WorkspaceInfo {
+        if (auto it = infos.find(fn); it != infos.end())
+        {
+            return it->second;
+        }
+
+        // Guard against recursion, which can't be bounded statically
+        infos[fn] = WorkspaceInfo{ 0, true };
+
+        WorkspaceInfo info;
+        fn->walk([&](Operation* op) {
+            if (auto allocOp = dyn_cast<memref::AllocOp>(op))
+            {
+                if (allocOp->hasAttr(HugePagesAttrName))
+                {
+                    // Allocated with aligned_alloc, outside the workspace
+                    return;
+                }
+                if (MayRepeat(allocOp, fn) && !IsReleasedInLIFOOrder(allocOp))
+                {
+                    // Grows with the number of repetitions, only the size function can tell
+                    info.dynamic = true;
+                }
+                else if (auto blockSize = GetWorkspaceBlockSize(allocOp))
+                {
+                    info.size += *blockSize;
+                }
+                else
+                {
+                    info.dynamic = true;
+                }
+            }
+            else if (auto callOp = dyn_cast<CallOpInterface>(op))
+            {
+                if (auto callee = dyn_cast_or_null<FunctionOpInterface>(callOp.resolveCallable()))
+                {
+                    auto calleeInfo = computeWorkspace(callee);
+                    info.size += calleeInfo.size;
+                    info.dynamic |= calleeInfo.dynamic;
+                }
+            }
+        });
+
+        infos[fn] = info;
+        return info;
+    };
+
+    OpBuilder builder(module.getContext());
+    for (auto fn : module.getOps<FuncOp>())
+    {
+        if (fn.isExternal())
+        {
+            continue;
+        }
+
+        auto info = computeWorkspace(fn);
+        fn->setAttr(WorkspaceSizeAttrName, builder.getI64IntegerAttr(info.size));
+        if (info.dynamic)
+        {
+            fn->setAttr(DynamicWorkspaceAttrName, builder.getUnitAttr());
+        }
+    }
+}
+
+// Declares `int madvise(void* addr, size_t length, int advice)` if the module doesn't have it yet
+void DeclareMadvise(ModuleOp module, Type indexType)
+{
+    if (module.lookupSymbol(kMadviseFnName))
+    {
+        return;
+    }
+
+    auto builder = OpBuilder::atBlockBegin(module.getBody());
+    auto i32Type = builder.getI32Type();
+    auto i8PtrType = LLVM::LLVMPointerType::get(builder.getI8Type());
+    builder.create<LLVM::LLVMFuncOp>(module.getLoc(), kMadviseFnName, LLVM::LLVMFunctionType::get(i32Type, { i8PtrType, indexType, i32Type }));
+}
+
+// Decides which allocations are backed by huge pages: those marked with accv.huge_pages and, when `threshold`
+// is non-zero, every heap allocation and global buffer of at least `threshold` bytes. If `adviseHugePages` is
+// false the marks are dropped and the allocations are left unchanged, since the extra alignment would only cost
+// memory. Otherwise marked allocations are aligned to the huge page size and madvise is declared for the
+// allocation lowering. Returns the names and sizes of the global
+// buffers that need advising, which happens once at runtime (see EmitHugePageAdvice)
+std::vector<std::pair<std::string, int64_t>> PrepareHugePageAllocations(ModuleOp module, int64_t threshold, bool adviseHugePages, Type indexType)
+{
+    std::vector<std::pair<std::string, int64_t>> advisedGlobals;
+    auto context = module.getContext();
+    OpBuilder builder(context);
+    auto alignmentAttr = builder.getI64IntegerAttr(kHugePageSize);
+
+    auto markForHugePages = [&](Operation* op, MemRefType type, llvm::Optional<uint64_t> alignment) {
+        auto sizeInBytes = mlir::getMemRefSizeInBytes(type);
+        if (!op->hasAttr(HugePagesAttrName) && !(threshold > 0 && sizeInBytes && static_cast<int64_t>(*sizeInBytes) >= threshold))
+        {
+            return false;
+        }
+
+        if (!adviseHugePages)
+        {
+            op->removeAttr(HugePagesAttrName);
+            return false;
+        }
+
+        if (alignment.getValueOr(0) < static_cast<uint64_t>(kHugePageSize))
+        {
+            op->setAttr("alignment", alignmentAttr);
+        }
+        op->setAttr(HugePagesAttrName, builder.getUnitAttr());
+        return true;
+    };
+
+    bool anyAllocAdvised = false;
+    for (auto fn : module.getOps<FuncOp>())
+    {
+        fn.walk([&](memref::AllocOp allocOp) {
+            anyAllocAdvised |= markForHugePages(allocOp, allocOp.getType(), allocOp.alignment());
+        });
+    }
+
+    // Only mutable, zero-filled globals live in anonymous memory (.bss). Constant and initialized globals are
+    // file-backed, where transparent huge pages don't apply, so they are neither aligned nor advised
+    auto isZeroFilled = [](Attribute value) {
+        auto dense = value.dyn_cast<DenseElementsAttr>();
+        if (!dense || !dense.isSplat())
+        {
+            return false;
+        }
+        auto splat = dense.getSplatValue<Attribute>();
+        if (auto intAttr = splat.dyn_cast<IntegerAttr>())
+        {
+            return intAttr.getValue().isZero();
+        }
+        if (auto floatAttr = splat.dyn_cast<FloatAttr>())
+        {
+            return floatAttr.getValue().isPosZero();
+        }
+        return false;
+    };
+
+    for (auto globalOp : module.getOps<memref::GlobalOp>())
+    {
+        if (globalOp.isExternal())
+        {
+            continue;
+        }
+        if (globalOp.constant() || !(globalOp.isUninitialized() || isZeroFilled(*globalOp.initial_value())))
+        {
+            globalOp->removeAttr(HugePagesAttrName);
+            continue;
+        }
+        auto type = globalOp.type().cast<MemRefType>();
+        if (markForHugePages(globalOp, type, globalOp.alignment()))
+        {
+            advisedGlobals.emplace_back(globalOp.sym_name().str(), static_cast<int64_t>(*mlir::getMemRefSizeInBytes(type)));
+        }
+    }
+
+    if (anyAllocAdvised || !advisedGlobals.empty())
+    {
+        DeclareMadvise(module, indexType);
+    }
+
+    return advisedGlobals;
+}
+
+// Emits a function that advises the given global buffers to use huge pages the first time it is called,
+// and calls it on entry to every function that references one of those globals
+void EmitHugePageAdvice(ModuleOp module, const std::vector<std::pair<std::string, int64_t>>& advisedGlobals, Type indexType)
+{
+    if (advisedGlobals.empty())
+    {
+        return;
+    }
+
+    auto context = module.getContext();
+    auto loc = module.getLoc();
+    auto builder = OpBuilder::atBlockEnd(module.getBody());
+    auto i8Type = builder.getI8Type();
+    auto i32Type = builder.getI32Type();
+    auto i8PtrType = LLVM::LLVMPointerType::get(i8Type);
+
+    auto advisedFlag = builder.create<LLVM::GlobalOp>(loc, i8Type, /*isConstant=*/false, LLVM::Linkage::Internal, kHugePagesAdvisedGlobalName, builder.getI8IntegerAttr(0));
+    auto adviseFn = builder.create<LLVM::LLVMFuncOp>(loc, kAdviseHugePagesFnName, LLVM::LLVMFunctionType::get(LLVM::LLVMVoidType::get(context), {}), LLVM::Linkage::Internal);
+    auto entryBlock = adviseFn.addEntryBlock();
+    auto adviseBlock = new Block();
+    auto doneBlock = new Block();
+    adviseFn.getBody().push_back(adviseBlock);
+    adviseFn.getBody().push_back(doneBlock);
+
+    // The flag is claimed with an atomic exchange so that exactly one caller advises, even when the first
+    // calls race on different threads. The others skip ahead, the advice is only a hint for the kernel
+    builder.setInsertionPointToEnd(entryBlock);
+    Value flagPtr = builder.create<LLVM::AddressOfOp>(loc, advisedFlag);
+    Value one = builder.create<LLVM::ConstantOp>(loc, i8Type, builder.getI8IntegerAttr(1));
+    Value advised = builder.create<LLVM::AtomicRMWOp>(loc, i8Type, LLVM::AtomicBinOp::xchg, flagPtr, one, LLVM::AtomicOrdering::acq_rel);
+    Value isAdvised = builder.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::ne, advised, builder.create<LLVM::ConstantOp>(loc, i8Type, builder.getI8IntegerAttr(0)));
+    builder.create<LLVM::CondBrOp>(loc, isAdvised, doneBlock, adviseBlock);
+
+    builder.setInsertionPointToEnd(adviseBlock);
+    auto madviseFn = module.lookupSymbol<LLVM::LLVMFuncOp>(kMadviseFnName);
+    Value advice = builder.create<LLVM::ConstantOp>(loc, i32Type, builder.getI32IntegerAttr(kMadviseHugePage));
+    llvm::StringSet<> advisedNames;
+    for (const auto& [name, size] : advisedGlobals)
+    {
+        auto globalOp = module.lookupSymbol<LLVM::GlobalOp>(name);
+        assert(globalOp && "Expected the global buffer to be lowered to an LLVM global");
+        Value globalPtr = builder.create<LLVM::BitcastOp>(loc, i8PtrType, builder.create<LLVM::AddressOfOp>(loc, globalOp));
+        Value sizeBytes = builder.create<LLVM::ConstantOp>(loc, indexType, builder.getIntegerAttr(indexType, size));
+        builder.create<LLVM::CallOp>(loc, madviseFn, ValueRange{ globalPtr, sizeBytes, advice });
+        advisedNames.insert(name);
+    }
+    builder.create<LLVM::BrOp>(loc, ValueRange{}, doneBlock);
+
+    builder.setInsertionPointToEnd(doneBlock);
+    builder.create<LLVM::ReturnOp>(loc, ValueRange{});
+
+    for (auto fn : module.getOps<LLVM::LLVMFuncOp>())
+    {
+        if (fn.isExternal() || fn == adviseFn)
+        {
+            continue;
+        }
+        auto result = fn.walk([&](LLVM::AddressOfOp addressOfOp) {
+            return advisedNames.count(addressOfOp.global_name()) ? WalkResult::interrupt() : WalkResult::advance();
+        });
+        if (result.wasInterrupted())
+        {
+            auto fnBuilder = OpBuilder::atBlockBegin(&fn.getBody().front());
+            fnBuilder.create<LLVM::CallOp>(loc, adviseFn, ValueRange{});
+        }
+    }
+}
+
+// Re-creates the computation of `value` at the builder's insertion point by cloning its side-effect
+// free defining ops, stopping at values already present in `mapping` (e.g. function arguments).
+// Returns a null value if the computation depends on anything else
+Value MaterializeWorkspaceSizeOperand(OpBuilder& builder, Value value, BlockAndValueMapping& mapping)
+{
+    if (auto mapped = mapping.lookupOrNull(value))
+    {
+        return mapped;
+    }
+
+    auto op = value.getDefiningOp();
+    if (!op || op->getNumRegions() != 0 || !MemoryEffectOpInterface::hasNoEffect(op))
+    {
+        return {};
+    }
+
+    for (auto operand : op->getOperands())
+    {
+        if (!MaterializeWorkspaceSizeOperand(builder, operand, mapping))
+        {
+            return {};
+        }
+    }
+    auto clone = builder.clone(*op, mapping);
+    return clone->getResult(value.cast<OpResult>().getResultNumber());
+}
+
+int64_t GetElementSizeInBytes(Type elementType)
+{
+    if (auto vectorType = elementType.dyn_cast<VectorType>())
+    {
+        return vectorType.getNumElements() * llvm::divideCeil(vectorType.getElementTypeBitWidth(), 8);
+    }
+    return llvm::divideCeil(elementType.getIntOrFloatBitWidth(), 8);
+}
+
+// Emits code that adds the workspace bytes of the heap allocations made by `fn` and the functions it
+// calls to `total`. `mapping` maps the arguments of `fn` that can be computed in the size function.
+//
+// Each allocation is counted once, regardless of how many times it runs. This relies on the workspace
+// being used as a stack: an allocation that runs on every iteration of a loop (or on every call, when
+// `repeats` is set for a callee called from a loop) reuses the same bytes only if it is freed in that
+// iteration, in LIFO order with the allocations that follow it (see IsReleasedInLIFOOrder). Otherwise
+// the footprint grows with the trip count, which isn't bounded here.
+//
+// Returns failure if some allocation size can't be determined from those arguments, or if an allocation
+// may repeat without being released in LIFO order
+LogicalResult AccumulateWorkspaceSize(OpBuilder& builder, Location loc, FunctionOpInterface fn, BlockAndValueMapping& mapping, Value& total, std::unordered_set<Operation*>& callStack, bool repeats)
+{
+    if (!callStack.insert(fn).second)
+    {
+        // Recursive calls can't be bounded
+        return failure();
+    }
+
+    auto result = success();
+    fn->walk([&](Operation* op) {
+        if (auto allocOp = dyn_cast<memref::AllocOp>(op))
+        {
+            if (allocOp->hasAttr(HugePagesAttrName))
+            {
+                // Allocated with aligned_alloc, outside the workspace
+                return WalkResult::advance();
+            }
+            if ((repeats || MayRepeat(allocOp, fn)) && !IsReleasedInLIFOOrder(allocOp))
+            {
+                result = failure();
+                return WalkResult::interrupt();
+            }
+            auto memrefType = allocOp.getType();
+            Value blockSize;
+            if (auto staticBlockSize = GetWorkspaceBlockSize(allocOp))
+            {
+                blockSize = builder.create<arith::ConstantIndexOp>(loc, *staticBlockSize);
+            }
+            else
+            {
+                if (!memrefType.getElementType().isIntOrFloat() && !memrefType.getElementType().isa<VectorType>())
+                {
+                    result = failure();
+                    return WalkResult::interrupt();
+                }
+
+                // Mirrors the size computed by MemrefAllocOpLowering and the block rounding in __accera_workspace_alloc
+                auto elementSize = GetElementSizeInBytes(memrefType.getElementType());
+                auto alignment = static_cast<int64_t>(allocOp.alignment().getValueOr(0));
+                Value size = builder.create<arith::ConstantIndexOp>(loc, elementSize);
+                auto dynamicSizes = allocOp.dynamicSizes();
+                unsigned dynamicIdx = 0;
+                for (auto dimSize : memrefType.getShape())
+                {
+                    Value dim;
+                    if (ShapedType::isDynamic(dimSize))
+                    {
+                        dim = MaterializeWorkspaceSizeOperand(builder, dynamicSizes[dynamicIdx++], mapping);
+                        if (!dim)
+                        {
+                            result = failure();
+                            return WalkResult::interrupt();
+                        }
+                    }
+                    else
+                    {
+                        dim = builder.create<arith::ConstantIndexOp>(loc, dimSize);
+                    }
+                    size = builder.create<arith::MulIOp>(loc, size, dim);
+                }
+
+                Value paddedSize = builder.create<arith::AddIOp>(loc, size, builder.create<arith::ConstantIndexOp>(loc, alignment + 2 * kWorkspaceBlockAlignment - 1));
+                blockSize = builder.create<arith::AndIOp>(loc, paddedSize, builder.create<arith::ConstantIndexOp>(loc, -kWorkspaceBlockAlignment));
+            }
+            total = builder.create<arith::AddIOp>(loc, total, blockSize);
+        }
+        else if (auto callOp = dyn_cast<CallOpInterface>(op))
+        {
+            auto callee = dyn_cast_or_null<FunctionOpInterface>(callOp.resolveCallable());
+            if (!callee || callee.isExternal())
+            {
+                return WalkResult::advance();
+            }
+
+            // Arguments which can't be materialized are left unmapped, which only matters if an allocation depends on them
+            BlockAndValueMapping calleeMapping;
+            for (auto [operand, arg] : llvm::zip(callOp.getArgOperands(), callee.getArguments()))
+            {
+                if (auto materialized = MaterializeWorkspaceSizeOperand(builder, operand, mapping))
+                {
+                    calleeMapping.map(arg, materialized);
+                }
+            }
+            if (failed(AccumulateWorkspaceSize(builder, loc, callee, calleeMapping, total, callStack, repeats || MayRepeat(callOp, fn))))
+            {
+                result = failure();
+                return WalkResult::interrupt();
+            }
+        }
+        return WalkResult::advance();
+    });
+
+    callStack.erase(fn);
+    return result;
+}
+
+// Emits `int64_t <fn>_workspace_size(dims...)` for each function exposed through the raw pointer API,
+// taking the function's input scalar arguments (i.e. its runtime dimensions) and returning the
+// workspace bytes a call with those arguments uses, or -1 if that can't be determined
+void EmitWorkspaceSizeFunctions(ModuleOp module)
+{
+    auto loc = module.getLoc();
+    auto builder = OpBuilder::atBlockEnd(module.getBody());
+
+    llvm::SmallVector<FuncOp> publicFuncs;
+    for (auto fn : module.getOps<FuncOp>())
+    {
+        if (!fn.isExternal() && fn->hasAttr(RawPointerAPIAttrName))
+        {
+            publicFuncs.push_back(fn);
+        }
+    }
+
+    for (auto fn : publicFuncs)
+    {
+        auto sizeFnName = (fn.getName() + kWorkspaceSizeFnSuffix).str();
+        if (module.lookupSymbol(sizeFnName))
+        {
+            continue;
+        }
+
+        // Input scalars are passed by value, so they can be forwarded as-is
+        std::vector<int64_t> usages;
+        if (auto usagesAttr = fn->getAttrOfType<ArrayAttr>(UsagesAttrName))
+        {
+            usages = util::ConvertArrayAttrToIntVector(usagesAttr);
+        }
+        llvm::SmallVector<unsigned> dimArgIndices;
+        llvm::SmallVector<Type> dimArgTypes;
+        for (auto en : llvm::enumerate(fn.getType().getInputs()))
+        {
+            auto idx = en.index();
+            auto argType = en.value();
+            if (!argType.isa<ShapedType>() && idx < usages.size() && usages[idx] == static_cast<int64_t>(accera::value::FunctionParameterUsage::input))
+            {
+                dimArgIndices.push_back(idx);
+                dimArgTypes.push_back(argType);
+            }
+        }
+
+        auto i64Type = builder.getI64Type();
+        auto sizeFn = builder.create<FuncOp>(loc, sizeFnName, builder.getFunctionType(dimArgTypes, { i64Type }));
+        auto entryBlock = sizeFn.addEntryBlock();
+        auto bodyBuilder = OpBuilder::atBlockEnd(entryBlock);
+
+        BlockAndValueMapping mapping;
+        for (auto [fnArgIdx, sizeFnArg] : llvm::zip(dimArgIndices, sizeFn.getArguments()))
+        {
+            mapping.map(fn.getArgument(fnArgIdx), sizeFnArg);
+        }
+
+        Value total = bodyBuilder.create<arith::ConstantIndexOp>(loc, 0);
+        std::unordered_set<Operation*> callStack;
+        Value result;
+        if (succeeded(AccumulateWorkspaceSize(bodyBuilder, loc, fn, mapping, total, callStack, /*repeats=*/false)))
+        {
+            result = bodyBuilder.create<arith::IndexCastOp>(loc, i64Type, total);
+        }
+        else
+        {
+            // Drop the partial computation
+            entryBlock->clear();
+            bodyBuilder.setInsertionPointToEnd(entryBlock);
+            result = bodyBuilder.create<arith::ConstantIntOp>(loc, -1, i64Type);
+        }
+        bodyBuilder.create<mlir::ReturnOp>(loc, result);
+    }
+}
+
+// An argument that a streaming driver walks in tiles of rows, i.e. an array whose outermost dimension
+// is given by the function's streaming dimension argument
+struct StreamedArgument
+{
+    unsigned argIndex;
+    int64_t staticRowBytes; // bytes in a row, from the element size and the static inner dimensions
+    llvm::SmallVector<unsigned> rowSizeArgIndices; // arguments giving the runtime-sized inner dimensions
+};
+
+struct StreamingFunction
+{
+    std::string name;
+    unsigned dimArgIndex;
+    int64_t tileSize;
+    std::vector<StreamedArgument> arguments;
+};
+
+// Collects the functions exposed through the raw pointer API that are marked with accv.streaming = [dim arg, tile size],
+// along with the arguments their drivers need to offset per tile. This happens before the conversion to LLVM, while the
+// argument types still carry the array shapes
+LogicalResult CollectStreamingFunctions(ModuleOp module, std::vector<StreamingFunction>& streamingFns)
+{
+    for (auto fn : module.getOps<FuncOp>())
+    {
+        auto streamingAttr = fn->getAttrOfType<ArrayAttr>(StreamingAttrName);
+        if (!streamingAttr || fn.isExternal() || !fn->hasAttr(RawPointerAPIAttrName))
+        {
+            continue;
+        }
+
+        auto streaming = util::ConvertArrayAttrToIntVector(streamingAttr);
+        auto argTypes = fn.getType().getInputs();
+        if (streaming.size() != 2 || streaming[0] < 0 || streaming[0] >= static_cast<int64_t>(argTypes.size()) || !argTypes[streaming[0]].isa<IntegerType, IndexType>() || streaming[1] <= 0 || fn.getType().getNumResults() != 0)
+        {
+            return fn.emitError("Invalid streaming dimension or tile size");
+        }
+
+        StreamingFunction streamingFn{ fn.getName().str(), static_cast<unsigned>(streaming[0]), streaming[1], {} };
+        auto dimArgIndex = static_cast<int64_t>(streamingFn.dimArgIndex);
+        std::vector<Type> argTypesVec(argTypes.begin(), argTypes.end());
+        auto dynArgSizeReferences = util::ParseDynamicArgSizeReferences(fn, argTypesVec);
+        for (auto en : llvm::enumerate(argTypes))
+        {
+            auto memrefType = en.value().dyn_cast<MemRefType>();
+            if (!memrefType)
+            {
+                continue;
+            }
+
+            const auto& sizeRefs = dynArgSizeReferences[en.index()];
+            auto numRefs = llvm::count(sizeRefs, dimArgIndex);
+            if (numRefs == 0)
+            {
+                continue;
+            }
+
+            // Tiles of rows are only contiguous if the streamed dimension is the outermost one of a dense row-major array
+            if (numRefs != 1 || sizeRefs.front() != dimArgIndex || !canonicalizeStridedLayout(memrefType).getLayout().isIdentity())
+            {
+                return fn.emitError("Streamed arrays must be first-major, with the streaming dimension as their outermost dimension");
+            }
+
+            StreamedArgument streamedArg{ static_cast<unsigned>(en.index()), (memrefType.getElementTypeBitWidth() + 7) / 8, {} };
+            for (unsigned dim = 1; dim < memrefType.getRank(); ++dim)
+            {
+                if (memrefType.isDynamicDim(dim))
+                {
+                    streamedArg.rowSizeArgIndices.push_back(static_cast<unsigned>(sizeRefs[dim]));
+                }
+                else
+                {
+                    streamedArg.staticRowBytes *= memrefType.getDimSize(dim);
+                }
+            }
+            streamingFn.arguments.push_back(streamedArg);
+        }
+
+        if (streamingFn.arguments.empty())
+        {
+            return fn.emitError("Streaming functions need at least one array sized by the streaming dimension");
+        }
+        streamingFns.push_back(std::move(streamingFn));
+    }
+    return success();
+}
+
+// Emits `void <fn>_stream(args...)` for each streaming function, with the same arguments as the function. The driver
+// calls the function once per tile of `tileSize` rows (fewer for the last tile), passing the tile's row count as the
+// streaming dimension and pointers to the tile in each streamed argument. If `adviseMemory` is set, the driver
+// advises the next tile with MADV_WILLNEED before computing the current one, so that reading it overlaps with the
+// computation, and advises the processed tile with MADV_COLD afterwards
+void EmitStreamingDrivers(ModuleOp module, const std::vector<StreamingFunction>& streamingFns, bool adviseMemory, Type indexType)
+{
+    if (streamingFns.empty())
+    {
+        return;
+    }
+
+    auto loc = module.getLoc();
+    auto builder = OpBuilder::atBlockEnd(module.getBody());
+    auto i8PtrType = LLVM::LLVMPointerType::get(builder.getI8Type());
+    auto i32Type = builder.getI32Type();
+    if (adviseMemory)
+    {
+        DeclareMadvise(module, indexType);
+    }
+    auto madviseFn = module.lookupSymbol<LLVM::LLVMFuncOp>(kMadviseFnName);
+
+    for (const auto& streamingFn : streamingFns)
+    {
+        auto fn = module.lookupSymbol<LLVM::LLVMFuncOp>(streamingFn.name);
+        assert(fn && "Expected the streaming function to be lowered to an LLVM function");
+
+        auto driver = builder.create<LLVM::LLVMFuncOp>(loc, streamingFn.name + kStreamFnSuffix.str(), fn.getType());
+        auto entryBlock = driver.addEntryBlock();
+        auto conditionBlock = new Block();
+        auto bodyBlock = new Block();
+        auto exitBlock = new Block();
+        driver.getBody().push_back(conditionBlock);
+        driver.getBody().push_back(bodyBlock);
+        driver.getBody().push_back(exitBlock);
+        Value firstRow = conditionBlock->addArgument(indexType, loc);
+
+        auto b = OpBuilder::atBlockEnd(entryBlock);
+        auto constant = [&](int64_t value) -> Value {
+            return b.create<LLVM::ConstantOp>(loc, indexType, b.getIntegerAttr(indexType, value));
+        };
+        auto castInteger = [&](Value value, Type type) -> Value {
+            auto fromBits = value.getType().getIntOrFloatBitWidth();
+            auto toBits = type.getIntOrFloatBitWidth();
+            if (fromBits < toBits) return b.create<LLVM::SExtOp>(loc, type, value);
+            if (fromBits > toBits) return b.create<LLVM::TruncOp>(loc, type, value);
+            return value;
+        };
+        auto min = [&](Value lhs, Value rhs) -> Value {
+            return b.create<LLVM::SelectOp>(loc, b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::slt, lhs, rhs), lhs, rhs);
+        };
+        auto args = driver.getArguments();
+
+        Value numRows = castInteger(args[streamingFn.dimArgIndex], indexType);
+        Value tileSize = constant(streamingFn.tileSize);
+        Value pageMask = constant(-kStreamingPageSize);
+        std::vector<Value> rowBytes;
+        for (const auto& streamedArg : streamingFn.arguments)
+        {
+            Value bytes = constant(streamedArg.staticRowBytes);
+            for (auto sizeArgIndex : streamedArg.rowSizeArgIndices)
+            {
+                bytes = b.create<LLVM::MulOp>(loc, bytes, castInteger(args[sizeArgIndex], indexType));
+            }
+            rowBytes.push_back(bytes);
+        }
+
+        // Address of row `row` of the i-th streamed argument
+        auto rowAddress = [&](unsigned i, Value row) -> Value {
+            Value base = b.create<LLVM::PtrToIntOp>(loc, indexType, args[streamingFn.arguments[i].argIndex]);
+            return b.create<LLVM::AddOp>(loc, base, b.create<LLVM::MulOp>(loc, row, rowBytes[i]));
+        };
+
+        // madvise needs a page-aligned address and rounds the length up to whole pages. Read-ahead covers every page
+        // touched by the rows, while cold pages stop before the page holding the end of the rows, since the rest of
+        // that page belongs to the next tile
+        auto advise = [&](Value row, Value rows, int32_t advice) {
+            Value adviceValue = b.create<LLVM::ConstantOp>(loc, i32Type, b.getI32IntegerAttr(advice));
+            for (unsigned i = 0; i < streamingFn.arguments.size(); ++i)
+            {
+                Value start = rowAddress(i, row);
+                Value end = b.create<LLVM::AddOp>(loc, start, b.create<LLVM::MulOp>(loc, rows, rowBytes[i]));
+                Value alignedStart = b.create<LLVM::AndOp>(loc, start, pageMask);
+                if (advice == kMadviseCold)
+                {
+                    end = b.create<LLVM::AndOp>(loc, end, pageMask);
+                }
+                Value length = b.create<LLVM::SubOp>(loc, end, alignedStart);
+                b.create<LLVM::CallOp>(loc, madviseFn, ValueRange{ b.create<LLVM::IntToPtrOp>(loc, i8PtrType, alignedStart), length, adviceValue });
+            }
+        };
+
+        if (adviseMemory)
+        {
+            advise(constant(0), min(tileSize, numRows), kMadviseWillNeed);
+        }
+        b.create<LLVM::BrOp>(loc, ValueRange{ constant(0) }, conditionBlock);
+
+        b.setInsertionPointToEnd(conditionBlock);
+        Value hasRows = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::slt, firstRow, numRows);
+        b.create<LLVM::CondBrOp>(loc, hasRows, bodyBlock, exitBlock);
+
+        b.setInsertionPointToEnd(bodyBlock);
+        Value rows = min(tileSize, b.create<LLVM::SubOp>(loc, numRows, firstRow));
+        Value nextRow = b.create<LLVM::AddOp>(loc, firstRow, rows);
+        if (adviseMemory)
+        {
+            advise(nextRow, min(tileSize, b.create<LLVM::SubOp>(loc, numRows, nextRow)), kMadviseWillNeed);
+        }
+
+        llvm::SmallVector<Value> callArgs(args.begin(), args.end());
+        callArgs[streamingFn.dimArgIndex] = castInteger(rows, args[streamingFn.dimArgIndex].getType());
+        for (unsigned i = 0; i < streamingFn.arguments.size(); ++i)
+        {
+            auto argIndex = streamingFn.arguments[i].argIndex;
+            callArgs[argIndex] = b.create<LLVM::IntToPtrOp>(loc, args[argIndex].getType(), rowAddress(i, firstRow));
+        }
+        b.create<LLVM::CallOp>(loc, fn, callArgs);
+
+        if (adviseMemory)
+        {
+            advise(firstRow, rows, kMadviseCold);
+        }
+        b.create<LLVM::BrOp>(loc, ValueRange{ nextRow }, conditionBlock);
+
+        b.setInsertionPointToEnd(exitBlock);
+        b.create<LLVM::ReturnOp>(loc, ValueRange{});
+    }
+}
+
+// Collects the names of the functions exposed through the raw pointer API that are marked with accv.async_entry
+LogicalResult CollectAsyncEntryFunctions(ModuleOp module, std::vector<std::string>& asyncFnNames)
+{
+    for (auto fn : module.getOps<FuncOp>())
+    {
+        if (!fn->hasAttr(AsyncEntryAttrName) || fn.isExternal() || !fn->hasAttr(RawPointerAPIAttrName))
+        {
+            continue;
+        }
+        if (fn.getType().getNumResults() != 0)
+        {
+            return fn.emitError("Asynchronous entry points require functions without results");
+        }
+        asyncFnNames.push_back(fn.getName().str());
+    }
+    return success();
+}
+
+// Emits the worker that runs the queued calls of the asynchronous entry points:
+//
+//   int32_t __accera_async_submit(void* job);
+//   void* __accera_async_worker(void*);   // DWORD (*)(void*) with Win32 threads
+//
+// Every job starts with a header { uintptr_t next; void (*run)(void* job); }. __accera_async_submit appends the job
+// to a FIFO queue guarded by a mutex and wakes the worker, which pops the jobs one at a time and calls `run(job)`
+// outside of the lock. The first submission starts the worker: an atomic state moves from idle to starting for
+// exactly one caller, which initializes the mutex and condition variable and creates a detached thread, while
+// concurrent callers spin until it is running. If the thread can't be created the state goes back to idle, the
+// error code is returned and the next submission tries again. The worker never exits, so the OpenMP team of the
+// parallelized functions it calls is created once and reused by every later call
+LLVM::LLVMFuncOp EmitAsyncWorker(ModuleOp module, bool useWin32Threads, Type indexType)
+{
+    auto context = module.getContext();
+    auto loc = module.getLoc();
+    auto builder = OpBuilder::atBlockEnd(module.getBody());
+    auto voidType = LLVM::LLVMVoidType::get(context);
+    auto i32Type = builder.getI32Type();
+    auto i8PtrType = LLVM::LLVMPointerType::get(builder.getI8Type());
+    auto runFnPtrType = LLVM::LLVMPointerType::get(LLVM::LLVMFunctionType::get(voidType, { i8PtrType }));
+    auto headerPtrType = LLVM::LLVMPointerType::get(LLVM::LLVMStructType::getLiteral(context, { indexType, runFnPtrType }));
+
+    // The thread start routine is `void* (*)(void*)` with pthreads and `DWORD (*)(void*)` with Win32
+    auto threadResultType = useWin32Threads ? Type(i32Type) : Type(i8PtrType);
+    auto startRoutineType = LLVM::LLVMFunctionType::get(threadResultType, { i8PtrType });
+    auto startRoutinePtrType = LLVM::LLVMPointerType::get(startRoutineType);
+
+    auto declare = [&](StringRef name, Type resultType, ArrayRef<Type> argTypes) {
+        if (auto fn = module.lookupSymbol<LLVM::LLVMFuncOp>(name))
+        {
+            return fn;
+        }
+        auto declBuilder = OpBuilder::atBlockBegin(module.getBody());
+        return declBuilder.create<LLVM::LLVMFuncOp>(loc, name, LLVM::LLVMFunctionType::get(resultType, argTypes));
+    };
+    LLVM::LLVMFuncOp createThreadFn, releaseThreadFn, lockFn, unlockFn, waitFn, signalFn, mutexInitFn, condInitFn;
+    if (useWin32Threads)
+    {
+        // HANDLE CreateThread(LPSECURITY_ATTRIBUTES, SIZE_T, LPTHREAD_START_ROUTINE, LPVOID, DWORD, LPDWORD)
+        createThreadFn = declare(kCreateThreadFnName, i8PtrType, { i8PtrType, indexType, startRoutinePtrType, i8PtrType, i32Type, LLVM::LLVMPointerType::get(i32Type) });
+        // BOOL CloseHandle(HANDLE)
+        releaseThreadFn = declare(kCloseHandleFnName, i32Type, { i8PtrType });
+        // Slim reader/writer locks and condition variables are zero-initialized and need no setup:
+        // void AcquireSRWLockExclusive(PSRWLOCK), void ReleaseSRWLockExclusive(PSRWLOCK),
+        // BOOL SleepConditionVariableSRW(PCONDITION_VARIABLE, PSRWLOCK, DWORD, ULONG), void WakeConditionVariable(PCONDITION_VARIABLE)
+        lockFn = declare(kAcquireSRWLockFnName, voidType, { i8PtrType });
+        unlockFn = declare(kReleaseSRWLockFnName, voidType, { i8PtrType });
+        waitFn = declare(kSleepConditionVariableFnName, i32Type, { i8PtrType, i8PtrType, i32Type, i32Type });
+        signalFn = declare(kWakeConditionVariableFnName, voidType, { i8PtrType });
+    }
+    else
+    {
+        // pthread_t is passed as a pointer-sized integer, which matches both unsigned long (Linux) and a pointer (macOS)
+        // int pthread_create(pthread_t*, const pthread_attr_t*, void* (*)(void*), void*)
+        createThreadFn = declare(kPthreadCreateFnName, i32Type, { LLVM::LLVMPointerType::get(indexType), i8PtrType, startRoutinePtrType, i8PtrType });
+        // int pthread_detach(pthread_t)
+        releaseThreadFn = declare(kPthreadDetachFnName, i32Type, { indexType });
+        // The static initializers differ between platforms, so the mutex and condition variable are initialized
+        // at runtime by the thread that starts the worker:
+        // int pthread_mutex_init(pthread_mutex_t*, const pthread_mutexattr_t*), int pthread_mutex_lock(pthread_mutex_t*),
+        // int pthread_mutex_unlock(pthread_mutex_t*), int pthread_cond_init(pthread_cond_t*, const pthread_condattr_t*),
+        // int pthread_cond_wait(pthread_cond_t*, pthread_mutex_t*), int pthread_cond_signal(pthread_cond_t*)
+        mutexInitFn = declare(kPthreadMutexInitFnName, i32Type, { i8PtrType, i8PtrType });
+        lockFn = declare(kPthreadMutexLockFnName, i32Type, { i8PtrType });
+        unlockFn = declare(kPthreadMutexUnlockFnName, i32Type, { i8PtrType });
+        condInitFn = declare(kPthreadCondInitFnName, i32Type, { i8PtrType, i8PtrType });
+        waitFn = declare(kPthreadCondWaitFnName, i32Type, { i8PtrType, i8PtrType });
+        signalFn = declare(kPthreadCondSignalFnName, i32Type, { i8PtrType });
+    }
+
+    auto createIndexGlobal = [&](StringRef name) {
+        return builder.create<LLVM::GlobalOp>(loc, indexType, /*isConstant=*/false, LLVM::Linkage::Internal, name, builder.getIntegerAttr(indexType, 0));
+    };
+    auto createSyncObjectGlobal = [&](StringRef name) {
+        auto type = LLVM::LLVMArrayType::get(builder.getI8Type(), kSyncObjectBytes);
+        return builder.create<LLVM::GlobalOp>(loc, type, /*isConstant=*/false, LLVM::Linkage::Internal, name, builder.getStringAttr(std::string(kSyncObjectBytes, '\0')), kSyncObjectAlignment);
+    };
+    auto stateGlobal = builder.create<LLVM::GlobalOp>(loc, i32Type, /*isConstant=*/false, LLVM::Linkage::Internal, kAsyncStateGlobalName, builder.getI32IntegerAttr(kAsyncWorkerIdle));
+    auto headGlobal = createIndexGlobal(kAsyncQueueHeadGlobalName);
+    auto tailGlobal = createIndexGlobal(kAsyncQueueTailGlobalName);
+    auto mutexGlobal = createSyncObjectGlobal(kAsyncMutexGlobalName);
+    auto condGlobal = createSyncObjectGlobal(kAsyncCondGlobalName);
+
+    auto i32Constant = [&](OpBuilder& b, int32_t value) -> Value {
+        return b.create<LLVM::ConstantOp>(loc, i32Type, b.getI32IntegerAttr(value));
+    };
+    auto indexConstant = [&](OpBuilder& b, int64_t value) -> Value {
+        return b.create<LLVM::ConstantOp>(loc, indexType, b.getIntegerAttr(indexType, value));
+    };
+    auto addressOf = [&](OpBuilder& b, LLVM::GlobalOp global) -> Value {
+        return b.create<LLVM::BitcastOp>(loc, i8PtrType, b.create<LLVM::AddressOfOp>(loc, global));
+    };
+    auto nextPtr = [&](OpBuilder& b, Value job) -> Value {
+        Value zero = i32Constant(b, 0);
+        return b.create<LLVM::GEPOp>(loc, LLVM::LLVMPointerType::get(indexType), b.create<LLVM::BitcastOp>(loc, headerPtrType, job), ValueRange{ zero, zero });
+    };
+    auto runPtr = [&](OpBuilder& b, Value job) -> Value {
+        return b.create<LLVM::GEPOp>(loc, LLVM::LLVMPointerType::get(runFnPtrType), b.create<LLVM::BitcastOp>(loc, headerPtrType, job), ValueRange{ i32Constant(b, 0), i32Constant(b, 1) });
+    };
+    auto lock = [&](OpBuilder& b) {
+        b.create<LLVM::CallOp>(loc, lockFn, ValueRange{ addressOf(b, mutexGlobal) });
+    };
+    auto unlock = [&](OpBuilder& b) {
+        b.create<LLVM::CallOp>(loc, unlockFn, ValueRange{ addressOf(b, mutexGlobal) });
+    };
+    auto addBlock = [](LLVM::LLVMFuncOp fn) {
+        auto block = new Block();
+        fn.getBody().push_back(block);
+        return block;
+    };
+
+    // void* __accera_async_worker(void*)
+    auto workerFn = builder.create<LLVM::LLVMFuncOp>(loc, kAsyncWorkerFnName, startRoutineType, LLVM::Linkage::Internal);
+    {
+        auto entryBlock = workerFn.addEntryBlock();
+        auto waitCheckBlock = addBlock(workerFn);
+        auto waitBlock = addBlock(workerFn);
+        auto popBlock = addBlock(workerFn);
+
+        auto b = OpBuilder::atBlockEnd(entryBlock);
+        lock(b);
+        b.create<LLVM::BrOp>(loc, ValueRange{}, waitCheckBlock);
+
+        b.setInsertionPointToEnd(waitCheckBlock);
+        Value head = b.create<LLVM::LoadOp>(loc, b.create<LLVM::AddressOfOp>(loc, headGlobal));
+        Value isEmpty = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::eq, head, indexConstant(b, 0));
+        b.create<LLVM::CondBrOp>(loc, isEmpty, waitBlock, popBlock);
+
+        b.setInsertionPointToEnd(waitBlock);
+        if (useWin32Threads)
+        {
+            b.create<LLVM::CallOp>(loc, waitFn, ValueRange{ addressOf(b, condGlobal), addressOf(b, mutexGlobal), i32Constant(b, kWin32Infinite), i32Constant(b, 0) });
+        }
+        else
+        {
+            b.create<LLVM::CallOp>(loc, waitFn, ValueRange{ addressOf(b, condGlobal), addressOf(b, mutexGlobal) });
+        }
+        b.create<LLVM::BrOp>(loc, ValueRange{}, waitCheckBlock);
+
+        // Unlink the first job, clearing the tail when the queue becomes empty, and run it without holding the lock
+        b.setInsertionPointToEnd(popBlock);
+        Value job = b.create<LLVM::IntToPtrOp>(loc, i8PtrType, head);
+        Value next = b.create<LLVM::LoadOp>(loc, nextPtr(b, job));
+        b.create<LLVM::StoreOp>(loc, next, b.create<LLVM::AddressOfOp>(loc, headGlobal));
+        Value tailPtr = b.create<LLVM::AddressOfOp>(loc, tailGlobal);
+        Value isLast = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::eq, next, indexConstant(b, 0));
+        Value tail = b.create<LLVM::SelectOp>(loc, isLast, indexConstant(b, 0), b.create<LLVM::LoadOp>(loc, tailPtr));
+        b.create<LLVM::StoreOp>(loc, tail, tailPtr);
+        unlock(b);
+        Value run = b.create<LLVM::LoadOp>(loc, runPtr(b, job));
+        b.create<LLVM::CallOp>(loc, TypeRange{}, ValueRange{ run, job });
+        lock(b);
+        b.create<LLVM::BrOp>(loc, ValueRange{}, waitCheckBlock);
+    }
+
+    // int32_t __accera_async_submit(void* job)
+    auto submitFn = builder.create<LLVM::LLVMFuncOp>(loc, kAsyncSubmitFnName, LLVM::LLVMFunctionType::get(i32Type, { i8PtrType }), LLVM::Linkage::Internal);
+    {
+        auto entryBlock = submitFn.addEntryBlock();
+        auto checkBlock = addBlock(submitFn);
+        auto notRunningBlock = addBlock(submitFn);
+        auto startBlock = addBlock(submitFn);
+        auto startedBlock = addBlock(submitFn);
+        auto failBlock = addBlock(submitFn);
+        auto enqueueBlock = addBlock(submitFn);
+        auto emptyQueueBlock = addBlock(submitFn);
+        auto appendBlock = addBlock(submitFn);
+        auto linkedBlock = addBlock(submitFn);
+        Value errorCode = failBlock->addArgument(i32Type, loc);
+        Value job = submitFn.getArgument(0);
+
+        auto b = OpBuilder::atBlockEnd(entryBlock);
+        b.create<LLVM::BrOp>(loc, ValueRange{}, checkBlock);
+
+        b.setInsertionPointToEnd(checkBlock);
+        Value statePtr = b.create<LLVM::AddressOfOp>(loc, stateGlobal);
+        auto resultType = LLVM::LLVMStructType::getLiteral(context, { i32Type, b.getI1Type() });
+        Value exchanged = b.create<LLVM::AtomicCmpXchgOp>(loc, resultType, statePtr, i32Constant(b, kAsyncWorkerIdle), i32Constant(b, kAsyncWorkerStarting), LLVM::AtomicOrdering::acq_rel, LLVM::AtomicOrdering::acquire);
+        Value state = b.create<LLVM::ExtractValueOp>(loc, i32Type, exchanged, b.getI64ArrayAttr(0));
+        Value isRunning = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::eq, state, i32Constant(b, kAsyncWorkerRunning));
+        b.create<LLVM::CondBrOp>(loc, isRunning, enqueueBlock, notRunningBlock);
+
+        // Another caller is starting the worker: try again until it is running, or idle again after a failure
+        b.setInsertionPointToEnd(notRunningBlock);
+        Value isIdle = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::eq, state, i32Constant(b, kAsyncWorkerIdle));
+        b.create<LLVM::CondBrOp>(loc, isIdle, startBlock, checkBlock);
+
+        b.setInsertionPointToEnd(startBlock);
+        Value startRoutine = b.create<LLVM::AddressOfOp>(loc, workerFn);
+        Value nullPtr = b.create<LLVM::NullOp>(loc, i8PtrType);
+        Value thread;
+        if (useWin32Threads)
+        {
+            Value handle = b.create<LLVM::CallOp>(loc, createThreadFn, ValueRange{ nullPtr, indexConstant(b, 0), startRoutine, nullPtr, i32Constant(b, 0), b.create<LLVM::NullOp>(loc, LLVM::LLVMPointerType::get(i32Type)) }).getResult(0);
+            Value started = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::ne, b.create<LLVM::PtrToIntOp>(loc, indexType, handle), indexConstant(b, 0));
+            b.create<LLVM::CondBrOp>(loc, started, startedBlock, ValueRange{}, failBlock, ValueRange{ i32Constant(b, -1) });
+            thread = handle;
+        }
+        else
+        {
+            b.create<LLVM::CallOp>(loc, mutexInitFn, ValueRange{ addressOf(b, mutexGlobal), nullPtr });
+            b.create<LLVM::CallOp>(loc, condInitFn, ValueRange{ addressOf(b, condGlobal), nullPtr });
+            Value threadPtr = b.create<LLVM::AllocaOp>(loc, LLVM::LLVMPointerType::get(indexType), indexConstant(b, 1));
+            Value result = b.create<LLVM::CallOp>(loc, createThreadFn, ValueRange{ threadPtr, nullPtr, startRoutine, nullPtr }).getResult(0);
+            Value started = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::eq, result, i32Constant(b, 0));
+            b.create<LLVM::CondBrOp>(loc, started, startedBlock, ValueRange{}, failBlock, ValueRange{ result });
+            b.setInsertionPointToStart(startedBlock);
+            thread = b.create<LLVM::LoadOp>(loc, threadPtr);
+        }
+
+        // The worker runs independently from here on: detach it, or close the handle on Windows
+        b.setInsertionPointToEnd(startedBlock);
+        b.create<LLVM::CallOp>(loc, releaseThreadFn, ValueRange{ thread });
+        b.create<LLVM::AtomicRMWOp>(loc, i32Type, LLVM::AtomicBinOp::xchg, b.create<LLVM::AddressOfOp>(loc, stateGlobal), i32Constant(b, kAsyncWorkerRunning), LLVM::AtomicOrdering::acq_rel);
+        b.create<LLVM::BrOp>(loc, ValueRange{}, enqueueBlock);
+
+        b.setInsertionPointToEnd(failBlock);
+        b.create<LLVM::AtomicRMWOp>(loc, i32Type, LLVM::AtomicBinOp::xchg, b.create<LLVM::AddressOfOp>(loc, stateGlobal), i32Constant(b, kAsyncWorkerIdle), LLVM::AtomicOrdering::acq_rel);
+        b.create<LLVM::ReturnOp>(loc, ValueRange{ errorCode });
+
+        b.setInsertionPointToEnd(enqueueBlock);
+        Value jobAddress = b.create<LLVM::PtrToIntOp>(loc, indexType, job);
+        b.create<LLVM::StoreOp>(loc, indexConstant(b, 0), nextPtr(b, job));
+        lock(b);
+        Value tail = b.create<LLVM::LoadOp>(loc, b.create<LLVM::AddressOfOp>(loc, tailGlobal));
+        Value isEmpty = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::eq, tail, indexConstant(b, 0));
+        b.create<LLVM::CondBrOp>(loc, isEmpty, emptyQueueBlock, appendBlock);
+
+        b.setInsertionPointToEnd(emptyQueueBlock);
+        b.create<LLVM::StoreOp>(loc, jobAddress, b.create<LLVM::AddressOfOp>(loc, headGlobal));
+        b.create<LLVM::BrOp>(loc, ValueRange{}, linkedBlock);
+
+        b.setInsertionPointToEnd(appendBlock);
+        b.create<LLVM::StoreOp>(loc, jobAddress, nextPtr(b, b.create<LLVM::IntToPtrOp>(loc, i8PtrType, tail)));
+        b.create<LLVM::BrOp>(loc, ValueRange{}, linkedBlock);
+
+        b.setInsertionPointToEnd(linkedBlock);
+        b.create<LLVM::StoreOp>(loc, jobAddress, b.create<LLVM::AddressOfOp>(loc, tailGlobal));
+        b.create<LLVM::CallOp>(loc, signalFn, ValueRange{ addressOf(b, condGlobal) });
+        unlock(b);
+        b.create<LLVM::ReturnOp>(loc, ValueRange{ i32Constant(b, 0) });
+    }
+
+    return submitFn;
+}
+
+// Emits `int32_t <fn>_async(args..., void (*completion)(void*), void* user_data)` for each function in `asyncFnNames`.
+// The entry point copies the arguments into a heap-allocated job and queues it to the module's worker thread (see
+// EmitAsyncWorker), which calls the function, frees the job, and then calls `completion(user_data)` if `completion`
+// isn't null. Calls run one at a time in the order they were queued. The entry point returns 0 once the job is
+// queued, or an error code (and never calls `completion`) if the job couldn't be allocated or the worker couldn't
+// be started. Threads are created with pthreads, or with the Win32 thread API if `useWin32Threads` is set
+void EmitAsyncEntryPoints(ModuleOp module, const std::vector<std::string>& asyncFnNames, bool useWin32Threads, Type indexType)
+{
+    if (asyncFnNames.empty())
+    {
+        return;
+    }
+
+    auto context = module.getContext();
+    auto loc = module.getLoc();
+    auto builder = OpBuilder::atBlockEnd(module.getBody());
+    auto voidType = LLVM::LLVMVoidType::get(context);
+    auto i32Type = builder.getI32Type();
+    auto i8PtrType = LLVM::LLVMPointerType::get(builder.getI8Type());
+    auto runFnType = LLVM::LLVMFunctionType::get(voidType, { i8PtrType });
+    auto callbackType = LLVM::LLVMPointerType::get(runFnType);
+
+    auto mallocFn = LLVM::lookupOrCreateMallocFn(module, indexType);
+    auto freeFn = LLVM::lookupOrCreateFreeFn(module);
+    auto submitFn = EmitAsyncWorker(module, useWin32Threads, indexType);
+
+    for (const auto& name : asyncFnNames)
+    {
+        auto fn = module.lookupSymbol<LLVM::LLVMFuncOp>(name);
+        assert(fn && "Expected the function to be lowered to an LLVM function");
+
+        // The job holds the queue header (the next job and the function that runs this one), followed by the
+        // function's arguments, the completion callback and its user data
+        constexpr unsigned kFirstArgField = 2;
+        auto argTypes = fn.getType().getParams();
+        llvm::SmallVector<Type> jobFields{ indexType, LLVM::LLVMPointerType::get(runFnType) };
+        jobFields.append(argTypes.begin(), argTypes.end());
+        jobFields.push_back(callbackType);
+        jobFields.push_back(i8PtrType);
+        auto jobPtrType = LLVM::LLVMPointerType::get(LLVM::LLVMStructType::getLiteral(context, jobFields));
+
+        auto fieldPtr = [&](OpBuilder& b, Value job, unsigned idx) -> Value {
+            Value zero = b.create<LLVM::ConstantOp>(loc, i32Type, b.getI32IntegerAttr(0));
+            Value fieldIdx = b.create<LLVM::ConstantOp>(loc, i32Type, b.getI32IntegerAttr(idx));
+            return b.create<LLVM::GEPOp>(loc, LLVM::LLVMPointerType::get(jobFields[idx]), job, ValueRange{ zero, fieldIdx });
+        };
+
+        // void <fn>_async_run(void* job), called by the worker
+        auto runFn = builder.create<LLVM::LLVMFuncOp>(loc, name + kAsyncRunSuffix.str(), runFnType, LLVM::Linkage::Internal);
+        {
+            auto entryBlock = runFn.addEntryBlock();
+            auto notifyBlock = new Block();
+            auto doneBlock = new Block();
+            runFn.getBody().push_back(notifyBlock);
+            runFn.getBody().push_back(doneBlock);
+
+            auto b = OpBuilder::atBlockEnd(entryBlock);
+            Value rawJob = runFn.getArgument(0);
+            Value job = b.create<LLVM::BitcastOp>(loc, jobPtrType, rawJob);
+            llvm::SmallVector<Value> fields;
+            for (unsigned idx = kFirstArgField; idx < jobFields.size(); ++idx)
+            {
+                fields.push_back(b.create<LLVM::LoadOp>(loc, fieldPtr(b, job, idx)));
+            }
+            Value userData = fields.pop_back_val();
+            Value callback = fields.pop_back_val();
+            b.create<LLVM::CallOp>(loc, fn, fields);
+            b.create<LLVM::CallOp>(loc, freeFn, ValueRange{ rawJob });
+            Value hasCallback = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::ne, b.create<LLVM::PtrToIntOp>(loc, indexType, callback), b.create<LLVM::ConstantOp>(loc, indexType, b.getIntegerAttr(indexType, 0)));
+            b.create<LLVM::CondBrOp>(loc, hasCallback, notifyBlock, doneBlock);
+
+            b.setInsertionPointToEnd(notifyBlock);
+            b.create<LLVM::CallOp>(loc, TypeRange{}, ValueRange{ callback, userData });
+            b.create<LLVM::BrOp>(loc, ValueRange{}, doneBlock);
+
+            b.setInsertionPointToEnd(doneBlock);
+            b.create<LLVM::ReturnOp>(loc, ValueRange{});
+        }
+
+        llvm::SmallVector<Type> asyncArgTypes(jobFields.begin() + kFirstArgField, jobFields.end());
+        auto asyncFn = builder.create<LLVM::LLVMFuncOp>(loc, name + kAsyncFnSuffix.str(), LLVM::LLVMFunctionType::get(i32Type, asyncArgTypes));
+        {
+            auto entryBlock = asyncFn.addEntryBlock();
+            auto submitBlock = new Block();
+            auto queuedBlock = new Block();
+            auto failBlock = new Block();
+            asyncFn.getBody().push_back(submitBlock);
+            asyncFn.getBody().push_back(queuedBlock);
+            asyncFn.getBody().push_back(failBlock);
+            Value errorCode = failBlock->addArgument(i32Type, loc);
+
+            auto b = OpBuilder::atBlockEnd(entryBlock);
+            auto i32Constant = [&](int32_t value) -> Value {
+                return b.create<LLVM::ConstantOp>(loc, i32Type, b.getI32IntegerAttr(value));
+            };
+            auto indexConstant = [&](int64_t value) -> Value {
+                return b.create<LLVM::ConstantOp>(loc, indexType, b.getIntegerAttr(indexType, value));
+            };
+
+            // sizeof(job), computed as the address of the second element of an array of jobs starting at null
+            Value jobEnd = b.create<LLVM::GEPOp>(loc, jobPtrType, b.create<LLVM::NullOp>(loc, jobPtrType), ValueRange{ indexConstant(1) });
+            Value jobSize = b.create<LLVM::PtrToIntOp>(loc, indexType, jobEnd);
+            Value rawJob = b.create<LLVM::CallOp>(loc, mallocFn, ValueRange{ jobSize }).getResult(0);
+            Value allocated = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::ne, b.create<LLVM::PtrToIntOp>(loc, indexType, rawJob), indexConstant(0));
+            b.create<LLVM::CondBrOp>(loc, allocated, submitBlock, ValueRange{}, failBlock, ValueRange{ i32Constant(kAsyncOutOfMemory) });
+
+            b.setInsertionPointToEnd(submitBlock);
+            Value job = b.create<LLVM::BitcastOp>(loc, jobPtrType, rawJob);
+            b.create<LLVM::StoreOp>(loc, b.create<LLVM::AddressOfOp>(loc, runFn), fieldPtr(b, job, 1));
+            for (auto en : llvm::enumerate(asyncFn.getArguments()))
+            {
+                b.create<LLVM::StoreOp>(loc, en.value(), fieldPtr(b, job, kFirstArgField + en.index()));
+            }
+            Value result = b.create<LLVM::CallOp>(loc, submitFn, ValueRange{ rawJob }).getResult(0);
+            Value queued = b.create<LLVM::ICmpOp>(loc, LLVM::ICmpPredicate::eq, result, i32Constant(0));
+            b.create<LLVM::CondBrOp>(loc, queued, queuedBlock, ValueRange{}, failBlock, ValueRange{ result });
+
+            b.setInsertionPointToEnd(queuedBlock);
+            b.create<LLVM::ReturnOp>(loc, ValueRange{ i32Constant(0) });
+
+            b.setInsertionPointToEnd(failBlock);
+            b.create<LLVM::CallOp>(loc, freeFn, ValueRange{ rawJob });
+            b.create<LLVM::ReturnOp>(loc, ValueRange{ errorCode });
+        }
+    }
+}
+
 struct LLVMCallFixupPattern : OpRewritePattern<LLVM::CallOp>
 {
     using OpRewritePattern::OpRewritePattern;
@@ -1841,6 +3266,23 @@ void ValueToLLVMLoweringPass::runOnModule()
 
     LLVMTypeConverter barePtrTypeConverter(&getContext(), barePtrOptions);
 
+    auto advisedGlobals = PrepareHugePageAllocations(moduleOp, hugePageThreshold, deviceInfo.IsLinux(), llvmTypeConverter.getIndexType());
+
+    std::vector<StreamingFunction> streamingFns;
+    std::vector<std::string> asyncFnNames;
+    if (failed(CollectStreamingFunctions(moduleOp, streamingFns)) || failed(CollectAsyncEntryFunctions(moduleOp, asyncFnNames)))
+    {
+        signalPassFailure();
+        return;
+    }
+
+    if (useWorkspaceAllocator)
+    {
+        AnnotateWorkspaceSizes(moduleOp);
+        EmitWorkspaceSizeFunctions(moduleOp);
+        EmitWorkspaceAllocatorFunctions(moduleOp, llvmTypeConverter.getIndexType());
+    }
+
     llvm::SmallVector<Operation*> rawPointerFuncs;
 
     for (auto it = moduleOp.getOps().begin(), e = moduleOp.getOps().end(); it != e; ++it)
@@ -1873,6 +3315,10 @@ void ValueToLLVMLoweringPass::runOnModule()
 
         RewritePatternSet patterns(&getContext());
         populateValueToLLVMNonMemPatterns(llvmTypeConverter, patterns, this->deviceInfo);
+        if (useWorkspaceAllocator)
+        {
+            populateWorkspaceAllocatorPatterns(llvmTypeConverter, patterns);
+        }
 
         populateLinalgToLLVMConversionPatterns(llvmTypeConverter, patterns);
 
@@ -1937,6 +3383,10 @@ void ValueToLLVMLoweringPass::runOnModule()
 
     snapshotter.Snapshot("ToLLVM_Mem", moduleOp);
 
+    EmitHugePageAdvice(moduleOp, advisedGlobals, llvmTypeConverter.getIndexType());
+    EmitStreamingDrivers(moduleOp, streamingFns, deviceInfo.IsLinux(), llvmTypeConverter.getIndexType());
+    EmitAsyncEntryPoints(moduleOp, asyncFnNames, deviceInfo.IsWindows(), llvmTypeConverter.getIndexType());
+
     {
         RewritePatternSet patterns(&getContext());
         patterns.insert<LLVMCallFixupPattern>(&getContext());
@@ -1990,6 +3440,15 @@ void populateValueToLLVMNonMemPatterns(mlir::LLVMTypeConverter& typeConverter, m
     populateLocalValueToLLVMNonMemPatterns(typeConverter, patterns, deviceInfo);
 }
 
+void populateWorkspaceAllocatorPatterns(mlir::LLVMTypeConverter& typeConverter, mlir::RewritePatternSet& patterns)
+{
+    mlir::MLIRContext* context = patterns.getContext();
+
+    // Take precedence over the malloc-based MemrefAllocOpLowering and the upstream dealloc lowering
+    patterns.insert<MemrefAllocOpLowering>(typeConverter, context, /*useWorkspaceAllocator=*/true, /*benefit=*/2);
+    patterns.insert<MemrefDeallocOpLowering>(typeConverter, context, /*benefit=*/2);
+}
+
 void populateValueToLLVMMemPatterns(mlir::LLVMTypeConverter& typeConverter, mlir::RewritePatternSet& patterns)
 {
     mlir::MLIRContext* context = patterns.getContext();
@@ -2028,9 +3487,11 @@ std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createValueToLLVMPass(bool
                                                                            bool useAlignedAlloc,
                                                                            llvm::DataLayout dataLayout,
                                                                            accera::value::TargetDevice deviceInfo /*  = {} */,
-                                                                           const IntraPassSnapshotOptions& options /*  = {} */)
+                                                                           const IntraPassSnapshotOptions& options /*  = {} */,
+                                                                           bool useWorkspaceAllocator /* = false */,
+                                                                           int64_t hugePageThreshold /* = 0 */)
 {
-    return std::make_unique<ValueToLLVMLoweringPass>(useBasePtrCallConv, emitCWrappers, indexBitwidth, useAlignedAlloc, dataLayout, deviceInfo, options);
+    return std::make_unique<ValueToLLVMLoweringPass>(useBasePtrCallConv, emitCWrappers, indexBitwidth, useAlignedAlloc, dataLayout, deviceInfo, options, useWorkspaceAllocator, hugePageThreshold);
 }
 
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createValueToLLVMPass()
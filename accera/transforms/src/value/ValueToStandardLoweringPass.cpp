@@ -232,6 +232,16 @@ struct StoreOpLowering : public OpRewritePattern<ValueStoreOp>
         PatternRewriter& rewriter) const override;
 };
 
+using ValueAtomicRMWOp = vir::AtomicRMWOp;
+struct AtomicRMWOpLowering : public OpRewritePattern<ValueAtomicRMWOp>
+{
+    using OpRewritePattern<ValueAtomicRMWOp>::OpRewritePattern;
+
+    LogicalResult matchAndRewrite(
+        ValueAtomicRMWOp op,
+        PatternRewriter& rewriter) const override;
+};
+
 using ValueCmpOp = vir::CmpOp;
 struct CmpOpLowering : public OpRewritePattern<ValueCmpOp>
 {
@@ -542,6 +552,10 @@ struct AllocOpLowering : public OpRewritePattern<ValueAllocOp>
             {
             case vir::MemoryAllocType::Global: {
                 auto globalOp = irutil::CreateGlobalBufferOp(rewriter, op, MemRefType::Builder{ memrefType }.setLayout({}), kGlobalOpSymNameFormat);
+                if (op->hasAttr(ir::HugePagesAttrName))
+                {
+                    globalOp->setAttr(ir::HugePagesAttrName, rewriter.getUnitAttr());
+                }
                 rewriter.replaceOpWithNewOp<vir::ReferenceGlobalOp>(op, memrefType, globalOp.sym_name());
             }
             break;
@@ -552,10 +566,27 @@ struct AllocOpLowering : public OpRewritePattern<ValueAllocOp>
             case vir::MemoryAllocType::Heap:
                 rewriter.restoreInsertionPoint(insertPoint);
                 allocOp = rewriter.replaceOpWithNewOp<memref::AllocOp>(op, memrefType, op.getOperation()->getOperands(), op.alignmentAttr());
+                if (op->hasAttr(ir::HugePagesAttrName))
+                {
+                    allocOp->setAttr(ir::HugePagesAttrName, rewriter.getUnitAttr());
+                }
 
-                // Create a dealloc op at the end of the block containing this alloc op
+                // Create a dealloc op at the end of the block containing this alloc op. The deallocs are kept in
+                // the reverse order of the allocs, since the workspace allocator only releases its most recent block
                 parentBlock = allocOp->getBlock();
-                rewriter.setInsertionPoint(parentBlock->getTerminator());
+                {
+                    mlir::Operation* deallocPoint = parentBlock->getTerminator();
+                    while (auto prevDealloc = dyn_cast_or_null<memref::DeallocOp>(deallocPoint->getPrevNode()))
+                    {
+                        auto freedAlloc = prevDealloc.memref().getDefiningOp();
+                        if (!freedAlloc || freedAlloc->getBlock() != parentBlock || !freedAlloc->isBeforeInBlock(allocOp))
+                        {
+                            break;
+                        }
+                        deallocPoint = prevDealloc;
+                    }
+                    rewriter.setInsertionPoint(deallocPoint);
+                }
 
                 allocatedMemref = allocOp.getResult();
                 rewriter.create<memref::DeallocOp>(allocOp.getLoc(), allocatedMemref);
@@ -1302,7 +1333,8 @@ LogicalResult GlobalOpLowering::matchAndRewrite(
     PatternRewriter& rewriter) const
 {
     ValueGlobalOp::Adaptor adaptor(op);
-    rewriter.replaceOpWithNewOp<memref::GlobalOp>(
+    auto hugePages = op->hasAttr(ir::HugePagesAttrName);
+    auto globalOp = rewriter.replaceOpWithNewOp<memref::GlobalOp>(
         op,
         adaptor.sym_name(),
         rewriter.getStringAttr(op.external() ? "public" : "nested"),
@@ -1310,6 +1342,10 @@ LogicalResult GlobalOpLowering::matchAndRewrite(
         adaptor.value().hasValue() ? adaptor.value().getValue() : nullptr,
         adaptor.constant(),
         /*alignment=*/IntegerAttr());
+    if (hugePages)
+    {
+        globalOp->setAttr(ir::HugePagesAttrName, rewriter.getUnitAttr());
+    }
 
     return success();
 }
@@ -1402,6 +1438,90 @@ LogicalResult StoreOpLowering::matchAndRewrite(
     return success();
 }
 
+LogicalResult AtomicRMWOpLowering::matchAndRewrite(
+    ValueAtomicRMWOp op,
+    PatternRewriter& rewriter) const
+{
+    auto loc = rewriter.getFusedLoc({ op.getLoc(), RC_FILE_LOC(rewriter) });
+    auto indexType = rewriter.getIndexType();
+
+    llvm::SmallVector<mlir::Value, 4> resolvedIndices;
+    for (auto index : op.indices())
+    {
+        if (index.getType().isIndex())
+        {
+            resolvedIndices.push_back(index);
+        }
+        else
+        {
+            resolvedIndices.push_back(
+                rewriter.create<arith::IndexCastOp>(loc,
+                                                    indexType,
+                                                    rewriter.create<vir::GetElementOp>(loc, index)));
+        }
+    }
+
+    mlir::Value memref = op.memref();
+    mlir::Value value = rewriter.create<vir::GetElementOp>(loc, op.value());
+    auto memrefType = op.getMemRefType();
+    auto elementType = memrefType.getElementType();
+    auto isUnsigned = elementType.isUnsignedInteger();
+    if (isUnsigned)
+    {
+        // memref.atomic_rmw only accepts signless ints, the signedness is carried by the kind instead
+        auto signlessType = rewriter.getIntegerType(elementType.getIntOrFloatBitWidth());
+        auto signlessMemRefType = MemRefType::Builder(memrefType).setElementType(signlessType);
+        memref = rewriter.create<UnrealizedConversionCastOp>(loc, static_cast<MemRefType>(signlessMemRefType), memref).getResult(0);
+        value = rewriter.create<UnrealizedConversionCastOp>(loc, signlessType, value).getResult(0);
+    }
+
+    using accera::ir::value::AtomicRMWKind;
+    auto isFloat = elementType.isa<FloatType>();
+    auto kind = op.kind();
+
+    mlir::Value result;
+    if (isFloat && (kind == AtomicRMWKind::MAX || kind == AtomicRMWKind::MIN))
+    {
+        // There are no native atomics for floating point max / min, fall back to a compare-and-swap loop
+        auto genericOp = rewriter.create<memref::GenericAtomicRMWOp>(loc, memref, resolvedIndices);
+        auto bodyBuilder = OpBuilder::atBlockEnd(genericOp.getBody());
+        auto current = genericOp.getCurrentValue();
+        auto pred = kind == AtomicRMWKind::MAX ? arith::CmpFPredicate::OGT : arith::CmpFPredicate::OLT;
+        auto cmp = bodyBuilder.create<arith::CmpFOp>(loc, pred, value, current);
+        auto selected = bodyBuilder.create<arith::SelectOp>(loc, cmp, value, current);
+        (void)bodyBuilder.create<memref::AtomicYieldOp>(loc, selected.getResult());
+        result = genericOp.getResult();
+    }
+    else
+    {
+        auto rmwKind = [&]() {
+            switch (kind)
+            {
+            case AtomicRMWKind::ADD:
+                return isFloat ? arith::AtomicRMWKind::addf : arith::AtomicRMWKind::addi;
+            case AtomicRMWKind::MAX:
+                return isUnsigned ? arith::AtomicRMWKind::maxu : arith::AtomicRMWKind::maxs;
+            case AtomicRMWKind::MIN:
+                return isUnsigned ? arith::AtomicRMWKind::minu : arith::AtomicRMWKind::mins;
+            case AtomicRMWKind::XCHG:
+                return arith::AtomicRMWKind::assign;
+            default:
+                assert(false);
+                return arith::AtomicRMWKind::assign;
+            }
+        }();
+        result = rewriter.create<memref::AtomicRMWOp>(loc, rmwKind, value, memref, resolvedIndices);
+    }
+
+    if (isUnsigned)
+    {
+        result = rewriter.create<UnrealizedConversionCastOp>(loc, elementType, result).getResult(0);
+    }
+    rewriter.replaceOp(op.getOperation(), { result });
+
+    return success();
+}
+
 using ValueCmpOpPredicate = vir::CmpOpPredicate;
 
 static ValueCmpOpPredicate NegateCmpOpPredicate(ValueCmpOpPredicate pred)
@@ -2951,6 +3071,7 @@ void populateValueToStandardPatterns(bool enableProfiling, ProfileRegions& profi
         GPUTargetedFuncRewritePattern,
         GPUTargetedFuncTerminatorRewritePattern,
         AllocOpLowering,
+        AtomicRMWOpLowering,
         CastOpLowering,
         BinOpLowering,
         CmpOpLowering,
@@ -21,12 +21,54 @@ namespace accera
 namespace utilities
 {
     /// <summary> For performing an affine mapping from access indices to memory locations. </summary>
+    ///
+    /// Blocked and swizzled layouts are described with `blockSizes`, `blockOrder`, `padding` and `swizzle` instead of
+    /// `coefficients`: their strides depend on the shape of the buffer they lay out (e.g. the active block of a cache),
+    /// so they are resolved once that shape is known. See `ResolveBlockedLayout`.
     struct MemoryAffineCoefficients
     {
         std::vector<int64_t> coefficients;
         int64_t offset{};
+
+        /// <summary> The block size along each dimension, or 0 to leave a dimension unblocked. Empty for plain affine maps. </summary>
+        std::vector<int64_t> blockSizes;
+
+        /// <summary> The major-to-minor order of the block components, where `d` is the block index along dimension `d`
+        /// and `rank + d` is the position within the block along dimension `d`. Components that are left out are placed
+        /// outermost. Defaults to the block indices followed by the positions within a block, both first-major. </summary>
+        std::vector<int64_t> blockOrder;
+
+        /// <summary> Elements added to the stride of the second-innermost component, so that power-of-two strides
+        /// don't map to the same cache sets. </summary>
+        int64_t padding{};
+
+        /// <summary> Empty, or { dim, sourceDim, shift }: the position within a block along `dim` is rotated by `shift`
+        /// times the position within a block along `sourceDim`, modulo the block size along `dim`. </summary>
+        std::vector<int64_t> swizzle;
+
+        bool IsBlocked() const { return !blockSizes.empty(); }
     };
 
+    /// <summary> One component (a block index or a position within a block) of a resolved blocked layout. </summary>
+    struct BlockedLayoutComponent
+    {
+        int64_t dimension;
+        bool withinBlock;
+        int64_t blockSize;
+        int64_t extent;
+        int64_t stride;
+    };
+
+    /// <summary> Resolves a blocked layout against the shape of the buffer it lays out. </summary>
+    ///
+    /// <param name="layout"> The blocked layout. </param>
+    /// <param name="shape"> The shape of the logical buffer. </param>
+    /// <returns> The components of the layout, in major-to-minor order. </returns>
+    std::vector<BlockedLayoutComponent> ResolveBlockedLayout(const MemoryAffineCoefficients& layout, const std::vector<int64_t>& shape);
+
+    /// <summary> Gets the number of elements a flat buffer needs to hold a logical buffer of the given shape laid out by an affine map. </summary>
+    int64_t GetAffineLayoutBufferSize(const MemoryAffineCoefficients& layout, const std::vector<int64_t>& shape);
+
     /// <summary> An abstract base class for DimensionOrder,  MemoryShape, and MemoryCoordinates. </summary>
     class DimensionVector
     {
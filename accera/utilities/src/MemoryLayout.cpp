@@ -737,9 +737,85 @@ namespace utilities
         return !MemoryLayoutsEqual(layout1, layout2);
     }
 
+    std::vector<BlockedLayoutComponent> ResolveBlockedLayout(const MemoryAffineCoefficients& layout, const std::vector<int64_t>& shape)
+    {
+        const auto rank = static_cast<int64_t>(shape.size());
+        if (static_cast<int64_t>(layout.blockSizes.size()) != rank)
+        {
+            throw InputException(InputExceptionErrors::invalidArgument, "Blocked layouts need one block size per dimension");
+        }
+
+        // Components that aren't listed in the order go first, in their natural order
+        auto order = layout.blockOrder;
+        if (order.empty())
+        {
+            order.resize(2 * rank);
+            std::iota(order.begin(), order.end(), 0);
+        }
+        std::vector<bool> listed(2 * rank, false);
+        for (auto component : order)
+        {
+            if (component < 0 || component >= 2 * rank || listed[component])
+            {
+                throw InputException(InputExceptionErrors::invalidArgument, "Blocked layout order must list each block component at most once");
+            }
+            listed[component] = true;
+        }
+        std::vector<int64_t> fullOrder;
+        for (int64_t component = 0; component < 2 * rank; ++component)
+        {
+            if (!listed[component])
+            {
+                fullOrder.push_back(component);
+            }
+        }
+        fullOrder.insert(fullOrder.end(), order.begin(), order.end());
+
+        std::vector<BlockedLayoutComponent> components;
+        for (auto component : fullOrder)
+        {
+            auto dim = component % rank;
+            auto blockSize = layout.blockSizes[dim] > 0 ? std::min(layout.blockSizes[dim], shape[dim]) : shape[dim];
+            auto numBlocks = (shape[dim] + blockSize - 1) / blockSize;
+            bool withinBlock = component >= rank;
+            components.push_back({ dim, withinBlock, blockSize, withinBlock ? blockSize : numBlocks, 0 });
+        }
+
+        // Innermost component first, padding the stride of the component outside it
+        int64_t stride = 1;
+        for (auto it = components.rbegin(); it != components.rend(); ++it)
+        {
+            it->stride = stride;
+            stride = stride * it->extent + (it == components.rbegin() ? layout.padding : 0);
+        }
+        return components;
+    }
+
+    int64_t GetAffineLayoutBufferSize(const MemoryAffineCoefficients& layout, const std::vector<int64_t>& shape)
+    {
+        int64_t maxPosition = layout.offset;
+        if (layout.IsBlocked())
+        {
+            for (const auto& component : ResolveBlockedLayout(layout, shape))
+            {
+                maxPosition += component.stride * (component.extent - 1);
+            }
+        }
+        else
+        {
+            for (size_t dim = 0; dim < layout.coefficients.size() && dim < shape.size(); ++dim)
+            {
+                maxPosition += std::max<int64_t>(layout.coefficients[dim], 0) * (shape[dim] - 1);
+            }
+        }
+        return maxPosition + 1;
+    }
+
     bool operator==(const MemoryAffineCoefficients& coeff1, const MemoryAffineCoefficients& coeff2)
     {
-        return (coeff1.coefficients == coeff2.coefficients) && (coeff1.offset == coeff2.offset);
+        return (coeff1.coefficients == coeff2.coefficients) && (coeff1.offset == coeff2.offset) &&
+               (coeff1.blockSizes == coeff2.blockSizes) && (coeff1.blockOrder == coeff2.blockOrder) &&
+               (coeff1.padding == coeff2.padding) && (coeff1.swizzle == coeff2.swizzle);
     }
 
     bool operator!=(const MemoryAffineCoefficients& coeff1, const MemoryAffineCoefficients& coeff2)
@@ -61,6 +61,11 @@ namespace ir
         return "accv.output_verifiers";
     }
 
+    inline std::string GetVerificationSamplesAttrName()
+    {
+        return "accv.verification_samples";
+    }
+
     inline std::string GetPrintErrorFunctionName()
     {
         return "_acc_eprintf_";
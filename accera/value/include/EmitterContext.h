@@ -49,6 +49,8 @@ namespace value
         Stack = 1 << 1,
         Heap = 1 << 2,
         Global = 1 << 3,
+        // Back the allocation with huge pages where the target supports them, can be combined with the other flags
+        HugePages = 1 << 4,
     };
     ACCERA_DEFINE_ENUM_FLAG_OPERATORS(AllocateFlags);
 
@@ -9,6 +9,7 @@
 #include "EmitterContext.h"
 #include "ExecutionOptions.h"
 #include "Scalar.h"
+#include "ScalarDimension.h"
 #include "Value.h"
 
 #include "ir/include/value/ValueAttributes.h"
@@ -170,6 +171,23 @@ namespace value
         /// <param name="functionNames"> List of verifier function names, one per output parameter. </param>
         FunctionDeclaration& OutputVerifiers(const std::vector<std::string>& functionNames = {});
 
+        /// <summary> Sets the number of output elements to verify against the reference implementation. </summary>
+        /// <param name="samples"> Approximate number of sampled output elements, or 0 to verify every element. </param>
+        FunctionDeclaration& VerificationSamples(int64_t samples);
+
+        /// <summary> Requests a streaming driver for this function, which calls it on tiles of its streamed arguments. </summary>
+        /// <param name="dimArgIndex"> Index of the dimension argument that sizes the outermost dimension of the streamed arguments. </param>
+        /// <param name="tileSize"> Number of rows of the streamed arguments in each tile. </param>
+        FunctionDeclaration& Streaming(int64_t dimArgIndex, int64_t tileSize);
+
+        /// <summary> Sets whether an asynchronous entry point that runs this function on its own thread is emitted. </summary>
+        /// <param name="asyncEntry"> Whether to emit the asynchronous entry point. </param>
+        FunctionDeclaration& AsyncEntry(bool asyncEntry);
+
+        /// <summary> Sets the declared constraints on the runtime values of the function arguments. </summary>
+        /// <param name="constraints"> One entry per parameter, empty for unconstrained parameters. </param>
+        FunctionDeclaration& ArgumentConstraints(const std::vector<DimensionConstraints>& constraints);
+
         /// <summary> Gets the final function name, including any decoration if so applicable </summary>
         const std::string& GetFunctionName() const;
 
@@ -228,6 +246,14 @@ namespace value
 
         [[nodiscard]] std::vector<std::string> GetOutputVerifiers() const { return _outputVerifiers; }
 
+        [[nodiscard]] int64_t GetVerificationSamples() const { return _verificationSamples; }
+
+        [[nodiscard]] std::optional<std::pair<int64_t, int64_t>> GetStreaming() const { return _streaming; }
+
+        [[nodiscard]] bool IsAsyncEntry() const { return _asyncEntry; }
+
+        [[nodiscard]] const std::vector<DimensionConstraints>& GetArgumentConstraints() const { return _argumentConstraints; }
+
         [[nodiscard]] std::vector<std::string> GetArgumentsSymbol() const { return _argumentsSymbol; }
 
         [[nodiscard]] std::vector<std::string> GetArgumentsName() const { return _argumentsName; }
@@ -278,6 +304,10 @@ namespace value
         std::vector<std::string> _tags;
         std::string _baseName;
         std::vector<std::string> _outputVerifiers;
+        int64_t _verificationSamples = 0;
+        std::optional<std::pair<int64_t, int64_t>> _streaming;
+        bool _asyncEntry = false;
+        std::vector<DimensionConstraints> _argumentConstraints;
         std::vector<std::string> _argumentsSymbol;
         std::vector<std::string> _argumentsName;
         std::vector<std::string> _argumentsSize;
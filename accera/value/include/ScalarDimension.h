@@ -7,10 +7,22 @@
 
 #include "Scalar.h"
 
+#include <optional>
+
 namespace accera
 {
 namespace value
 {
+    /// <summary> Facts about the runtime value of a dimension, used to simplify the generated code </summary>
+    struct DimensionConstraints
+    {
+        std::optional<int64_t> min;
+        std::optional<int64_t> max;
+        std::optional<int64_t> multipleOf;
+
+        bool IsEmpty() const { return !min && !max && !multipleOf; }
+    };
+
     class ScalarDimension : public Scalar
     {
     public:
@@ -20,6 +32,14 @@ namespace value
         ~ScalarDimension();
 
         virtual void SetValue(Value value) final;
+
+        /// <summary> Sets the declared constraints on the runtime value of this dimension </summary>
+        void SetConstraints(const DimensionConstraints& constraints);
+
+        const DimensionConstraints& GetConstraints() const { return _constraints; }
+
+    private:
+        DimensionConstraints _constraints;
     };
 } // namespace value
 } // namespace accera
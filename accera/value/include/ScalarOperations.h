@@ -61,5 +61,11 @@ namespace value
 
     Scalar Select(Scalar cmp, Scalar a, Scalar b); // returns (cmp ? a : b)
     Scalar LogicalNot(Scalar v);
+
+    /// <summary> Atomic read-modify-write operators. `target` must be an element of an Array, and the previous value of the element is returned </summary>
+    Scalar AtomicAdd(Scalar target, Scalar value);
+    Scalar AtomicMax(Scalar target, Scalar value);
+    Scalar AtomicMin(Scalar target, Scalar value);
+    Scalar AtomicExchange(Scalar target, Scalar value);
 } // namespace value
 } // namespace accera
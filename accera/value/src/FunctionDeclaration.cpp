@@ -223,6 +223,42 @@ namespace value
         return *this;
     }
 
+    FunctionDeclaration& FunctionDeclaration::VerificationSamples(int64_t samples)
+    {
+        CheckNonEmpty();
+
+        _verificationSamples = samples;
+        return *this;
+    }
+
+    FunctionDeclaration& FunctionDeclaration::Streaming(int64_t dimArgIndex, int64_t tileSize)
+    {
+        CheckNonEmpty();
+
+        if (tileSize <= 0)
+        {
+            throw InputException(InputExceptionErrors::invalidArgument, "Streaming tile size must be positive");
+        }
+        _streaming = std::make_pair(dimArgIndex, tileSize);
+        return *this;
+    }
+
+    FunctionDeclaration& FunctionDeclaration::AsyncEntry(bool asyncEntry)
+    {
+        CheckNonEmpty();
+
+        _asyncEntry = asyncEntry;
+        return *this;
+    }
+
+    FunctionDeclaration& FunctionDeclaration::ArgumentConstraints(const std::vector<DimensionConstraints>& constraints)
+    {
+        CheckNonEmpty();
+
+        _argumentConstraints = constraints;
+        return *this;
+    }
+
     FunctionDeclaration& FunctionDeclaration::AddTag(const std::string& tag)
     {
         CheckNonEmpty();
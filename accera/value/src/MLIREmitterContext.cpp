@@ -996,7 +996,8 @@ static accera::ir::value::MemoryAllocType AllocateFlagToAllocateType(accera::val
     case accera::value::AllocateFlags::fromFlag: \
         return accera::ir::value::MemoryAllocType::toFlag
 
-    switch (flags)
+    // Huge page backing is orthogonal to where the allocation is placed
+    switch (flags & ~accera::value::AllocateFlags::HugePages)
     {
         MAP_FLAGS(None, Global);
         MAP_FLAGS(Global, Global);
@@ -1063,6 +1064,10 @@ Value MLIRContext::AllocateImpl(ValueType valueType, MemoryLayout layout, size_t
                                                           : llvm::None,
                                                       AllocateFlagToAllocateType(flags),
                                                       mlir::ValueRange{ sizes });
+    if ((flags & AllocateFlags::HugePages) == AllocateFlags::HugePages)
+    {
+        result.getDefiningOp()->setAttr(ir::HugePagesAttrName, b.getUnitAttr());
+    }
 
     EmittableInfo& emittableInfo = StoreLocalEmittable({ result.getAsOpaquePointer(), { valueType, 1 } });
     Emittable emittable{ &emittableInfo };
@@ -1102,6 +1107,10 @@ Value MLIRContext::GlobalAllocateImpl(GlobalAllocationScope allocScope, std::str
     auto dataAttribute = ConstantDataToDenseElementAttr(dataType, data);
 
     auto global = builder.create<ir::value::GlobalOp>(loc, memrefType, /*isConstant=*/true, adjustedName, dataAttribute);
+    if ((flags & AllocateFlags::HugePages) == AllocateFlags::HugePages)
+    {
+        global->setAttr(ir::HugePagesAttrName, builder.getUnitAttr());
+    }
 
     EmittableInfo& emittableInfo = StoreGlobalEmittable({ global, { valueElemType, 1 } });
     Emittable emittable(&emittableInfo);
@@ -1128,6 +1137,10 @@ Value MLIRContext::GlobalAllocateImpl(GlobalAllocationScope allocScope, std::str
     auto memrefType = MemoryLayoutToMemRefType(builder, layout, type);
 
     auto global = builder.create<ir::value::GlobalOp>(loc, memrefType, /*isConstant=*/false, adjustedName, mlir::Attribute{});
+    if ((flags & AllocateFlags::HugePages) == AllocateFlags::HugePages)
+    {
+        global->setAttr(ir::HugePagesAttrName, builder.getUnitAttr());
+    }
 
     EmittableInfo& emittableInfo = StoreGlobalEmittable({ global, { type, 1 } });
     Emittable emittable(&emittableInfo);
@@ -1260,6 +1273,41 @@ EmitterContext::DefinedFunction MLIRContext::CreateFunctionImpl(FunctionDeclarat
             auto usagesArrayAttr = b.getArrayAttr(usagesAttr);
             fnOp->setAttr(ir::UsagesAttrName, usagesArrayAttr);
 
+            // Set the declared argument constraints for range analysis, one dictionary per argument
+            if (const auto& argConstraints = decl.GetArgumentConstraints();
+                llvm::any_of(argConstraints, [](const DimensionConstraints& constraints) { return !constraints.IsEmpty(); }))
+            {
+                std::vector<mlir::Attribute> constraintsAttrs;
+                for (const auto& constraints : argConstraints)
+                {
+                    mlir::NamedAttrList entries;
+                    if (constraints.min)
+                    {
+                        entries.set("min", b.getI64IntegerAttr(*constraints.min));
+                    }
+                    if (constraints.max)
+                    {
+                        entries.set("max", b.getI64IntegerAttr(*constraints.max));
+                    }
+                    if (constraints.multipleOf)
+                    {
+                        entries.set("multiple_of", b.getI64IntegerAttr(*constraints.multipleOf));
+                    }
+                    constraintsAttrs.push_back(entries.getDictionary(b.getContext()));
+                }
+                fnOp->setAttr(ir::ArgConstraintsAttrName, b.getArrayAttr(constraintsAttrs));
+            }
+
+            // Set the streaming dimension argument and tile size for the streaming driver emitted by value-to-llvm
+            if (auto streaming = decl.GetStreaming())
+            {
+                fnOp->setAttr(ir::StreamingAttrName, b.getI64ArrayAttr({ streaming->first, streaming->second }));
+            }
+            if (decl.IsAsyncEntry())
+            {
+                fnOp->setAttr(ir::AsyncEntryAttrName, b.getUnitAttr());
+            }
+
             // For each input_output parameter, set its check function
             if (auto checkFunctions = decl.GetOutputVerifiers(); !checkFunctions.empty())
             {
@@ -1279,6 +1327,11 @@ EmitterContext::DefinedFunction MLIRContext::CreateFunctionImpl(FunctionDeclarat
                     }
                 }
                 fnOp->setAttr(ir::GetOutputVerifiersAttrName(), b.getArrayAttr(checkFunctionAttrs));
+
+                if (auto samples = decl.GetVerificationSamples(); samples > 0)
+                {
+                    fnOp->setAttr(ir::GetVerificationSamplesAttrName(), b.getI64IntegerAttr(samples));
+                }
             }
             if (auto argumentsSymbol = decl.GetArgumentsSymbol(); !argumentsSymbol.empty())
             {
@@ -1,5 +1,7 @@
 #include "ScalarDimension.h"
 
+#include <utilities/include/Exception.h>
+
 namespace accera
 {
 namespace value
@@ -24,6 +26,26 @@ namespace value
         Scalar::SetValue(value);
     }
 
+    void ScalarDimension::SetConstraints(const DimensionConstraints& constraints)
+    {
+        using namespace utilities;
+
+        if (constraints.min && *constraints.min < 0)
+        {
+            throw InputException(InputExceptionErrors::invalidArgument, "Dimension min must be non-negative");
+        }
+        if (constraints.min && constraints.max && *constraints.min > *constraints.max)
+        {
+            throw InputException(InputExceptionErrors::invalidArgument, "Dimension min must not exceed max");
+        }
+        if (constraints.multipleOf && *constraints.multipleOf <= 0)
+        {
+            throw InputException(InputExceptionErrors::invalidArgument, "Dimension multiple_of must be positive");
+        }
+
+        _constraints = constraints;
+    }
+
     ScalarDimension::~ScalarDimension() = default;
 
 } // namespace value
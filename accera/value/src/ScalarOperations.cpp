@@ -48,6 +48,26 @@ namespace value
             Scalar value;
         };
 
+        Scalar AtomicRMW(ir::value::AtomicRMWKind kind, Scalar target, Scalar value)
+        {
+            auto& builder = GetMLIRContext().GetOpBuilder();
+            auto loc = builder.getUnknownLoc();
+
+            // Elements of an Array are single-element views into its memory, which are updated in place
+            auto memref = Unwrap(target);
+            auto memrefType = memref.getType().dyn_cast<mlir::MemRefType>();
+            if (!memrefType)
+            {
+                throw InputException(InputExceptionErrors::invalidArgument, "The target of an atomic operation must be an element of an Array.");
+            }
+
+            value = Cast(value, target.GetType());
+            mlir::Value zero = builder.create<mlir::arith::ConstantIndexOp>(loc, 0);
+            std::vector<mlir::Value> indices(memrefType.getRank(), zero);
+            auto op = builder.create<ir::value::AtomicRMWOp>(loc, kind, UnwrapScalar(value), memref, indices);
+            return Wrap(op.getResult());
+        }
+
     } // namespace
 
     Scalar Bitcast(Scalar value, ValueType type)
@@ -322,5 +342,25 @@ namespace value
         return r;
     }
 
+    Scalar AtomicAdd(Scalar target, Scalar value)
+    {
+        return AtomicRMW(ir::value::AtomicRMWKind::ADD, target, value);
+    }
+
+    Scalar AtomicMax(Scalar target, Scalar value)
+    {
+        return AtomicRMW(ir::value::AtomicRMWKind::MAX, target, value);
+    }
+
+    Scalar AtomicMin(Scalar target, Scalar value)
+    {
+        return AtomicRMW(ir::value::AtomicRMWKind::MIN, target, value);
+    }
+
+    Scalar AtomicExchange(Scalar target, Scalar value)
+    {
+        return AtomicRMW(ir::value::AtomicRMWKind::XCHG, target, value);
+    }
+
 } // namespace value
 } // namespace accera